@@ -78,6 +78,37 @@ http://www.sofaconventions.org
 #include "../src/SOFAUnits.h"
 #include "../src/SOFAVersion.h"
 #include "../src/SOFAHelper.h"
+#include "../src/SOFAUtils.h"
+#include "../src/SOFAWriter.h"
+#include "../src/SOFAMeasurementOrder.h"
+#include "../src/SOFAQuantization.h"
+#include "../src/SOFACollection.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAImpulseResponses.h"
+#include "../src/SOFAMinimumPhase.h"
+#include "../src/SOFATruncation.h"
+#include "../src/SOFAResampler.h"
+#include "../src/SOFAConvolver.h"
+#include "../src/SOFATransferFunctions.h"
+#include "../src/SOFAOrientationIndex.h"
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFASphericalHarmonics.h"
+#include "../src/SOFASphericalHarmonicsHRTF.h"
+#include "../src/SOFAAmbisonicsDecoder.h"
+#include "../src/SOFAMicrophoneArrayEncoder.h"
+#include "../src/SOFARoomAcoustics.h"
+#include "../src/SOFAHeadphoneEqualization.h"
+#include "../src/SOFADelayEstimation.h"
+#include "../src/SOFAFractionalDelay.h"
+#include "../src/SOFABinauralRenderer.h"
+#include "../src/SOFAWaveFile.h"
+#include "../src/SOFAVirtualLoudspeakers.h"
+#include "../src/SOFACrosstalkCancellation.h"
+#include "../src/SOFASpectralDistance.h"
+#include "../src/SOFAMorphing.h"
+#include "../src/SOFAMeasurementWriter.h"
+#include "../src/SOFASweepDeconvolution.h"
 
 //==============================================================================
 /// private files
@@ -0,0 +1,292 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAAmbisonicsDecoder.cpp
+ *   @brief      Binaural decoding filters for Ambisonics, computed from HRTF sets
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAAmbisonicsDecoder.h"
+#include "../src/SOFATransferFunctions.h"
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAMeasurementOrder.h"
+#include "../src/SOFASphericalHarmonicsHRTF.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : an empty decoder
+ *
+ */
+/************************************************************************************/
+AmbisonicsDecoder::AmbisonicsDecoder()
+: order( 0 )
+, normalization( sofa::SphericalHarmonics::kSN3D )
+, numReceivers( 0 )
+, filterLength( 0 )
+, samplingRate( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the decoder from a FIR file (e.g. SimpleFreeFieldHRIR)
+ *  @param[in]      order : Ambisonic order
+ *  @param[in]      normalization : normalization of the Ambisonic signals
+ *  @param[in]      magLSCutoff : frequency (in hertz) above which MagLS is used (0 for LS only)
+ *  @param[in]      regularization : Tikhonov parameter, relative to the energy of the harmonics
+ *  @param[in]      fftSize : power of 2, not smaller than N plus the largest Data.Delay
+ *                  (0 for the default size) : this is the length of the filters
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ */
+/************************************************************************************/
+void AmbisonicsDecoder::Compute(const sofa::File &file,
+                                const unsigned int order_,
+                                const sofa::SphericalHarmonics::Normalization &normalization_,
+                                const double magLSCutoff,
+                                const double regularization,
+                                const std::size_t fftSize,
+                                const unsigned int numThreads)
+{
+    sofa::ImpulseResponses responses;
+    responses.Load( file );
+    
+    std::vector< double > directions;
+    sofa::MeasurementOrder::GetMeasurementDirections( file, directions );
+    
+    Compute( responses, directions, order_, normalization_, magLSCutoff, regularization, fftSize, numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the decoder from a set of responses
+ *  @param[in]      responses : [M R N] responses (one emitter), with their delays
+ *  @param[in]      directions : [M 3] cartesian direction of each measurement
+ *
+ */
+/************************************************************************************/
+void AmbisonicsDecoder::Compute(const sofa::ImpulseResponses &responses,
+                                const std::vector< double > &directions,
+                                const unsigned int order_,
+                                const sofa::SphericalHarmonics::Normalization &normalization_,
+                                const double magLSCutoff,
+                                const double regularization,
+                                const std::size_t fftSize,
+                                const unsigned int numThreads)
+{
+    const std::size_t M = responses.GetNumMeasurements();
+    const std::size_t R = responses.GetNumReceivers();
+    
+    if( responses.GetNumEmitters() != 1 )
+    {
+        SOFA_THROW( "the responses must have one emitter" );
+    }
+    
+    if( directions.size() != 3 * M )
+    {
+        SOFA_THROW( "one direction per measurement is required" );
+    }
+    
+    /// HRTFs, including Data.Delay
+    sofa::TransferFunctions spectra;
+    spectra.Compute( responses, fftSize, numThreads );
+    
+    const std::size_t K = spectra.GetFFTSize();
+    const std::size_t B = spectra.GetNumBins();
+    
+    order           = order_;
+    normalization   = normalization_;
+    numReceivers    = R;
+    filterLength    = K;
+    samplingRate    = responses.GetSamplingRate();
+    
+    const std::size_t Q = GetNumChannels();
+    
+    std::vector< double > harmonics;
+    sofa::SphericalHarmonics::GetMatrix( harmonics, directions, order, normalization );
+    
+    std::vector< double > pseudoInverse;
+    sofa::LinearAlgebra::GetRegularizedPseudoInverse( pseudoInverse, harmonics, M, Q, regularization );
+    
+    /// first bin of the MagLS range
+    std::size_t magLSBin = B;
+    if( magLSCutoff > 0.0 )
+    {
+        magLSBin = sofa::smax( (std::size_t) 1, static_cast< std::size_t >( std::ceil( magLSCutoff * K / samplingRate ) ) );
+        magLSBin = sofa::smin( magLSBin, B );
+    }
+    
+    std::vector< std::complex< double > > decoder( R * Q * B, std::complex< double >( 0.0, 0.0 ) );   ///< [R Q B]
+    
+    /// least squares below the MagLS range
+    sofa::SphericalHarmonicsHRTF::FitSpectra( &decoder[0], spectra.GetSpectrum( 0 ), pseudoInverse, M, R, B, magLSBin, numThreads );
+    
+    //==============================================================================
+    /// MagLS : bin after bin, the phases come from the decoder at the previous bin
+    if( magLSBin < B )
+    {
+        sofa::Threads::ParallelFor( R,
+                                    [&]( const std::size_t r, const unsigned int )
+                                    {
+                                        std::vector< std::complex< double > > target( M );
+                                        
+                                        for( std::size_t k = magLSBin; k < B; k++ )
+                                        {
+                                            for( std::size_t m = 0; m < M; m++ )
+                                            {
+                                                const double *y = &harmonics[ m * Q ];
+                                                
+                                                double re = 0.0;
+                                                double im = 0.0;
+                                                for( std::size_t q = 0; q < Q; q++ )
+                                                {
+                                                    const std::complex< double > d = decoder[ ( r * Q + q ) * B + k - 1 ];
+                                                    re += y[q] * d.real();
+                                                    im += y[q] * d.imag();
+                                                }
+                                                
+                                                const double magnitude  = std::abs( spectra.GetSpectrum( m * R + r )[k] );
+                                                const double phase      = std::atan2( im, re );
+                                                
+                                                target[m] = std::polar( magnitude, phase );
+                                            }
+                                            
+                                            for( std::size_t q = 0; q < Q; q++ )
+                                            {
+                                                const double *p = &pseudoInverse[ q * M ];
+                                                
+                                                double re = 0.0;
+                                                double im = 0.0;
+                                                for( std::size_t m = 0; m < M; m++ )
+                                                {
+                                                    re += p[m] * target[m].real();
+                                                    im += p[m] * target[m].imag();
+                                                }
+                                                
+                                                decoder[ ( r * Q + q ) * B + k ] = std::complex< double >( re, im );
+                                            }
+                                        }
+                                    },
+                                    numThreads );
+    }
+    
+    //==============================================================================
+    /// back to the time domain
+    const sofa::FFT fft( K );
+    
+    filters.resize( R * Q * K );
+    
+    sofa::Threads::ParallelFor( R * Q,
+                                [&]( const std::size_t i, const unsigned int )
+                                {
+                                    std::complex< double > *spectrum = &decoder[ i * B ];
+                                    
+                                    /// the spectrum of a real filter is real at DC and Nyquist
+                                    spectrum[0]     = std::complex< double >( spectrum[0].real(), 0.0 );
+                                    spectrum[B - 1] = std::complex< double >( spectrum[B - 1].real(), 0.0 );
+                                    
+                                    fft.InverseReal( &filters[ i * K ], spectrum );
+                                },
+                                numThreads );
+}
+
+unsigned int AmbisonicsDecoder::GetOrder() const
+{
+    return order;
+}
+
+sofa::SphericalHarmonics::Normalization AmbisonicsDecoder::GetNormalization() const
+{
+    return normalization;
+}
+
+std::size_t AmbisonicsDecoder::GetNumChannels() const
+{
+    return sofa::SphericalHarmonics::GetNumCoefficients( order );
+}
+
+std::size_t AmbisonicsDecoder::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t AmbisonicsDecoder::GetFilterLength() const
+{
+    return filterLength;
+}
+
+double AmbisonicsDecoder::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the filter from an Ambisonic channel (ACN) to a receiver,
+ *                  GetFilterLength() samples
+ *
+ */
+/************************************************************************************/
+const double * AmbisonicsDecoder::GetFilter(const std::size_t receiver,
+                                            const std::size_t channel) const
+{
+    return &filters[ ( receiver * GetNumChannels() + channel ) * filterLength ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns all the filters, [R (order+1)^2 filterLength]
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & AmbisonicsDecoder::GetFilters() const
+{
+    return filters;
+}
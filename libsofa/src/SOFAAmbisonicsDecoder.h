@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAAmbisonicsDecoder.h
+ *   @brief      Binaural decoding filters for Ambisonics, computed from HRTF sets
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_AMBISONICS_DECODER_H__
+#define _SOFA_AMBISONICS_DECODER_H__
+
+#include "../src/SOFAImpulseResponses.h"
+#include "../src/SOFASphericalHarmonics.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          AmbisonicsDecoder
+     *  @brief          Computes the R x (order+1)^2 FIR filters that decode an Ambisonic
+     *                  signal (ACN, N3D or SN3D) to the receivers (ears) of an HRTF set
+     *
+     *  @details        For each frequency bin, the decoding filters are the regularized
+     *                  least-squares fit of the HRTFs on the harmonics of the measured
+     *                  directions. Above an optional cutoff frequency, the magnitude
+     *                  least-squares (MagLS) method is used instead : only the magnitudes
+     *                  of the HRTFs are fitted, the phases being taken from the decoder
+     *                  at the previous bin, which avoids the high-frequency loss of
+     *                  low-order decoders.
+     *                  The least-squares bins are computed in parallel; the MagLS
+     *                  iterations are parallel over the receivers.
+     */
+    /************************************************************************************/
+    class SOFA_API AmbisonicsDecoder
+    {
+    public:
+        AmbisonicsDecoder();
+        ~AmbisonicsDecoder() {};
+        
+        //==============================================================================
+        void Compute(const sofa::File &file,
+                     const unsigned int order,
+                     const sofa::SphericalHarmonics::Normalization &normalization = sofa::SphericalHarmonics::kSN3D,
+                     const double magLSCutoff = 0.0,
+                     const double regularization = 1e-3,
+                     const std::size_t fftSize = 0,
+                     const unsigned int numThreads = 0);
+        
+        void Compute(const sofa::ImpulseResponses &responses,
+                     const std::vector< double > &directions,
+                     const unsigned int order,
+                     const sofa::SphericalHarmonics::Normalization &normalization = sofa::SphericalHarmonics::kSN3D,
+                     const double magLSCutoff = 0.0,
+                     const double regularization = 1e-3,
+                     const std::size_t fftSize = 0,
+                     const unsigned int numThreads = 0);
+        
+        //==============================================================================
+        unsigned int GetOrder() const;
+        sofa::SphericalHarmonics::Normalization GetNormalization() const;
+        std::size_t GetNumChannels() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetFilterLength() const;
+        double GetSamplingRate() const;
+        
+        const double * GetFilter(const std::size_t receiver,
+                                 const std::size_t channel) const;
+        
+        const std::vector< double > & GetFilters() const;
+        
+    protected:
+        unsigned int order;
+        sofa::SphericalHarmonics::Normalization normalization;
+        std::size_t numReceivers;
+        std::size_t filterLength;
+        double samplingRate;
+        
+        std::vector< double > filters;      ///< [R (order+1)^2 filterLength]
+    };
+    
+}
+
+#endif /* _SOFA_AMBISONICS_DECODER_H__ */
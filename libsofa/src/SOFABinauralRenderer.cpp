@@ -0,0 +1,714 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+/************************************************************************************/
+/*!
+ *   @file       SOFABinauralRenderer.cpp
+ *   @brief      Real-time binaural rendering of several sources
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFABinauralRenderer.h"
+#include "../src/SOFAImpulseResponses.h"
+#include "../src/SOFAMinimumPhase.h"
+#include "../src/SOFAMeasurementOrder.h"
+#include "../src/SOFAConvolver.h"
+#include "../src/SOFAFractionalDelay.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// number of samples of the output blocks mixed by one task
+    static const std::size_t kMixChunkSize = 64;
+    
+    /// number of measurements interpolated by kInverseDistance
+    static const std::size_t kMaxNeighbours = 3;
+    
+    /// number of taps of the windowed-sinc fractional delays
+    static const std::size_t kNumDelayTaps = 32;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          The state of one source
+ *
+ */
+/************************************************************************************/
+struct BinauralRenderer::Source
+{
+    Source(const std::size_t numReceivers,
+           const std::size_t blockSize,
+           const std::size_t maxFilterLength,
+           const std::size_t maxDelay)
+    : delay( numReceivers, blockSize, maxDelay, sofa::FractionalDelay::kWindowedSinc, sofaLocal::kNumDelayTaps )
+    , output( numReceivers * blockSize, 0.0 )
+    , inputs( numReceivers, nullptr )
+    , outputs( numReceivers, nullptr )
+    , moved( true )
+    , started( false )
+    , numNeighbours( 0 )
+    {
+        for( std::size_t r = 0; r < numReceivers; r++ )
+        {
+            convolvers.push_back( std::make_shared< sofa::Convolver >( blockSize, maxFilterLength ) );
+            outputs[r] = &output[ r * blockSize ];
+        }
+        
+        filter.resize( convolvers[0]->GetNumPartitions() * convolvers[0]->GetNumBins() );
+        
+        direction[0] = 1.0;
+        direction[1] = 0.0;
+        direction[2] = 0.0;
+    }
+    
+    sofa::FractionalDelay delay;
+    std::vector< std::shared_ptr< sofa::Convolver > > convolvers;   ///< one per receiver
+    std::vector< std::complex< double > > filter;                   ///< workspace for the interpolated spectra
+    std::vector< double > output;                                   ///< [R blockSize]
+    std::vector< const double * > inputs;
+    std::vector< double * > outputs;
+    
+    double direction[3];
+    bool moved;                                                     ///< the filters must be updated
+    bool started;                                                   ///< the first block is not ramped
+    
+    std::size_t measurements[ sofaLocal::kMaxNeighbours ];
+    double weights[ sofaLocal::kMaxNeighbours ];
+    std::size_t numNeighbours;
+};
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of an interpolation method
+ *
+ */
+/************************************************************************************/
+std::string BinauralRenderer::GetName(const sofa::BinauralRenderer::Interpolation &interpolation)
+{
+    switch( interpolation )
+    {
+        case sofa::BinauralRenderer::kNearestNeighbour  : return "nearest neighbour";
+        case sofa::BinauralRenderer::kInverseDistance   : return "inverse distance";
+            
+        default                                         : SOFA_ASSERT( false ); return "";
+        case sofa::BinauralRenderer::kNumInterpolations : SOFA_ASSERT( false ); return "";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+BinauralFilters::BinauralFilters()
+: numReceivers( 0 )
+, numMeasurements( 0 )
+, blockSize( 0 )
+, numPartitions( 0 )
+, numBins( 0 )
+, filterLength( 0 )
+, latency( 0 )
+, maxDelay( 0.0 )
+, samplingRate( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Prepares the filters of a FIR file
+ *  @param[in]      file : a FIR file with one emitter (e.g. SimpleFreeFieldHRIR)
+ *  @param[in]      blockSize : block size of the renderers (power of 2)
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ */
+/************************************************************************************/
+void BinauralFilters::Compute(const sofa::File &file,
+                              const std::size_t blockSize_,
+                              const unsigned int numThreads)
+{
+    if( sofa::FFT::IsPowerOfTwo( blockSize_ ) == false )
+    {
+        SOFA_THROW( "the block size must be a power of two" );
+    }
+    
+    sofa::ImpulseResponses responses;
+    responses.Load( file );
+    
+    if( responses.GetNumEmitters() != 1 || responses.GetNumMeasurements() == 0 )
+    {
+        SOFA_THROW( "the responses must have one emitter, and at least one measurement" );
+    }
+    
+    /// minimum-phase filters interpolate without comb filtering; the delays are applied apart
+    sofa::MinimumPhase::Process( responses, sofa::MinimumPhase::kEstimateOnset, -20.0, numThreads );
+    
+    numReceivers    = responses.GetNumReceivers();
+    numMeasurements = responses.GetNumMeasurements();
+    blockSize       = blockSize_;
+    filterLength    = responses.GetNumDataSamples();
+    samplingRate    = responses.GetSamplingRate();
+    
+    //==============================================================================
+    sofa::MeasurementOrder::GetUnitMeasurementDirections( file, directions );
+    
+    delays = responses.GetDelays();
+    
+    double minDelay = delays[0];
+    maxDelay        = delays[0];
+    for( std::size_t i = 0; i < delays.size(); i++ )
+    {
+        minDelay = sofa::smin( minDelay, delays[i] );
+        maxDelay = sofa::smax( maxDelay, delays[i] );
+    }
+    
+    /// the windowed sinc cannot apply delays shorter than half its length :
+    /// if needed, all the delays are increased by the same latency
+    const double minimumSincDelay = 0.5 * static_cast< double >( sofaLocal::kNumDelayTaps ) - 1.0;
+    
+    latency = static_cast< std::size_t >( std::ceil( sofa::smax( 0.0, minimumSincDelay - minDelay ) ) );
+    
+    for( std::size_t i = 0; i < delays.size(); i++ )
+    {
+        delays[i] += static_cast< double >( latency );
+    }
+    maxDelay += static_cast< double >( latency );
+    
+    //==============================================================================
+    /// the partition spectra of all the filters, computed once
+    const sofa::FFT fft( 2 * blockSize );
+    
+    numBins         = fft.GetNumBins();
+    numPartitions   = ( filterLength + blockSize - 1 ) / blockSize;
+    
+    const std::size_t spectrumSize = numPartitions * numBins;
+    
+    spectra.resize( numMeasurements * numReceivers * spectrumSize );
+    
+    sofa::Threads::ParallelFor( numMeasurements * numReceivers,
+                                [&]( const std::size_t i, const unsigned int )
+                                {
+                                    std::vector< std::complex< double > > spectrum;
+                                    sofa::Convolver::ComputeFilterSpectrum( spectrum, fft, responses.GetResponse( i ), filterLength );
+                                    
+                                    std::copy( spectrum.begin(), spectrum.end(), spectra.begin() + i * spectrumSize );
+                                },
+                                numThreads );
+}
+
+std::size_t BinauralFilters::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t BinauralFilters::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+std::size_t BinauralFilters::GetBlockSize() const
+{
+    return blockSize;
+}
+
+std::size_t BinauralFilters::GetNumPartitions() const
+{
+    return numPartitions;
+}
+
+std::size_t BinauralFilters::GetNumBins() const
+{
+    return numBins;
+}
+
+std::size_t BinauralFilters::GetFilterLength() const
+{
+    return filterLength;
+}
+
+double BinauralFilters::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the delay added to all the responses, in samples
+ *                  (non-zero only for responses with very short delays)
+ *
+ */
+/************************************************************************************/
+std::size_t BinauralFilters::GetLatency() const
+{
+    return latency;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the largest delay, in samples (latency included)
+ *
+ */
+/************************************************************************************/
+double BinauralFilters::GetMaximumDelay() const
+{
+    return maxDelay;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the direction of a measurement, as a unit vector
+ *
+ */
+/************************************************************************************/
+const double * BinauralFilters::GetDirection(const std::size_t measurement) const
+{
+    SOFA_ASSERT( measurement < numMeasurements );
+    
+    return &directions[ 3 * measurement ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the directions of all the measurements, [M 3] unit vectors
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & BinauralFilters::GetDirections() const
+{
+    return directions;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the delay of a filter, in samples (latency included)
+ *
+ */
+/************************************************************************************/
+double BinauralFilters::GetDelay(const std::size_t measurement,
+                                 const std::size_t receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+    
+    return delays[ measurement * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the partition spectra of a filter ([GetNumPartitions() GetNumBins()])
+ *
+ */
+/************************************************************************************/
+const std::complex< double > * BinauralFilters::GetSpectrum(const std::size_t measurement,
+                                                            const std::size_t receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+    
+    return &spectra[ ( measurement * numReceivers + receiver ) * numPartitions * numBins ];
+}
+
+//==============================================================================
+// BinauralRenderer
+//==============================================================================
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+BinauralRenderer::BinauralRenderer()
+: interpolation( kInverseDistance )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor
+ *
+ *  @details        Defined here, where Source is a complete type
+ */
+/************************************************************************************/
+BinauralRenderer::~BinauralRenderer()
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Prepares the filters, the sources and the threads
+ *  @param[in]      file : a FIR file with one emitter (e.g. SimpleFreeFieldHRIR)
+ *  @param[in]      numSources : number of source signals
+ *  @param[in]      blockSize : number of samples of each call to Process() (power of 2)
+ *  @param[in]      interpolation : how the filters are selected
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ *  @details        All the sources are initially in front (azimuth 0, elevation 0)
+ */
+/************************************************************************************/
+void BinauralRenderer::Setup(const sofa::File &file,
+                             const std::size_t numSources,
+                             const std::size_t blockSize,
+                             const sofa::BinauralRenderer::Interpolation &interpolation_,
+                             const unsigned int numThreads)
+{
+    std::shared_ptr< sofa::BinauralFilters > filters_ = std::make_shared< sofa::BinauralFilters >();
+    filters_->Compute( file, blockSize, numThreads );
+    
+    Setup( filters_, numSources, interpolation_, numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Prepares the sources and the threads, with filters already computed
+ *                  (and possibly shared with other renderers)
+ *
+ */
+/************************************************************************************/
+void BinauralRenderer::Setup(const std::shared_ptr< const sofa::BinauralFilters > &filters_,
+                             const std::size_t numSources,
+                             const sofa::BinauralRenderer::Interpolation &interpolation_,
+                             const unsigned int numThreads)
+{
+    if( filters_ == nullptr || filters_->GetNumMeasurements() == 0 || numSources == 0 )
+    {
+        SOFA_THROW( "invalid filters or number of sources" );
+    }
+    
+    if( interpolation_ != kNearestNeighbour && interpolation_ != kInverseDistance )
+    {
+        SOFA_THROW( "invalid interpolation" );
+    }
+    
+    filters         = filters_;
+    interpolation   = interpolation_;
+    
+    sources.clear();
+    for( std::size_t s = 0; s < numSources; s++ )
+    {
+        sources.push_back( std::make_shared< Source >( filters->GetNumReceivers(),
+                                                       filters->GetBlockSize(),
+                                                       filters->GetFilterLength(),
+                                                       static_cast< std::size_t >( std::ceil( filters->GetMaximumDelay() ) ) + 1 ) );
+    }
+    
+    pool.reset( new sofa::ThreadPool( numThreads ) );
+}
+
+std::size_t BinauralRenderer::GetNumSources() const
+{
+    return sources.size();
+}
+
+std::size_t BinauralRenderer::GetNumReceivers() const
+{
+    return ( filters != nullptr ) ? filters->GetNumReceivers() : 0;
+}
+
+std::size_t BinauralRenderer::GetBlockSize() const
+{
+    return ( filters != nullptr ) ? filters->GetBlockSize() : 0;
+}
+
+double BinauralRenderer::GetSamplingRate() const
+{
+    return ( filters != nullptr ) ? filters->GetSamplingRate() : 0.0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the delay added to all the responses, in samples
+ *
+ */
+/************************************************************************************/
+std::size_t BinauralRenderer::GetLatency() const
+{
+    return ( filters != nullptr ) ? filters->GetLatency() : 0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of samples to render after the end of the
+ *                  input signals, so that the outputs decay completely
+ *
+ */
+/************************************************************************************/
+std::size_t BinauralRenderer::GetTailLength() const
+{
+    if( filters == nullptr )
+    {
+        return 0;
+    }
+    
+    return static_cast< std::size_t >( std::ceil( filters->GetMaximumDelay() ) ) + filters->GetFilterLength() + sofaLocal::kNumDelayTaps / 2;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the direction of a source, relative to the listener
+ *  @param[in]      azimuth : in degrees, counterclockwise from the front
+ *  @param[in]      elevation : in degrees, positive upwards
+ *
+ *  @details        The filters are updated by the next call to Process()
+ */
+/************************************************************************************/
+void BinauralRenderer::SetSourcePosition(const std::size_t source,
+                                         const double azimuth,
+                                         const double elevation)
+{
+    const double aed[3] = { azimuth, elevation, 1.0 };
+    double xyz[3];
+    sofa::SphericalToCartesian( xyz, aed );
+    
+    SetSourceDirection( source, xyz[0], xyz[1], xyz[2] );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the direction of a source, relative to the listener, as cartesian
+ *                  coordinates (the distance is ignored)
+ *
+ */
+/************************************************************************************/
+void BinauralRenderer::SetSourceDirection(const std::size_t source,
+                                          const double x,
+                                          const double y,
+                                          const double z)
+{
+    SOFA_ASSERT( source < sources.size() );
+    
+    const double norm = std::sqrt( x * x + y * y + z * z );
+    
+    if( norm <= 0.0 )
+    {
+        return;
+    }
+    
+    Source &current = *sources[ source ];
+    
+    current.direction[0]    = x / norm;
+    current.direction[1]    = y / norm;
+    current.direction[2]    = z / norm;
+    current.moved           = true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Renders one block
+ *  @param[out]     outputs : GetNumReceivers() buffers of GetBlockSize() samples
+ *  @param[in]      inputs : GetNumSources() buffers of GetBlockSize() samples
+ *
+ */
+/************************************************************************************/
+void BinauralRenderer::Process(double * const *outputs,
+                               const double * const *inputs)
+{
+    if( pool == nullptr )
+    {
+        SOFA_THROW( "the renderer is not set up" );
+    }
+    
+    pool->Run( sources.size(),
+               [&]( const std::size_t s, const unsigned int )
+               {
+                   renderSource( *sources[s], inputs[s] );
+               } );
+    
+    const std::size_t blockSize     = filters->GetBlockSize();
+    const std::size_t numReceivers  = filters->GetNumReceivers();
+    
+    /// each task sums all the sources for one chunk of one receiver, always in the same order
+    const std::size_t numChunks = ( blockSize + sofaLocal::kMixChunkSize - 1 ) / sofaLocal::kMixChunkSize;
+    
+    pool->Run( numReceivers * numChunks,
+               [&]( const std::size_t i, const unsigned int )
+               {
+                   const std::size_t r      = i / numChunks;
+                   const std::size_t first  = ( i % numChunks ) * sofaLocal::kMixChunkSize;
+                   const std::size_t count  = sofa::smin( sofaLocal::kMixChunkSize, blockSize - first );
+                   
+                   double *output = outputs[r] + first;
+                   std::fill( output, output + count, 0.0 );
+                   
+                   for( std::size_t s = 0; s < sources.size(); s++ )
+                   {
+                       const double *rendered = &sources[s]->output[ r * blockSize + first ];
+                       
+                       for( std::size_t n = 0; n < count; n++ )
+                       {
+                           output[n] += rendered[n];
+                       }
+                   }
+               } );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the past input of all the sources
+ *
+ */
+/************************************************************************************/
+void BinauralRenderer::Reset()
+{
+    const std::size_t numReceivers = GetNumReceivers();
+    
+    for( std::size_t s = 0; s < sources.size(); s++ )
+    {
+        Source &source = *sources[s];
+        
+        source.delay.Reset();
+        
+        for( std::size_t r = 0; r < numReceivers; r++ )
+        {
+            source.convolvers[r]->Reset();
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Selects the measurements around the direction of a source, and sets
+ *                  its filters and delays
+ *
+ */
+/************************************************************************************/
+void BinauralRenderer::updateFilter(sofa::BinauralRenderer::Source &source)
+{
+    const std::size_t numReceivers = filters->GetNumReceivers();
+    
+    /// the nearest measurements, with their dot products in decreasing order
+    double dots[ sofaLocal::kMaxNeighbours ];
+    
+    const std::size_t numNeighbours = sofa::MeasurementOrder::FindNearestDirections( source.measurements,
+                                                                                     dots,
+                                                                                     ( interpolation == kNearestNeighbour ) ? 1 : sofaLocal::kMaxNeighbours,
+                                                                                     source.direction,
+                                                                                     filters->GetDirections() );
+    
+    /// weights 1 / angle^2; a measurement in the direction of the source is used alone
+    source.numNeighbours = numNeighbours;
+    
+    for( std::size_t i = 0; i < numNeighbours; i++ )
+    {
+        const double angle = std::acos( sofa::smax( -1.0, sofa::smin( 1.0, dots[i] ) ) );
+        
+        if( angle < 1e-6 )
+        {
+            source.numNeighbours    = 1;
+            source.measurements[0]  = source.measurements[i];
+            source.weights[0]       = 1.0;
+            break;
+        }
+        
+        source.weights[i] = 1.0 / ( angle * angle );
+    }
+    
+    double sum = 0.0;
+    for( std::size_t i = 0; i < source.numNeighbours; i++ )
+    {
+        sum += source.weights[i];
+    }
+    for( std::size_t i = 0; i < source.numNeighbours; i++ )
+    {
+        source.weights[i] /= sum;
+    }
+    
+    //==============================================================================
+    const std::size_t spectrumSize = filters->GetNumPartitions() * filters->GetNumBins();
+    
+    for( std::size_t r = 0; r < numReceivers; r++ )
+    {
+        double neighbourDelays[ sofaLocal::kMaxNeighbours ];
+        
+        std::fill( source.filter.begin(), source.filter.end(), std::complex< double >( 0.0, 0.0 ) );
+        
+        for( std::size_t i = 0; i < source.numNeighbours; i++ )
+        {
+            const std::complex< double > *spectrum = filters->GetSpectrum( source.measurements[i], r );
+            const double weight = source.weights[i];
+            
+            for( std::size_t k = 0; k < spectrumSize; k++ )
+            {
+                source.filter[k] += weight * spectrum[k];
+            }
+            
+            neighbourDelays[i] = filters->GetDelay( source.measurements[i], r );
+        }
+        
+        source.convolvers[r]->SetFilterSpectrum( &source.filter[0], filters->GetNumPartitions(), source.started );
+        source.delay.SetDelay( r, neighbourDelays, source.weights, source.numNeighbours, source.started );
+    }
+    
+    source.moved    = false;
+    source.started  = true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delays and filters the signal of a source, for each receiver
+ *
+ */
+/************************************************************************************/
+void BinauralRenderer::renderSource(sofa::BinauralRenderer::Source &source,
+                                    const double *input)
+{
+    if( source.moved == true )
+    {
+        updateFilter( source );
+    }
+    
+    const std::size_t numReceivers = filters->GetNumReceivers();
+    
+    for( std::size_t r = 0; r < numReceivers; r++ )
+    {
+        source.inputs[r] = input;
+    }
+    
+    source.delay.Process( &source.outputs[0], &source.inputs[0] );
+    
+    for( std::size_t r = 0; r < numReceivers; r++ )
+    {
+        source.convolvers[r]->Process( source.outputs[r], source.outputs[r] );
+    }
+}
+
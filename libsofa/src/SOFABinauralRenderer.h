@@ -0,0 +1,218 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+/************************************************************************************/
+/*!
+ *   @file       SOFABinauralRenderer.h
+ *   @brief      Real-time binaural rendering of several sources
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_BINAURAL_RENDERER_H__
+#define _SOFA_BINAURAL_RENDERER_H__
+
+#include "../src/SOFAFile.h"
+#include "../src/SOFAThreads.h"
+#include <complex>
+#include <memory>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          BinauralFilters
+     *  @brief          The filters of a FIR file (e.g. SimpleFreeFieldHRIR), prepared for
+     *                  block rendering
+     *
+     *  @details        The responses are decomposed into minimum-phase filters and delays
+     *                  (sofa::MinimumPhase), and the filters are transformed once into
+     *                  the partition spectra used by sofa::Convolver.
+     *                  The object is read-only once computed : it can be shared by several
+     *                  renderers (e.g. one per thread in a batch process).
+     */
+    /************************************************************************************/
+    class SOFA_API BinauralFilters
+    {
+    public:
+        BinauralFilters();
+        ~BinauralFilters() {};
+        
+        void Compute(const sofa::File &file,
+                     const std::size_t blockSize = 256,
+                     const unsigned int numThreads = 0);
+        
+        //==============================================================================
+        std::size_t GetNumReceivers() const;
+        std::size_t GetNumMeasurements() const;
+        std::size_t GetBlockSize() const;
+        std::size_t GetNumPartitions() const;
+        std::size_t GetNumBins() const;
+        std::size_t GetFilterLength() const;
+        double GetSamplingRate() const;
+        
+        std::size_t GetLatency() const;
+        double GetMaximumDelay() const;
+        
+        const double * GetDirection(const std::size_t measurement) const;
+        const std::vector< double > & GetDirections() const;
+        
+        double GetDelay(const std::size_t measurement,
+                        const std::size_t receiver) const;
+        
+        const std::complex< double > * GetSpectrum(const std::size_t measurement,
+                                                   const std::size_t receiver) const;
+        
+    protected:
+        std::size_t numReceivers;
+        std::size_t numMeasurements;
+        std::size_t blockSize;
+        std::size_t numPartitions;
+        std::size_t numBins;
+        std::size_t filterLength;
+        std::size_t latency;
+        double maxDelay;
+        double samplingRate;
+        
+        std::vector< double > directions;                       ///< [M 3] unit vectors
+        std::vector< double > delays;                           ///< [M R] in samples, latency included
+        std::vector< std::complex< double > > spectra;          ///< [M R numPartitions numBins]
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( BinauralFilters );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          BinauralRenderer
+     *  @brief          Renders several source signals, at given directions, to the
+     *                  receivers of a FIR file (e.g. SimpleFreeFieldHRIR), block by block
+     *
+     *  @details        The filter of a source is either the one of the nearest measurement,
+     *                  or the inverse-distance weighted sum of the spectra of the three
+     *                  nearest measurements (see sofa::BinauralFilters); the delays are
+     *                  interpolated with the same weights and applied by a windowed-sinc
+     *                  sofa::FractionalDelay (ramped over the block), and the filter changes
+     *                  are crossfaded over one block.
+     *                  The sources are rendered in parallel on a work-stealing thread pool;
+     *                  the outputs are then mixed in the order of the sources, so that the
+     *                  result does not depend on the number of threads.
+     *                  SetSourcePosition() and Process() must be called from the same thread.
+     *                  All the filters and buffers are allocated by Setup().
+     */
+    /************************************************************************************/
+    class SOFA_API BinauralRenderer
+    {
+    public:
+        enum Interpolation
+        {
+            kNearestNeighbour   = 0,    ///< the measurement closest to the source direction
+            kInverseDistance    = 1,    ///< the three closest measurements, weighted by 1 / angle^2
+            
+            kNumInterpolations  = 2
+        };
+        
+        static std::string GetName(const sofa::BinauralRenderer::Interpolation &interpolation);
+        
+    public:
+        BinauralRenderer();
+        ~BinauralRenderer();
+        
+        //==============================================================================
+        void Setup(const sofa::File &file,
+                   const std::size_t numSources,
+                   const std::size_t blockSize = 256,
+                   const sofa::BinauralRenderer::Interpolation &interpolation = kInverseDistance,
+                   const unsigned int numThreads = 0);
+        
+        void Setup(const std::shared_ptr< const sofa::BinauralFilters > &filters,
+                   const std::size_t numSources,
+                   const sofa::BinauralRenderer::Interpolation &interpolation = kInverseDistance,
+                   const unsigned int numThreads = 0);
+        
+        std::size_t GetNumSources() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetBlockSize() const;
+        double GetSamplingRate() const;
+        std::size_t GetLatency() const;
+        std::size_t GetTailLength() const;
+        
+        //==============================================================================
+        void SetSourcePosition(const std::size_t source,
+                               const double azimuth,
+                               const double elevation);
+        
+        void SetSourceDirection(const std::size_t source,
+                                const double x,
+                                const double y,
+                                const double z);
+        
+        void Process(double * const *outputs,
+                     const double * const *inputs);
+        
+        void Reset();
+        
+    protected:
+        //==============================================================================
+        struct Source;
+        
+        void updateFilter(sofa::BinauralRenderer::Source &source);
+        
+        void renderSource(sofa::BinauralRenderer::Source &source,
+                          const double *input);
+        
+    protected:
+        std::shared_ptr< const sofa::BinauralFilters > filters;
+        sofa::BinauralRenderer::Interpolation interpolation;
+        
+        std::vector< std::shared_ptr< Source > > sources;
+        std::unique_ptr< sofa::ThreadPool > pool;
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( BinauralRenderer );
+    };
+    
+}
+
+#endif /* _SOFA_BINAURAL_RENDERER_H__ */
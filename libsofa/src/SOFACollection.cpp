@@ -0,0 +1,584 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFACollection.cpp
+ *   @brief      A set of SOFA files (e.g. one file per subject) seen as one dataset
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFACollection.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAHelper.h"
+#include "../src/SOFAHostArchitecture.h"
+#include "../src/SOFAMeasurementOrder.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+#if ( SOFA_WINDOWS == 1 )
+    #include <windows.h>
+#else
+    #include <dirent.h>
+#endif
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    static bool hasExtension(const std::string &name, const std::string &extension)
+    {
+        return name.size() > extension.size()
+            && name.compare( name.size() - extension.size(), extension.size(), extension ) == 0;
+    }
+    
+    /// returns the file name, without directory and extension
+    static std::string getBaseName(const std::string &path)
+    {
+        const std::size_t slash = path.find_last_of( "/\\" );
+        const std::string name  = ( slash == std::string::npos ) ? path : path.substr( slash + 1 );
+        const std::size_t dot   = name.find_last_of( '.' );
+        
+        return ( dot == std::string::npos || dot == 0 ) ? name : name.substr( 0, dot );
+    }
+    
+    /// lists the files of a directory (not recursive), sorted by name
+    static void listDirectory(std::vector< std::string > &paths,
+                              const std::string &directory,
+                              const std::string &extension)
+    {
+        paths.clear();
+        
+        const std::string separator = ( directory.empty() == false
+                                       && directory[ directory.size() - 1 ] != '/'
+                                       && directory[ directory.size() - 1 ] != '\\' ) ? "/" : "";
+        
+#if ( SOFA_WINDOWS == 1 )
+        WIN32_FIND_DATAA data;
+        const HANDLE handle = FindFirstFileA( ( directory + separator + "*" ).c_str(), &data );
+        
+        if( handle == INVALID_HANDLE_VALUE )
+        {
+            SOFA_THROW( "cannot open directory '" + directory + "'" );
+        }
+        
+        do
+        {
+            const std::string name = data.cFileName;
+            
+            if( ( data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) == 0
+               && hasExtension( name, extension ) == true )
+            {
+                paths.push_back( directory + separator + name );
+            }
+        }
+        while( FindNextFileA( handle, &data ) != 0 );
+        
+        FindClose( handle );
+#else
+        DIR *dir = opendir( directory.c_str() );
+        
+        if( dir == NULL )
+        {
+            SOFA_THROW( "cannot open directory '" + directory + "'" );
+        }
+        
+        for( struct dirent *entry = readdir( dir ); entry != NULL; entry = readdir( dir ) )
+        {
+            const std::string name = entry->d_name;
+            
+            if( name.empty() == false && name[0] != '.'
+               && hasExtension( name, extension ) == true )
+            {
+                paths.push_back( directory + separator + name );
+            }
+        }
+        
+        closedir( dir );
+#endif
+        
+        std::sort( paths.begin(), paths.end() );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      maxOpenFiles : maximum number of files kept opened at the same time
+ *
+ */
+/************************************************************************************/
+Collection::Collection(const std::size_t maxOpenFiles_)
+: maxOpenFiles( sofa::smax( (std::size_t) 1, maxOpenFiles_ ) )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor
+ *
+ */
+/************************************************************************************/
+Collection::~Collection()
+{
+    CloseAllFiles();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a subject to the collection, and indexes its metadata
+ *  @param[in]      path : path to a SOFA file with a 'FIR' DataType
+ *
+ *  @details        The subject name is the 'ListenerShortName' attribute,
+ *                  or the file name if the attribute is empty
+ */
+/************************************************************************************/
+void Collection::Add(const std::string &path)
+{
+    const sofa::File file( path );
+    
+    if( file.IsValid() == false || file.IsFIRDataType() == false )
+    {
+        SOFA_THROW( "'" + path + "' is not a valid FIR SOFA file" );
+    }
+    
+    Subject subject;
+    subject.path             = path;
+    subject.conventions      = file.GetSOFAConventions();
+    subject.name             = file.GetAttributeValueAsString( sofa::Attributes::GetName( sofa::Attributes::kListenerShortName ) );
+    subject.numMeasurements  = file.GetNumMeasurements();
+    subject.numReceivers     = file.GetNumReceivers();
+    subject.numDataSamples   = file.GetNumDataSamples();
+    
+    if( subject.name.empty() == true )
+    {
+        subject.name = sofaLocal::getBaseName( path );
+    }
+    
+    std::vector< double > samplingRate;
+    if( file.GetValues( samplingRate, "Data.SamplingRate" ) == false || samplingRate.empty() == true )
+    {
+        SOFA_THROW( "invalid 'Data.SamplingRate' in '" + path + "'" );
+    }
+    subject.samplingRate = samplingRate[0];
+    
+    if( file.GetSourcePositionAsCartesian( subject.directions ) == false )
+    {
+        SOFA_THROW( "invalid 'SourcePosition' in '" + path + "'" );
+    }
+    
+    std::vector< double > listener;
+    const bool hasListener = file.GetListenerPositionAsCartesian( listener );
+    
+    for( std::size_t i = 0; i < subject.numMeasurements; i++ )
+    {
+        double *xyz = &subject.directions[ 3 * i ];
+        
+        if( hasListener == true )
+        {
+            xyz[0] -= listener[ 3 * i + 0 ];
+            xyz[1] -= listener[ 3 * i + 1 ];
+            xyz[2] -= listener[ 3 * i + 2 ];
+        }
+        
+        const double norm = std::sqrt( xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2] );
+        
+        if( norm > 0.0 )
+        {
+            xyz[0] /= norm;
+            xyz[1] /= norm;
+            xyz[2] /= norm;
+        }
+    }
+    
+    subjects.push_back( subject );
+    openFiles.push_back( NULL );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds all the valid FIR SOFA files of a directory (not recursive)
+ *  @param[in]      directory : the directory to scan
+ *  @param[in]      extension : extension of the files to consider
+ *  @return         the number of subjects added
+ *
+ *  @details        Files are added in alphabetical order; invalid files are skipped
+ */
+/************************************************************************************/
+std::size_t Collection::AddDirectory(const std::string &directory,
+                                     const std::string &extension)
+{
+    std::vector< std::string > paths;
+    sofaLocal::listDirectory( paths, directory, extension );
+    
+    std::size_t numAdded = 0;
+    
+    for( std::size_t i = 0; i < paths.size(); i++ )
+    {
+        if( sofa::IsValidSOFAFile( paths[i] ) == false )
+        {
+            continue;
+        }
+        
+        const bool exceptionState = sofa::Exception::IsLoggedToCerr();
+        sofa::Exception::LogToCerr( false );
+        
+        try
+        {
+            Add( paths[i] );
+            numAdded++;
+        }
+        catch( ... )
+        {
+            /// not a FIR file, or inconsistent metadata
+        }
+        
+        sofa::Exception::LogToCerr( exceptionState );
+    }
+    
+    return numAdded;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of subjects in the collection
+ *
+ */
+/************************************************************************************/
+std::size_t Collection::GetNumSubjects() const
+{
+    return subjects.size();
+}
+
+const Collection::Subject & Collection::getSubject(const std::size_t subject) const
+{
+    if( subject >= subjects.size() )
+    {
+        SOFA_THROW( "invalid subject index" );
+    }
+    
+    return subjects[ subject ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Metadata of a subject, as indexed when it was added
+ *
+ */
+/************************************************************************************/
+const std::string & Collection::GetPath(const std::size_t subject) const
+{
+    return getSubject( subject ).path;
+}
+
+const std::string & Collection::GetSubjectName(const std::size_t subject) const
+{
+    return getSubject( subject ).name;
+}
+
+const std::string & Collection::GetSOFAConventions(const std::size_t subject) const
+{
+    return getSubject( subject ).conventions;
+}
+
+std::size_t Collection::GetNumMeasurements(const std::size_t subject) const
+{
+    return getSubject( subject ).numMeasurements;
+}
+
+std::size_t Collection::GetNumReceivers(const std::size_t subject) const
+{
+    return getSubject( subject ).numReceivers;
+}
+
+std::size_t Collection::GetNumDataSamples(const std::size_t subject) const
+{
+    return getSubject( subject ).numDataSamples;
+}
+
+double Collection::GetSamplingRate(const std::size_t subject) const
+{
+    return getSubject( subject ).samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the source directions of a subject, as [M 3] unit vectors
+ *                  relative to the listener position
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & Collection::GetSourceDirections(const std::size_t subject) const
+{
+    return getSubject( subject ).directions;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if all the subjects share the same number of receivers,
+ *                  the same number of samples and the same sampling rate
+ *
+ */
+/************************************************************************************/
+bool Collection::HasUniformDimensions() const
+{
+    for( std::size_t i = 1; i < subjects.size(); i++ )
+    {
+        if( subjects[i].numReceivers   != subjects[0].numReceivers
+           || subjects[i].numDataSamples != subjects[0].numDataSamples
+           || subjects[i].samplingRate   != subjects[0].samplingRate )
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+void Collection::checkUniformDimensions() const
+{
+    if( HasUniformDimensions() == false )
+    {
+        SOFA_THROW( "the subjects do not share the same dimensions and sampling rate" );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement of a subject that is the closest to a direction
+ *  @param[in]      x, y, z : the direction, in cartesian coordinates (need not be normalized)
+ *
+ */
+/************************************************************************************/
+std::size_t Collection::FindNearestMeasurement(const std::size_t subject,
+                                               const double x,
+                                               const double y,
+                                               const double z) const
+{
+    const Subject & s = getSubject( subject );
+    
+    const double norm = std::sqrt( x * x + y * y + z * z );
+    
+    const double u[3] =
+    {
+        ( norm > 0.0 ) ? x / norm : 0.0,
+        ( norm > 0.0 ) ? y / norm : 0.0,
+        ( norm > 0.0 ) ? z / norm : 0.0
+    };
+    
+    return sofa::MeasurementOrder::FindNearestDirection( u, s.directions );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the file of a subject, opening it if needed
+ *
+ *  @details        The reference remains valid until 'maxOpenFiles' other subjects
+ *                  have been accessed, or CloseAllFiles() is called
+ */
+/************************************************************************************/
+const sofa::File & Collection::GetFile(const std::size_t subject)
+{
+    const Subject & s = getSubject( subject );
+    
+    if( openFiles[ subject ] != NULL )
+    {
+        /// move to the front of the list
+        recentlyUsed.remove( subject );
+        recentlyUsed.push_front( subject );
+        
+        return *openFiles[ subject ];
+    }
+    
+    while( recentlyUsed.size() >= maxOpenFiles )
+    {
+        const std::size_t oldest = recentlyUsed.back();
+        recentlyUsed.pop_back();
+        
+        delete openFiles[ oldest ];
+        openFiles[ oldest ] = NULL;
+    }
+    
+    openFiles[ subject ] = new sofa::File( s.path );
+    recentlyUsed.push_front( subject );
+    
+    return *openFiles[ subject ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of consecutive measurements of a subject
+ *  @param[in]      values : array of numMeasurements x R x N values
+ *
+ */
+/************************************************************************************/
+void Collection::GetDataIR(double *values,
+                           const std::size_t subject,
+                           const std::size_t firstMeasurement,
+                           const std::size_t numMeasurements)
+{
+    const sofa::File & file = GetFile( subject );
+    
+    if( file.GetDataIRMeasurements( values, firstMeasurement, numMeasurements ) == false )
+    {
+        SOFA_THROW( "cannot read 'Data.IR' of '" + GetPath( subject ) + "'" );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves, for every subject, the impulse responses measured
+ *                  the closest to a direction
+ *  @param[out]     values : [S R N] impulse responses
+ *  @param[out]     measurements : [S] index of the selected measurement of each subject
+ *  @param[in]      x, y, z : the direction, in cartesian coordinates
+ *
+ *  @details        All the subjects must share the same dimensions
+ */
+/************************************************************************************/
+void Collection::GetDataIRForDirection(std::vector< double > &values,
+                                       std::vector< std::size_t > &measurements,
+                                       const double x,
+                                       const double y,
+                                       const double z)
+{
+    std::vector< double > directions( 3 );
+    directions[0] = x;
+    directions[1] = y;
+    directions[2] = z;
+    
+    GetDataIRForDirections( values, measurements, directions );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves, for every subject, the impulse responses measured
+ *                  the closest to a set of directions
+ *  @param[out]     values : [S K R N] impulse responses
+ *  @param[out]     measurements : [S K] index of the selected measurements
+ *  @param[in]      directions : [K 3] directions, in cartesian coordinates
+ *
+ *  @details        The subjects are visited one after the other, so that
+ *                  each file is opened at most once, whatever maxOpenFiles.
+ *                  All the subjects must share the same dimensions
+ */
+/************************************************************************************/
+void Collection::GetDataIRForDirections(std::vector< double > &values,
+                                        std::vector< std::size_t > &measurements,
+                                        const std::vector< double > &directions)
+{
+    checkUniformDimensions();
+    
+    if( directions.size() % 3 != 0 )
+    {
+        SOFA_THROW( "directions must be [K 3]" );
+    }
+    
+    const std::size_t S = subjects.size();
+    const std::size_t K = directions.size() / 3;
+    
+    if( S == 0 )
+    {
+        values.clear();
+        measurements.clear();
+        return;
+    }
+    
+    const std::size_t responseSize = subjects[0].numReceivers * subjects[0].numDataSamples;
+    
+    values.resize( S * K * responseSize );
+    measurements.resize( S * K );
+    
+    for( std::size_t s = 0; s < S; s++ )
+    {
+        for( std::size_t k = 0; k < K; k++ )
+        {
+            const std::size_t index = s * K + k;
+            
+            measurements[ index ] = FindNearestMeasurement( s,
+                                                            directions[ 3 * k + 0 ],
+                                                            directions[ 3 * k + 1 ],
+                                                            directions[ 3 * k + 2 ] );
+            
+            GetDataIR( &values[ index * responseSize ], s, measurements[ index ], 1 );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the maximum number of files kept opened at the same time
+ *
+ */
+/************************************************************************************/
+std::size_t Collection::GetMaxOpenFiles() const
+{
+    return maxOpenFiles;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of files currently opened
+ *
+ */
+/************************************************************************************/
+std::size_t Collection::GetNumOpenFiles() const
+{
+    return recentlyUsed.size();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Closes all the opened files (the metadata are kept)
+ *
+ */
+/************************************************************************************/
+void Collection::CloseAllFiles()
+{
+    for( std::size_t i = 0; i < openFiles.size(); i++ )
+    {
+        delete openFiles[i];
+        openFiles[i] = NULL;
+    }
+    
+    recentlyUsed.clear();
+}
@@ -0,0 +1,162 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFACollection.h
+ *   @brief      A set of SOFA files (e.g. one file per subject) seen as one dataset
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_COLLECTION_H__
+#define _SOFA_COLLECTION_H__
+
+#include "../src/SOFAFile.h"
+#include <list>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Collection
+     *  @brief          Represents a database of FIR SOFA files, with one file per subject
+     *
+     *  @details        The metadata of each file (dimensions, sampling rate, source directions)
+     *                  is read once, when the file is added. The impulse responses are then
+     *                  read on demand, keeping at most 'maxOpenFiles' files opened at the
+     *                  same time (the least recently used file is closed first).
+     *                  Subjects are indexed in the order they were added.
+     *                  This class is not thread-safe.
+     */
+    /************************************************************************************/
+    class SOFA_API Collection
+    {
+    public:
+        Collection(const std::size_t maxOpenFiles = 16);
+        ~Collection();
+        
+        //==============================================================================
+        void Add(const std::string &path);
+        std::size_t AddDirectory(const std::string &directory,
+                                 const std::string &extension = ".sofa");
+        
+        //==============================================================================
+        // Subjects metadata
+        //==============================================================================
+        std::size_t GetNumSubjects() const;
+        
+        const std::string & GetPath(const std::size_t subject) const;
+        const std::string & GetSubjectName(const std::size_t subject) const;
+        const std::string & GetSOFAConventions(const std::size_t subject) const;
+        
+        std::size_t GetNumMeasurements(const std::size_t subject) const;
+        std::size_t GetNumReceivers(const std::size_t subject) const;
+        std::size_t GetNumDataSamples(const std::size_t subject) const;
+        double GetSamplingRate(const std::size_t subject) const;
+        
+        const std::vector< double > & GetSourceDirections(const std::size_t subject) const;
+        
+        bool HasUniformDimensions() const;
+        
+        std::size_t FindNearestMeasurement(const std::size_t subject,
+                                           const double x,
+                                           const double y,
+                                           const double z) const;
+        
+        //==============================================================================
+        // Data
+        //==============================================================================
+        const sofa::File & GetFile(const std::size_t subject);
+        
+        void GetDataIR(double *values,
+                       const std::size_t subject,
+                       const std::size_t firstMeasurement,
+                       const std::size_t numMeasurements);
+        
+        void GetDataIRForDirection(std::vector< double > &values,
+                                   std::vector< std::size_t > &measurements,
+                                   const double x,
+                                   const double y,
+                                   const double z);
+        
+        void GetDataIRForDirections(std::vector< double > &values,
+                                    std::vector< std::size_t > &measurements,
+                                    const std::vector< double > &directions);
+        
+        //==============================================================================
+        std::size_t GetMaxOpenFiles() const;
+        std::size_t GetNumOpenFiles() const;
+        void CloseAllFiles();
+        
+    protected:
+        //==============================================================================
+        struct Subject
+        {
+            std::string path;
+            std::string name;
+            std::string conventions;
+            std::size_t numMeasurements;
+            std::size_t numReceivers;
+            std::size_t numDataSamples;
+            double samplingRate;
+            std::vector< double > directions;  ///< [M 3] unit vectors, relative to the listener
+        };
+        
+        const Subject & getSubject(const std::size_t subject) const;
+        
+        void checkUniformDimensions() const;
+        
+    protected:
+        std::vector< Subject > subjects;
+        std::vector< sofa::File * > openFiles;      ///< one entry per subject, NULL when closed
+        std::list< std::size_t > recentlyUsed;      ///< opened subjects, most recently used first
+        const std::size_t maxOpenFiles;
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( Collection );
+    };
+    
+}
+
+#endif /* _SOFA_COLLECTION_H__ */
@@ -0,0 +1,351 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAConvolver.cpp
+ *   @brief      Frequency-domain convolution with uniformly partitioned filters
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAConvolver.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Constructor
+ *  @param[in]      blockSize : number of samples processed at once (power of 2)
+ *  @param[in]      maxFilterLength : maximum length of the filter, in samples
+ *
+ */
+/************************************************************************************/
+Convolver::Convolver(const std::size_t blockSize_,
+                     const std::size_t maxFilterLength)
+: blockSize( blockSize_ )
+, numPartitions( ( sofa::FFT::IsPowerOfTwo( blockSize_ ) == true ) ? ( std::max( maxFilterLength, (std::size_t) 1 ) + blockSize_ - 1 ) / blockSize_ : 1 )
+, fft( 2 * blockSize_ )
+, currentPartition( 0 )
+, crossfading( false )
+{
+    const std::size_t numBins = fft.GetNumBins();
+    
+    filterSpectrum.assign( numPartitions * numBins, std::complex< double >( 0.0, 0.0 ) );
+    delayLine.assign( numPartitions * numBins, std::complex< double >( 0.0, 0.0 ) );
+    accumulator.assign( numBins, std::complex< double >( 0.0, 0.0 ) );
+    inputBuffer.assign( 2 * blockSize, 0.0 );
+    outputBuffer.assign( 2 * blockSize, 0.0 );
+    previousSpectrum.assign( numPartitions * numBins, std::complex< double >( 0.0, 0.0 ) );
+    previousBuffer.assign( 2 * blockSize, 0.0 );
+}
+
+std::size_t Convolver::GetBlockSize() const
+{
+    return blockSize;
+}
+
+std::size_t Convolver::GetFFTSize() const
+{
+    return fft.GetSize();
+}
+
+std::size_t Convolver::GetNumBins() const
+{
+    return fft.GetNumBins();
+}
+
+std::size_t Convolver::GetNumPartitions() const
+{
+    return numPartitions;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          accumulator += a * b, over numBins complex values
+ *
+ *  @details        Written on the real and imaginary parts so that the compiler
+ *                  vectorizes it (and does not call the C99 complex multiplication)
+ */
+/************************************************************************************/
+void Convolver::MultiplyAccumulate(std::complex< double > *accumulator,
+                                   const std::complex< double > *a,
+                                   const std::complex< double > *b,
+                                   const std::size_t numBins)
+{
+    double *acc         = reinterpret_cast< double * >( accumulator );
+    const double *x     = reinterpret_cast< const double * >( a );
+    const double *y     = reinterpret_cast< const double * >( b );
+    
+    for( std::size_t k = 0; k < numBins; k++ )
+    {
+        const double xr = x[ 2 * k ];
+        const double xi = x[ 2 * k + 1 ];
+        const double yr = y[ 2 * k ];
+        const double yi = y[ 2 * k + 1 ];
+        
+        acc[ 2 * k ]     += xr * yr - xi * yi;
+        acc[ 2 * k + 1 ] += xr * yi + xi * yr;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the spectra of the partitions of a filter
+ *  @param[out]     spectrum : [numPartitions fft.GetNumBins()], numPartitions being
+ *                  the number of blocks of fft.GetSize() / 2 samples needed for the filter
+ *  @param[in]      fft : the transform of size 2 * blockSize
+ *
+ *  @details        The spectra can be computed once, and shared by several convolvers
+ */
+/************************************************************************************/
+void Convolver::ComputeFilterSpectrum(std::vector< std::complex< double > > &spectrum,
+                                      const sofa::FFT &fft,
+                                      const double *filter,
+                                      const std::size_t length)
+{
+    const std::size_t partitionSize = fft.GetSize() / 2;
+    const std::size_t numBins       = fft.GetNumBins();
+    const std::size_t partitions    = std::max( (std::size_t) 1, ( length + partitionSize - 1 ) / partitionSize );
+    
+    spectrum.resize( partitions * numBins );
+    
+    std::vector< double > buffer( fft.GetSize() );
+    
+    for( std::size_t p = 0; p < partitions; p++ )
+    {
+        const std::size_t first = p * partitionSize;
+        const std::size_t count = ( first < length ) ? std::min( partitionSize, length - first ) : 0;
+        
+        std::fill( buffer.begin(), buffer.end(), 0.0 );
+        std::copy( filter + first, filter + first + count, buffer.begin() );
+        
+        fft.ForwardReal( &spectrum[ p * numBins ], &buffer[0] );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the filter, in the time domain
+ *  @param[in]      filter : the impulse response
+ *  @param[in]      length : at most GetNumPartitions() * GetBlockSize() samples
+ *  @param[in]      crossfade : if true, the next block is crossfaded from the previous filter
+ *
+ */
+/************************************************************************************/
+void Convolver::SetFilter(const double *filter,
+                          const std::size_t length,
+                          const bool crossfade)
+{
+    if( length > numPartitions * blockSize )
+    {
+        SOFA_THROW( "filter too long for this convolver" );
+    }
+    
+    std::vector< std::complex< double > > spectrum;
+    ComputeFilterSpectrum( spectrum, fft, filter, length );
+    
+    SetFilterSpectrum( &spectrum[0], spectrum.size() / fft.GetNumBins(), crossfade );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the filter, as the spectra of its partitions
+ *  @param[in]      spectrum : [numPartitions GetNumBins()] complex values
+ *  @param[in]      numPartitions : at most GetNumPartitions()
+ *  @param[in]      crossfade : if true, the next block is crossfaded from the previous filter
+ *
+ *  @details        This does not allocate memory
+ */
+/************************************************************************************/
+void Convolver::SetFilterSpectrum(const std::complex< double > *spectrum,
+                                  const std::size_t numPartitions_,
+                                  const bool crossfade)
+{
+    if( numPartitions_ > numPartitions )
+    {
+        SOFA_THROW( "filter too long for this convolver" );
+    }
+    
+    /// if several filters are set before the next block, the fade starts from the
+    /// filter of the last block
+    if( crossfade == true && crossfading == false )
+    {
+        previousSpectrum.swap( filterSpectrum );
+        crossfading = true;
+    }
+    
+    const std::size_t numValues = numPartitions_ * fft.GetNumBins();
+    
+    std::copy( spectrum, spectrum + numValues, filterSpectrum.begin() );
+    std::fill( filterSpectrum.begin() + numValues, filterSpectrum.end(), std::complex< double >( 0.0, 0.0 ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the filter, as the spectra of its partitions, with split
+ *                  real and imaginary parts (e.g. Data.Real and Data.Imag of a GeneralTF file)
+ *  @param[in]      real : [numPartitions GetNumBins()] values
+ *  @param[in]      imag : [numPartitions GetNumBins()] values
+ *  @param[in]      numPartitions : at most GetNumPartitions()
+ *  @param[in]      crossfade : if true, the next block is crossfaded from the previous filter
+ *
+ *  @details        This does not allocate memory
+ */
+/************************************************************************************/
+void Convolver::SetFilterSpectrum(const double *real,
+                                  const double *imag,
+                                  const std::size_t numPartitions_,
+                                  const bool crossfade)
+{
+    if( numPartitions_ > numPartitions )
+    {
+        SOFA_THROW( "filter too long for this convolver" );
+    }
+    
+    /// if several filters are set before the next block, the fade starts from the
+    /// filter of the last block
+    if( crossfade == true && crossfading == false )
+    {
+        previousSpectrum.swap( filterSpectrum );
+        crossfading = true;
+    }
+    
+    const std::size_t numValues = numPartitions_ * fft.GetNumBins();
+    
+    for( std::size_t k = 0; k < numValues; k++ )
+    {
+        filterSpectrum[k] = std::complex< double >( real[k], imag[k] );
+    }
+    std::fill( filterSpectrum.begin() + numValues, filterSpectrum.end(), std::complex< double >( 0.0, 0.0 ) );
+}
+
+const std::vector< std::complex< double > > & Convolver::GetFilterSpectrum() const
+{
+    return filterSpectrum;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Convolves one block
+ *  @param[out]     output : GetBlockSize() samples (may be the input buffer)
+ *  @param[in]      input : GetBlockSize() samples
+ *
+ */
+/************************************************************************************/
+void Convolver::Process(double *output,
+                        const double *input)
+{
+    const std::size_t numBins = fft.GetNumBins();
+    
+    /// the FFT frame holds the previous block and the current one
+    std::copy( inputBuffer.begin() + blockSize, inputBuffer.end(), inputBuffer.begin() );
+    std::copy( input, input + blockSize, inputBuffer.begin() + blockSize );
+    
+    currentPartition = ( currentPartition + numPartitions - 1 ) % numPartitions;
+    
+    fft.ForwardReal( &delayLine[ currentPartition * numBins ], &inputBuffer[0] );
+    
+    convolve( outputBuffer, filterSpectrum );
+    
+    if( crossfading == true )
+    {
+        convolve( previousBuffer, previousSpectrum );
+        
+        /// the first half is circularly aliased
+        for( std::size_t n = 0; n < blockSize; n++ )
+        {
+            const double gain       = static_cast< double >( n + 1 ) / static_cast< double >( blockSize );
+            const double previous   = previousBuffer[ blockSize + n ];
+            
+            output[n] = previous + gain * ( outputBuffer[ blockSize + n ] - previous );
+        }
+        
+        crossfading = false;
+        return;
+    }
+    
+    /// the first half is circularly aliased
+    std::copy( outputBuffer.begin() + blockSize, outputBuffer.end(), output );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Multiplies the past input blocks by the partitions of a filter,
+ *                  and transforms the sum back to the time domain
+ *
+ */
+/************************************************************************************/
+void Convolver::convolve(std::vector< double > &buffer,
+                         const std::vector< std::complex< double > > &spectrum)
+{
+    const std::size_t numBins = fft.GetNumBins();
+    
+    std::fill( accumulator.begin(), accumulator.end(), std::complex< double >( 0.0, 0.0 ) );
+    
+    /// partition p of the filter applies to the block received p blocks ago
+    for( std::size_t p = 0; p < numPartitions; p++ )
+    {
+        const std::size_t slot = ( currentPartition + p ) % numPartitions;
+        
+        MultiplyAccumulate( &accumulator[0],
+                            &delayLine[ slot * numBins ],
+                            &spectrum[ p * numBins ],
+                            numBins );
+    }
+    
+    fft.InverseReal( &buffer[0], &accumulator[0] );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the past input (the filter is kept)
+ *
+ */
+/************************************************************************************/
+void Convolver::Reset()
+{
+    std::fill( delayLine.begin(), delayLine.end(), std::complex< double >( 0.0, 0.0 ) );
+    std::fill( inputBuffer.begin(), inputBuffer.end(), 0.0 );
+    currentPartition = 0;
+    crossfading = false;
+}
@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAConvolver.h
+ *   @brief      Frequency-domain convolution with uniformly partitioned filters
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_CONVOLVER_H__
+#define _SOFA_CONVOLVER_H__
+
+#include "../src/SOFAFFT.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Convolver
+     *  @brief          Block convolution of a signal with a filter (uniformly partitioned
+     *                  overlap-save)
+     *
+     *  @details        The filter is cut into partitions of blockSize samples, each of them
+     *                  being transformed with a FFT of size 2 * blockSize.
+     *                  The filter can be given in the time domain (SetFilter), or directly
+     *                  as the spectra of its partitions (SetFilterSpectrum) : e.g. the
+     *                  transfer functions of a GeneralTF file whose N axis is a FFT grid
+     *                  of size 2 * blockSize (see GeneralTF::IsFFTFrequencyAxis), for
+     *                  filters up to blockSize samples, are used without any inverse FFT.
+     *                  When a filter is set with crossfade, the next block is computed with
+     *                  both the previous and the new filter, and linearly crossfaded.
+     *                  An object processes one signal, and must not be shared between threads.
+     */
+    /************************************************************************************/
+    class SOFA_API Convolver
+    {
+    public:
+        Convolver(const std::size_t blockSize,
+                  const std::size_t maxFilterLength);
+        
+        ~Convolver() {};
+        
+        std::size_t GetBlockSize() const;
+        std::size_t GetFFTSize() const;
+        std::size_t GetNumBins() const;
+        std::size_t GetNumPartitions() const;
+        
+        //==============================================================================
+        void SetFilter(const double *filter,
+                       const std::size_t length,
+                       const bool crossfade = false);
+        
+        void SetFilterSpectrum(const std::complex< double > *spectrum,
+                               const std::size_t numPartitions = 1,
+                               const bool crossfade = false);
+        
+        void SetFilterSpectrum(const double *real,
+                               const double *imag,
+                               const std::size_t numPartitions = 1,
+                               const bool crossfade = false);
+        
+        const std::vector< std::complex< double > > & GetFilterSpectrum() const;
+        
+        static void ComputeFilterSpectrum(std::vector< std::complex< double > > &spectrum,
+                                          const sofa::FFT &fft,
+                                          const double *filter,
+                                          const std::size_t length);
+        
+        static void MultiplyAccumulate(std::complex< double > *accumulator,
+                                       const std::complex< double > *a,
+                                       const std::complex< double > *b,
+                                       const std::size_t numBins);
+        
+        //==============================================================================
+        void Process(double *output,
+                     const double *input);
+        
+        void Reset();
+        
+    protected:
+        //==============================================================================
+        void convolve(std::vector< double > &buffer,
+                      const std::vector< std::complex< double > > &spectrum);
+        
+    protected:
+        const std::size_t blockSize;
+        const std::size_t numPartitions;
+        const sofa::FFT fft;
+        
+        std::vector< std::complex< double > > filterSpectrum;   ///< [numPartitions numBins]
+        std::vector< std::complex< double > > delayLine;        ///< [numPartitions numBins] spectra of the past input blocks
+        std::vector< std::complex< double > > accumulator;      ///< numBins
+        std::vector< double > inputBuffer;                      ///< the last 2 * blockSize input samples
+        std::vector< double > outputBuffer;                     ///< 2 * blockSize
+        std::size_t currentPartition;                           ///< slot of the most recent block in the delay line
+        
+        std::vector< std::complex< double > > previousSpectrum; ///< [numPartitions numBins] filter faded out by the next block
+        std::vector< double > previousBuffer;                   ///< 2 * blockSize
+        bool crossfading;
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( Convolver );
+    };
+    
+}
+
+#endif /* _SOFA_CONVOLVER_H__ */
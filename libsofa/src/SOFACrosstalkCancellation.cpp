@@ -0,0 +1,326 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFACrosstalkCancellation.cpp
+ *   @brief      Crosstalk-cancellation filters for binaural playback over loudspeakers
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFACrosstalkCancellation.h"
+#include "../src/SOFAMeasurementOrder.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+CrosstalkCancellation::CrosstalkCancellation()
+: numLoudspeakers( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the transfer functions of all the measurements of a file
+ *  @param[in]      file : a FIR file with two receivers and one emitter (e.g. SimpleFreeFieldHRIR)
+ *  @param[in]      fftSize : length of the filters (power of 2); 0 for four times the
+ *                  length of the responses, Data.Delay included
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ */
+/************************************************************************************/
+void CrosstalkCancellation::Load(const sofa::File &file,
+                                 const std::size_t fftSize,
+                                 const unsigned int numThreads)
+{
+    sofa::ImpulseResponses responses;
+    responses.Load( file );
+    
+    if( responses.GetNumReceivers() != 2 || responses.GetNumEmitters() != 1 || responses.GetNumMeasurements() == 0 )
+    {
+        SOFA_THROW( "the responses must have two receivers, one emitter, and at least one measurement" );
+    }
+    
+    double maxDelay = 0.0;
+    for( std::size_t i = 0; i < responses.GetNumResponses(); i++ )
+    {
+        maxDelay = sofa::smax( maxDelay, responses.GetDelay( i ) );
+    }
+    
+    /// the inverse filters are longer than the responses
+    const std::size_t length = responses.GetNumDataSamples() + static_cast< std::size_t >( std::ceil( maxDelay ) );
+    const std::size_t K      = ( fftSize == 0 ) ? 4 * sofa::FFT::GetNextPowerOfTwo( length ) : fftSize;
+    
+    if( sofa::FFT::IsPowerOfTwo( K ) == false || K < length )
+    {
+        SOFA_THROW( "the FFT size must be a power of 2, larger than the responses" );
+    }
+    
+    spectra.Compute( responses, K, numThreads );
+    
+    sofa::MeasurementOrder::GetUnitMeasurementDirections( file, directions );
+    
+    numLoudspeakers = 0;
+    measurements.clear();
+    filters.clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Designs the filters for a set of loudspeakers
+ *  @param[in]      directions : [numLoudspeakers 2] azimuth and elevation (degrees) of the
+ *                  loudspeakers, relative to the listener
+ *  @param[in]      numLoudspeakers : at least 2
+ *  @param[in]      regularizationDB : beta, relative to the mean power of the responses
+ *
+ *  @details        The transfer functions are not recomputed : only the selection, the
+ *                  inversion and 2 * numLoudspeakers inverse FFT
+ */
+/************************************************************************************/
+void CrosstalkCancellation::Design(const double *loudspeakerDirections,
+                                   const std::size_t numLoudspeakers_,
+                                   const double regularizationDB)
+{
+    if( spectra.GetNumMeasurements() == 0 )
+    {
+        SOFA_THROW( "no transfer functions loaded" );
+    }
+    
+    if( numLoudspeakers_ < 2 )
+    {
+        SOFA_THROW( "at least two loudspeakers are required" );
+    }
+    
+    const std::size_t L = numLoudspeakers_;
+    const std::size_t K = spectra.GetFFTSize();
+    const std::size_t B = spectra.GetNumBins();
+    
+    numLoudspeakers = L;
+    
+    measurements.resize( L );
+    real.resize( ( 2 * L + 4 ) * B );
+    imag.resize( 2 * L * B );
+    spectrum.resize( B );
+    filters.resize( L * 2 * K );
+    
+    //==============================================================================
+    /// H : [2 L numBins], split real and imaginary parts
+    for( std::size_t l = 0; l < L; l++ )
+    {
+        const double aed[3] = { loudspeakerDirections[ 2 * l ], loudspeakerDirections[ 2 * l + 1 ], 1.0 };
+        double xyz[3];
+        sofa::SphericalToCartesian( xyz, aed );
+        
+        measurements[l] = sofa::MeasurementOrder::FindNearestDirection( xyz, directions );
+        
+        for( std::size_t r = 0; r < 2; r++ )
+        {
+            const std::complex< double > *h = spectra.GetSpectrum( spectra.GetResponseIndex( measurements[l], r ) );
+            
+            double *hr = &real[ ( r * L + l ) * B ];
+            double *hi = &imag[ ( r * L + l ) * B ];
+            
+            for( std::size_t k = 0; k < B; k++ )
+            {
+                hr[k] = h[k].real();
+                hi[k] = h[k].imag();
+            }
+        }
+    }
+    
+    //==============================================================================
+    /// A = H H^H : a11 and a22 are real, a21 = conj( a12 )
+    double *a11 = &real[ 2 * L * B ];
+    double *a22 = a11 + B;
+    double *a12r = a22 + B;
+    double *a12i = a12r + B;
+    
+    std::fill( a11, a11 + 4 * B, 0.0 );
+    
+    for( std::size_t l = 0; l < L; l++ )
+    {
+        const double *h0r = &real[ l * B ];
+        const double *h0i = &imag[ l * B ];
+        const double *h1r = &real[ ( L + l ) * B ];
+        const double *h1i = &imag[ ( L + l ) * B ];
+        
+        for( std::size_t k = 0; k < B; k++ )
+        {
+            a11[k]  += h0r[k] * h0r[k] + h0i[k] * h0i[k];
+            a22[k]  += h1r[k] * h1r[k] + h1i[k] * h1i[k];
+            a12r[k] += h0r[k] * h1r[k] + h0i[k] * h1i[k];
+            a12i[k] += h0i[k] * h1r[k] - h0r[k] * h1i[k];
+        }
+    }
+    
+    double power = 0.0;
+    for( std::size_t k = 0; k < B; k++ )
+    {
+        power += 0.5 * ( a11[k] + a22[k] );
+    }
+    power /= static_cast< double >( B );
+    
+    if( power <= 0.0 )
+    {
+        SOFA_THROW( "the selected responses are null" );
+    }
+    
+    const double beta = power * std::pow( 10.0, regularizationDB / 10.0 );
+    
+    /// ( A + beta I )^-1 = [ a22 -a12 ; -a21 a11 ] / det, stored in place
+    for( std::size_t k = 0; k < B; k++ )
+    {
+        a11[k] += beta;
+        a22[k] += beta;
+        
+        const double scale = 1.0 / ( a11[k] * a22[k] - a12r[k] * a12r[k] - a12i[k] * a12i[k] );
+        
+        a11[k]  *= scale;
+        a22[k]  *= scale;
+        a12r[k] *= scale;
+        a12i[k] *= scale;
+    }
+    
+    //==============================================================================
+    /// C = H^H ( A + beta I )^-1, delayed by K / 2 samples (sign of the odd bins)
+    const sofa::FFT fft( K );
+    
+    double *c = reinterpret_cast< double * >( &spectrum[0] );
+    
+    for( std::size_t l = 0; l < L; l++ )
+    {
+        const double *h0r = &real[ l * B ];
+        const double *h0i = &imag[ l * B ];
+        const double *h1r = &real[ ( L + l ) * B ];
+        const double *h1i = &imag[ ( L + l ) * B ];
+        
+        /// C[l 0] = conj( H0l ) a22 - conj( H1l ) conj( a12 )
+        for( std::size_t k = 0; k < B; k++ )
+        {
+            const double sign = ( k % 2 == 0 ) ? 1.0 : -1.0;
+            
+            c[ 2 * k ]     = sign * ( h0r[k] * a22[k] - ( h1r[k] * a12r[k] - h1i[k] * a12i[k] ) );
+            c[ 2 * k + 1 ] = sign * ( -h0i[k] * a22[k] + ( h1r[k] * a12i[k] + h1i[k] * a12r[k] ) );
+        }
+        
+        fft.InverseReal( &filters[ ( l * 2 + 0 ) * K ], &spectrum[0] );
+        
+        /// C[l 1] = conj( H1l ) a11 - conj( H0l ) a12
+        for( std::size_t k = 0; k < B; k++ )
+        {
+            const double sign = ( k % 2 == 0 ) ? 1.0 : -1.0;
+            
+            c[ 2 * k ]     = sign * ( h1r[k] * a11[k] - ( h0r[k] * a12r[k] + h0i[k] * a12i[k] ) );
+            c[ 2 * k + 1 ] = sign * ( -h1i[k] * a11[k] - ( h0r[k] * a12i[k] - h0i[k] * a12r[k] ) );
+        }
+        
+        fft.InverseReal( &filters[ ( l * 2 + 1 ) * K ], &spectrum[0] );
+    }
+}
+
+std::size_t CrosstalkCancellation::GetNumMeasurements() const
+{
+    return spectra.GetNumMeasurements();
+}
+
+std::size_t CrosstalkCancellation::GetNumLoudspeakers() const
+{
+    return numLoudspeakers;
+}
+
+std::size_t CrosstalkCancellation::GetFilterLength() const
+{
+    return spectra.GetFFTSize();
+}
+
+double CrosstalkCancellation::GetSamplingRate() const
+{
+    return spectra.GetSamplingRate();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement selected for a loudspeaker by the last Design()
+ *
+ */
+/************************************************************************************/
+std::size_t CrosstalkCancellation::GetMeasurement(const std::size_t loudspeaker) const
+{
+    SOFA_ASSERT( loudspeaker < numLoudspeakers );
+    
+    return measurements[ loudspeaker ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the filter from one channel of the binaural signal to one
+ *                  loudspeaker (GetFilterLength() samples)
+ *  @param[in]      receiver : 0 for the left ear, 1 for the right ear
+ *
+ */
+/************************************************************************************/
+const double * CrosstalkCancellation::GetFilter(const std::size_t loudspeaker,
+                                                const std::size_t receiver) const
+{
+    SOFA_ASSERT( loudspeaker < numLoudspeakers && receiver < 2 );
+    
+    return &filters[ ( loudspeaker * 2 + receiver ) * spectra.GetFFTSize() ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns all the filters, [L 2 GetFilterLength()]
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & CrosstalkCancellation::GetFilters() const
+{
+    return filters;
+}
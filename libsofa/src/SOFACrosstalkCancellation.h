@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFACrosstalkCancellation.h
+ *   @brief      Crosstalk-cancellation filters for binaural playback over loudspeakers
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_CROSSTALK_CANCELLATION_H__
+#define _SOFA_CROSSTALK_CANCELLATION_H__
+
+#include "../src/SOFATransferFunctions.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          CrosstalkCancellation
+     *  @brief          Designs the filters feeding L loudspeakers from the two channels of a
+     *                  binaural signal, from the HRTFs of a SimpleFreeFieldHRIR file
+     *
+     *  @details        Load() computes the transfer functions of all the measurements once.
+     *                  Design() then selects the nearest measurement of each loudspeaker
+     *                  direction (relative to the listener), and inverts the [2 L] matrix H
+     *                  of each frequency bin with a Tikhonov regularization :
+     *                  C = H^H ( H H^H + beta I )^-1, which is the exact inverse for L = 2.
+     *                  The 2x2 inverses are computed in closed form, for all the bins at once
+     *                  (split real and imaginary parts, so that the loops are vectorized).
+     *                  The filters are delayed by half their length to be causal.
+     *                  Design() is meant to be called again whenever the listener moves.
+     */
+    /************************************************************************************/
+    class SOFA_API CrosstalkCancellation
+    {
+    public:
+        CrosstalkCancellation();
+        ~CrosstalkCancellation() {};
+        
+        //==============================================================================
+        void Load(const sofa::File &file,
+                  const std::size_t fftSize = 0,
+                  const unsigned int numThreads = 0);
+        
+        void Design(const double *directions,
+                    const std::size_t numLoudspeakers,
+                    const double regularizationDB = -20.0);
+        
+        //==============================================================================
+        std::size_t GetNumMeasurements() const;
+        std::size_t GetNumLoudspeakers() const;
+        std::size_t GetFilterLength() const;
+        double GetSamplingRate() const;
+        
+        std::size_t GetMeasurement(const std::size_t loudspeaker) const;
+        
+        const double * GetFilter(const std::size_t loudspeaker,
+                                 const std::size_t receiver) const;
+        
+        const std::vector< double > & GetFilters() const;
+        
+    protected:
+        sofa::TransferFunctions spectra;
+        std::vector< double > directions;               ///< [M 3] unit vectors
+        std::size_t numLoudspeakers;
+        
+        std::vector< std::size_t > measurements;        ///< [L] selected measurements
+        std::vector< double > real;                     ///< [2 L numBins] workspace
+        std::vector< double > imag;                     ///< [2 L numBins] workspace
+        std::vector< std::complex< double > > spectrum; ///< numBins workspace
+        std::vector< double > filters;                  ///< [L 2 fftSize]
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( CrosstalkCancellation );
+    };
+    
+}
+
+#endif /* _SOFA_CROSSTALK_CANCELLATION_H__ */
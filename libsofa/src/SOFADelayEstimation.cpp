@@ -0,0 +1,580 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+/************************************************************************************/
+/*!
+ *   @file       SOFADelayEstimation.cpp
+ *   @brief      Estimation of the delays (onsets, ITD) of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFADelayEstimation.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// number of measurements loaded at once, when estimating the delays of a file
+    static const std::size_t kMeasurementsPerBlock = 256;
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns the index of the maximum of a circular cross-correlation,
+     *                  for the lags ]-maxLag maxLag[, refined by parabolic interpolation
+     *  @return         the lag, in (fractional) samples
+     *
+     */
+    /************************************************************************************/
+    static double getPeakLag(const double *correlation,
+                             const std::size_t length,
+                             const std::size_t maxLag)
+    {
+        std::size_t peakIndex = 0;
+        double peak = correlation[0];
+        
+        for( std::size_t n = 1; n < maxLag; n++ )
+        {
+            if( correlation[n] > peak )
+            {
+                peak        = correlation[n];
+                peakIndex   = n;
+            }
+        }
+        
+        for( std::size_t n = length - maxLag + 1; n < length; n++ )
+        {
+            if( correlation[n] > peak )
+            {
+                peak        = correlation[n];
+                peakIndex   = n;
+            }
+        }
+        
+        const double previous   = correlation[ ( peakIndex + length - 1 ) % length ];
+        const double next       = correlation[ ( peakIndex + 1 ) % length ];
+        const double curvature  = previous - 2.0 * peak + next;
+        
+        double lag = static_cast< double >( peakIndex );
+        
+        if( curvature < 0.0 )
+        {
+            lag += 0.5 * ( previous - next ) / curvature;
+        }
+        
+        if( peakIndex >= maxLag )
+        {
+            lag -= static_cast< double >( length );
+        }
+        
+        return lag;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of an estimation method
+ *
+ */
+/************************************************************************************/
+std::string DelayEstimation::GetName(const sofa::DelayEstimation::Method &method)
+{
+    switch( method )
+    {
+        case sofa::DelayEstimation::kThreshold          : return "threshold";
+        case sofa::DelayEstimation::kCrossCorrelation   : return "cross-correlation";
+        case sofa::DelayEstimation::kGroupDelay         : return "group delay";
+            
+        default                                         : SOFA_ASSERT( false ); return "";
+        case sofa::DelayEstimation::kNumMethods         : SOFA_ASSERT( false ); return "";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+DelayEstimation::DelayEstimation()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numEmitters( 0 )
+, samplingRate( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Estimates the delays of all the responses of a FIR or FIRE file
+ *  @param[in]      method : estimation method
+ *  @param[in]      thresholdDB : onset threshold, in dB below the peak of each response
+ *                  (threshold and cross-correlation methods)
+ *  @param[in]      cutoffFrequency : upper frequency (hertz) of the cross-correlation
+ *                  and of the group delay
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ *  @details        The file is read by blocks of measurements
+ */
+/************************************************************************************/
+void DelayEstimation::Estimate(const sofa::File &file,
+                               const sofa::DelayEstimation::Method &method,
+                               const double thresholdDB,
+                               const double cutoffFrequency,
+                               const unsigned int numThreads)
+{
+    const std::size_t M = file.GetNumMeasurements();
+    
+    if( M == 0 )
+    {
+        SOFA_THROW( "the file has no measurement" );
+    }
+    
+    sofa::ImpulseResponses block;
+    
+    for( std::size_t first = 0; first < M; first += sofaLocal::kMeasurementsPerBlock )
+    {
+        block.Load( file, first, sofa::smin( sofaLocal::kMeasurementsPerBlock, M - first ) );
+        
+        if( first == 0 )
+        {
+            numMeasurements = M;
+            numReceivers    = block.GetNumReceivers();
+            numEmitters     = block.GetNumEmitters();
+            samplingRate    = block.GetSamplingRate();
+            
+            delays.assign( M * numReceivers * numEmitters, 0.0 );
+            estimates.assign( M * numReceivers * numEmitters, 0.0 );
+        }
+        
+        estimate( block, first, method, thresholdDB, cutoffFrequency, numThreads );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Estimates the delays of a set of responses
+ *
+ */
+/************************************************************************************/
+void DelayEstimation::Estimate(const sofa::ImpulseResponses &responses,
+                               const sofa::DelayEstimation::Method &method,
+                               const double thresholdDB,
+                               const double cutoffFrequency,
+                               const unsigned int numThreads)
+{
+    numMeasurements = responses.GetNumMeasurements();
+    numReceivers    = responses.GetNumReceivers();
+    numEmitters     = responses.GetNumEmitters();
+    samplingRate    = responses.GetSamplingRate();
+    
+    delays.assign( responses.GetNumResponses(), 0.0 );
+    estimates.assign( responses.GetNumResponses(), 0.0 );
+    
+    estimate( responses, 0, method, thresholdDB, cutoffFrequency, numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Estimates the delays of a block of measurements
+ *  @param[in]      firstMeasurement : index of the first measurement of the block
+ *
+ *  @details        The measurements (and emitters) are spread over the threads; the
+ *                  receivers of a measurement are processed together, since the
+ *                  cross-correlation method compares them
+ */
+/************************************************************************************/
+void DelayEstimation::estimate(const sofa::ImpulseResponses &responses,
+                               const std::size_t firstMeasurement,
+                               const sofa::DelayEstimation::Method &method,
+                               const double thresholdDB,
+                               const double cutoffFrequency,
+                               const unsigned int numThreads)
+{
+    const std::size_t M = responses.GetNumMeasurements();
+    const std::size_t R = responses.GetNumReceivers();
+    const std::size_t E = responses.GetNumEmitters();
+    const std::size_t N = responses.GetNumDataSamples();
+    
+    if( method != kThreshold && method != kCrossCorrelation && method != kGroupDelay )
+    {
+        SOFA_THROW( "invalid estimation method" );
+    }
+    
+    if( M == 0 || R == 0 || N == 0 )
+    {
+        return;
+    }
+    
+    /// zero-padding to 2 N : the correlation is not circular for the lags ]-N N[
+    const std::size_t K = sofa::FFT::GetNextPowerOfTwo( 2 * N );
+    const std::size_t B = K / 2 + 1;
+    
+    const sofa::FFT fft( K );
+    
+    /// highest bin of the cross-correlation and of the group delay
+    const double binWidth = responses.GetSamplingRate() / static_cast< double >( K );
+    const std::size_t cutoffBin = sofa::smax( static_cast< std::size_t >( 1 ),
+                                              sofa::smin( B - 1, static_cast< std::size_t >( cutoffFrequency / binWidth ) ) );
+    
+    const double pi = 3.14159265358979323846;
+    
+    /// squared-cosine taper of the cross-spectrum
+    std::vector< double > taper( cutoffBin + 1 );
+    for( std::size_t k = 0; k <= cutoffBin; k++ )
+    {
+        const double c = std::cos( 0.5 * pi * static_cast< double >( k ) / static_cast< double >( cutoffBin + 1 ) );
+        taper[k] = c * c;
+    }
+    
+    const unsigned int numWorkers = sofa::Threads::GetNumThreads( numThreads );
+    
+    /// one workspace per thread
+    std::vector< std::vector< double > > buffers( numWorkers, std::vector< double >( K ) );
+    std::vector< std::vector< std::complex< double > > > spectra( numWorkers );
+    std::vector< std::vector< double > > onsets( numWorkers, std::vector< double >( R ) );
+    
+    if( method != kThreshold )
+    {
+        for( unsigned int t = 0; t < numWorkers; t++ )
+        {
+            spectra[t].resize( R * B );
+        }
+    }
+    
+    sofa::Threads::ParallelFor( M * E,
+                                [&]( const std::size_t g, const unsigned int threadIndex )
+                                {
+                                    const std::size_t m = g / E;
+                                    const std::size_t e = g % E;
+                                    
+                                    std::vector< double > &buffer = buffers[ threadIndex ];
+                                    std::vector< double > &onset  = onsets[ threadIndex ];
+                                    std::complex< double > *spectrum = ( method != kThreshold ) ? &spectra[ threadIndex ][0] : nullptr;
+                                    
+                                    for( std::size_t r = 0; r < R; r++ )
+                                    {
+                                        const double *response = responses.GetResponse( responses.GetResponseIndex( m, r, e ) );
+                                        
+                                        if( method != kGroupDelay )
+                                        {
+                                            onset[r] = GetOnset( response, N, thresholdDB );
+                                        }
+                                        
+                                        if( method != kThreshold )
+                                        {
+                                            std::copy( response, response + N, buffer.begin() );
+                                            std::fill( buffer.begin() + N, buffer.end(), 0.0 );
+                                            
+                                            fft.ForwardReal( spectrum + r * B, &buffer[0] );
+                                        }
+                                        
+                                        if( method == kGroupDelay )
+                                        {
+                                            onset[r] = GetGroupDelay( spectrum + r * B, K, cutoffBin + 1 );
+                                        }
+                                    }
+                                    
+                                    if( method == kCrossCorrelation )
+                                    {
+                                        /// lags relative to the first receiver; the offset is the mean
+                                        /// difference between the onsets and the lags
+                                        double offset = onset[0];
+                                        
+                                        for( std::size_t r = 1; r < R; r++ )
+                                        {
+                                            /// the cross-spectrum overwrites the spectrum of receiver r
+                                            std::complex< double > *current = spectrum + r * B;
+                                            const std::complex< double > *reference = spectrum;
+                                            
+                                            for( std::size_t k = 0; k <= cutoffBin; k++ )
+                                            {
+                                                current[k] = taper[k] * current[k] * std::conj( reference[k] );
+                                            }
+                                            std::fill( current + cutoffBin + 1, current + B, std::complex< double >( 0.0, 0.0 ) );
+                                            
+                                            fft.InverseReal( &buffer[0], current );
+                                            
+                                            const double lag = sofaLocal::getPeakLag( &buffer[0], K, N );
+                                            
+                                            offset  += onset[r] - lag;
+                                            onset[r] = lag;
+                                        }
+                                        
+                                        offset /= static_cast< double >( R );
+                                        
+                                        for( std::size_t r = 1; r < R; r++ )
+                                        {
+                                            onset[r] = sofa::smax( 0.0, offset + onset[r] );
+                                        }
+                                        onset[0] = sofa::smax( 0.0, offset );
+                                    }
+                                    
+                                    for( std::size_t r = 0; r < R; r++ )
+                                    {
+                                        const std::size_t i = responses.GetResponseIndex( m, r, e );
+                                        const std::size_t j = ( ( firstMeasurement + m ) * numReceivers + r ) * numEmitters + e;
+                                        
+                                        estimates[j]    = onset[r];
+                                        delays[j]       = onset[r] + responses.GetDelay( i );
+                                    }
+                                },
+                                numWorkers );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Moves the estimated delays from the responses to their Data.Delay
+ *  @param[in]      responses : the responses whose delays were estimated
+ *  @param[in]      margin : number of samples kept before the estimated onsets
+ *
+ *  @details        Each response is advanced by the integer part of its estimated delay
+ *                  (minus the margin), and this shift is added to its delay :
+ *                  the responses are unchanged, up to the samples which are dropped
+ */
+/************************************************************************************/
+void DelayEstimation::Apply(sofa::ImpulseResponses &responses,
+                            const std::size_t margin) const
+{
+    if( responses.GetNumMeasurements() != numMeasurements
+       || responses.GetNumReceivers() != numReceivers
+       || responses.GetNumEmitters() != numEmitters )
+    {
+        SOFA_THROW( "the responses do not match the estimated delays" );
+    }
+    
+    const std::size_t N = responses.GetNumDataSamples();
+    
+    for( std::size_t i = 0; i < responses.GetNumResponses(); i++ )
+    {
+        const std::size_t integerDelay = static_cast< std::size_t >( std::floor( estimates[i] ) );
+        
+        if( integerDelay <= margin )
+        {
+            continue;
+        }
+        
+        const std::size_t shift = sofa::smin( integerDelay - margin, N );
+        
+        double *response = responses.GetResponse( i );
+        
+        std::copy( response + shift, response + N, response );
+        std::fill( response + N - shift, response + N, 0.0 );
+        
+        responses.SetDelay( i, responses.GetDelay( i ) + static_cast< double >( shift ) );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a copy of a FIR or FIRE file, where the estimated delays are
+ *                  moved from Data.IR to Data.Delay [M R] (or [M R E])
+ *
+ */
+/************************************************************************************/
+void DelayEstimation::Write(const sofa::File &source,
+                            const std::string &outputPath,
+                            const std::size_t margin) const
+{
+    sofa::ImpulseResponses responses;
+    responses.Load( source );
+    
+    Apply( responses, margin );
+    
+    responses.Write( source, outputPath );
+}
+
+std::size_t DelayEstimation::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+std::size_t DelayEstimation::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t DelayEstimation::GetNumEmitters() const
+{
+    return numEmitters;
+}
+
+double DelayEstimation::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the delay of a response, in samples (Data.Delay included)
+ *
+ */
+/************************************************************************************/
+double DelayEstimation::GetDelay(const std::size_t measurement,
+                                 const std::size_t receiver,
+                                 const std::size_t emitter) const
+{
+    SOFA_ASSERT( measurement < numMeasurements );
+    SOFA_ASSERT( receiver < numReceivers );
+    SOFA_ASSERT( emitter < numEmitters );
+    
+    return delays[ ( measurement * numReceivers + receiver ) * numEmitters + emitter ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns all the delays, as [M R E] (in samples)
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & DelayEstimation::GetDelays() const
+{
+    return delays;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the interaural time difference of a measurement, in seconds :
+ *                  the delay of the second receiver minus the delay of the first one
+ *
+ */
+/************************************************************************************/
+double DelayEstimation::GetInterauralTimeDifference(const std::size_t measurement,
+                                                    const std::size_t emitter) const
+{
+    if( numReceivers < 2 )
+    {
+        SOFA_THROW( "the interaural time difference requires two receivers" );
+    }
+    
+    return ( GetDelay( measurement, 1, emitter ) - GetDelay( measurement, 0, emitter ) ) / samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Estimates the onset of a response, i.e. the first time its magnitude
+ *                  reaches a threshold relative to its peak
+ *  @param[in]      thresholdDB : threshold, in dB below the peak
+ *  @return         the onset, in (fractional) samples
+ *
+ *  @details        The crossing is linearly interpolated between the two samples around it
+ */
+/************************************************************************************/
+double DelayEstimation::GetOnset(const double *input,
+                                 const std::size_t length,
+                                 const double thresholdDB)
+{
+    double peak = 0.0;
+    for( std::size_t i = 0; i < length; i++ )
+    {
+        peak = sofa::smax( peak, sofa::FAbs( input[i] ) );
+    }
+    
+    if( peak == 0.0 )
+    {
+        return 0.0;
+    }
+    
+    const double threshold = peak * std::pow( 10.0, -sofa::FAbs( thresholdDB ) / 20.0 );
+    
+    for( std::size_t i = 0; i < length; i++ )
+    {
+        const double current = sofa::FAbs( input[i] );
+        
+        if( current >= threshold )
+        {
+            if( i == 0 )
+            {
+                return 0.0;
+            }
+            
+            const double previous = sofa::FAbs( input[ i - 1 ] );
+            
+            return static_cast< double >( i - 1 ) + ( threshold - previous ) / ( current - previous );
+        }
+    }
+    
+    return 0.0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Estimates the mean group delay of a response from its spectrum
+ *  @param[in]      spectrum : the bins of the (real) FFT of the response
+ *  @param[in]      fftSize : size of the FFT
+ *  @param[in]      numBins : number of bins used, from DC
+ *  @return         the group delay, in (fractional) samples, not smaller than 0
+ *
+ *  @details        The phase increment between adjacent bins is averaged, weighted by the
+ *                  magnitudes, as the argument of sum( X[k] conj( X[k-1] ) ) :
+ *                  this does not require unwrapping the phase
+ */
+/************************************************************************************/
+double DelayEstimation::GetGroupDelay(const std::complex< double > *spectrum,
+                                      const std::size_t fftSize,
+                                      const std::size_t numBins)
+{
+    const double pi = 3.14159265358979323846;
+    
+    double real = 0.0;
+    double imag = 0.0;
+    
+    for( std::size_t k = 1; k < numBins; k++ )
+    {
+        const std::complex< double > product = spectrum[k] * std::conj( spectrum[ k - 1 ] );
+        real += product.real();
+        imag += product.imag();
+    }
+    
+    if( real == 0.0 && imag == 0.0 )
+    {
+        return 0.0;
+    }
+    
+    const double delay = -std::atan2( imag, real ) * static_cast< double >( fftSize ) / ( 2.0 * pi );
+    
+    return sofa::smax( 0.0, delay );
+}
+
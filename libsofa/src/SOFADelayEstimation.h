@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+/************************************************************************************/
+/*!
+ *   @file       SOFADelayEstimation.h
+ *   @brief      Estimation of the delays (onsets, ITD) of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_DELAY_ESTIMATION_H__
+#define _SOFA_DELAY_ESTIMATION_H__
+
+#include "../src/SOFAImpulseResponses.h"
+#include <complex>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          DelayEstimation
+     *  @brief          Estimates the delay of every response of a set, for files whose
+     *                  Data.Delay is zero and whose delays are contained in Data.IR
+     *
+     *  @details        The delays are estimated for all the measurements at once (in parallel),
+     *                  and stored as [M R E] (in samples, Data.Delay included).
+     *                  With the cross-correlation method, the differences between the receivers
+     *                  of a measurement (e.g. the ITD) are given by the peak of the low-passed
+     *                  cross-correlation with the first receiver, computed by FFT, while the
+     *                  onsets of the receivers only set the common offset.
+     *                  Apply() / Write() move the (integer) estimated delays from Data.IR
+     *                  to Data.Delay.
+     */
+    /************************************************************************************/
+    class SOFA_API DelayEstimation
+    {
+    public:
+        enum Method
+        {
+            kThreshold          = 0,    ///< first sample reaching a threshold relative to the peak
+            kCrossCorrelation   = 1,    ///< cross-correlation with the first receiver
+            kGroupDelay         = 2,    ///< mean group delay below the cutoff frequency
+            
+            kNumMethods         = 3
+        };
+        
+        static std::string GetName(const sofa::DelayEstimation::Method &method);
+        
+    public:
+        DelayEstimation();
+        ~DelayEstimation() {};
+        
+        //==============================================================================
+        void Estimate(const sofa::File &file,
+                      const sofa::DelayEstimation::Method &method = kCrossCorrelation,
+                      const double thresholdDB = -20.0,
+                      const double cutoffFrequency = 1500.0,
+                      const unsigned int numThreads = 0);
+        
+        void Estimate(const sofa::ImpulseResponses &responses,
+                      const sofa::DelayEstimation::Method &method = kCrossCorrelation,
+                      const double thresholdDB = -20.0,
+                      const double cutoffFrequency = 1500.0,
+                      const unsigned int numThreads = 0);
+        
+        void Apply(sofa::ImpulseResponses &responses,
+                   const std::size_t margin = 0) const;
+        
+        void Write(const sofa::File &source,
+                   const std::string &outputPath,
+                   const std::size_t margin = 0) const;
+        
+        //==============================================================================
+        std::size_t GetNumMeasurements() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetNumEmitters() const;
+        double GetSamplingRate() const;
+        
+        double GetDelay(const std::size_t measurement,
+                        const std::size_t receiver,
+                        const std::size_t emitter = 0) const;
+        
+        const std::vector< double > & GetDelays() const;
+        
+        double GetInterauralTimeDifference(const std::size_t measurement,
+                                           const std::size_t emitter = 0) const;
+        
+        //==============================================================================
+        static double GetOnset(const double *input,
+                               const std::size_t length,
+                               const double thresholdDB = -20.0);
+        
+        static double GetGroupDelay(const std::complex< double > *spectrum,
+                                    const std::size_t fftSize,
+                                    const std::size_t numBins);
+        
+    protected:
+        //==============================================================================
+        void estimate(const sofa::ImpulseResponses &responses,
+                      const std::size_t firstMeasurement,
+                      const sofa::DelayEstimation::Method &method,
+                      const double thresholdDB,
+                      const double cutoffFrequency,
+                      const unsigned int numThreads);
+        
+    protected:
+        std::size_t numMeasurements;
+        std::size_t numReceivers;
+        std::size_t numEmitters;
+        double samplingRate;
+        
+        std::vector< double > delays;       ///< [M R E], in samples, Data.Delay included
+        std::vector< double > estimates;    ///< [M R E], in samples, the part contained in Data.IR
+    };
+    
+}
+
+#endif /* _SOFA_DELAY_ESTIMATION_H__ */
+
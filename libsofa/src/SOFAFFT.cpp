@@ -0,0 +1,296 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFFT.cpp
+ *   @brief      Radix-2 fast Fourier transform
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAExceptions.h"
+#include <cmath>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      size : size of the transform; must be a power of two
+ *
+ */
+/************************************************************************************/
+FFT::FFT(const std::size_t size_)
+: size( size_ )
+{
+    if( IsPowerOfTwo( size ) == false || size < 2 )
+    {
+        SOFA_THROW( "the FFT size must be a power of two" );
+    }
+    
+    const double pi = 3.14159265358979323846;
+    
+    twiddles.resize( size / 2 );
+    for( std::size_t k = 0; k < size / 2; k++ )
+    {
+        const double phase = -2.0 * pi * static_cast< double >( k ) / static_cast< double >( size );
+        twiddles[k] = std::complex< double >( std::cos( phase ), std::sin( phase ) );
+    }
+    
+    computeBitReversal( bitReversal, size );
+    computeBitReversal( halfBitReversal, size / 2 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the size of the transform
+ *
+ */
+/************************************************************************************/
+std::size_t FFT::GetSize() const
+{
+    return size;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of bins of the spectrum of a real signal, i.e. size / 2 + 1
+ *
+ */
+/************************************************************************************/
+std::size_t FFT::GetNumBins() const
+{
+    return size / 2 + 1;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the smallest power of two greater or equal to value
+ *
+ */
+/************************************************************************************/
+std::size_t FFT::GetNextPowerOfTwo(const std::size_t value)
+{
+    std::size_t result = 1;
+    while( result < value )
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if value is a power of two
+ *
+ */
+/************************************************************************************/
+bool FFT::IsPowerOfTwo(const std::size_t value)
+{
+    return value > 0 && ( value & ( value - 1 ) ) == 0;
+}
+
+void FFT::computeBitReversal(std::vector< std::size_t > &table,
+                             const std::size_t length)
+{
+    table.resize( length );
+    
+    std::size_t numBits = 0;
+    while( ( static_cast< std::size_t >( 1 ) << numBits ) < length )
+    {
+        numBits++;
+    }
+    
+    for( std::size_t i = 0; i < length; i++ )
+    {
+        std::size_t reversed = 0;
+        for( std::size_t b = 0; b < numBits; b++ )
+        {
+            reversed |= ( ( i >> b ) & 1 ) << ( numBits - 1 - b );
+        }
+        table[i] = reversed;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          In-place iterative radix-2 transform of a given length (size or size / 2)
+ *
+ */
+/************************************************************************************/
+void FFT::transform(std::complex< double > *data,
+                    const std::size_t length,
+                    const std::vector< std::size_t > &table,
+                    const bool inverse) const
+{
+    for( std::size_t i = 0; i < length; i++ )
+    {
+        const std::size_t j = table[i];
+        if( i < j )
+        {
+            std::swap( data[i], data[j] );
+        }
+    }
+    
+    for( std::size_t half = 1; half < length; half <<= 1 )
+    {
+        /// the twiddle table is sampled for the length 'size'
+        const std::size_t stride = size / ( 2 * half );
+        
+        for( std::size_t start = 0; start < length; start += 2 * half )
+        {
+            for( std::size_t k = 0; k < half; k++ )
+            {
+                const std::complex< double > w = ( inverse == true ) ? std::conj( twiddles[ k * stride ] ) : twiddles[ k * stride ];
+                
+                const std::complex< double > a = data[ start + k ];
+                const std::complex< double > b = data[ start + k + half ] * w;
+                
+                data[ start + k ]         = a + b;
+                data[ start + k + half ]  = a - b;
+            }
+        }
+    }
+    
+    if( inverse == true )
+    {
+        const double scale = 1.0 / static_cast< double >( length );
+        for( std::size_t i = 0; i < length; i++ )
+        {
+            data[i] *= scale;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          In-place forward transform of size complex values
+ *
+ */
+/************************************************************************************/
+void FFT::Forward(std::complex< double > *data) const
+{
+    transform( data, size, bitReversal, false );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          In-place inverse transform of size complex values (scaled by 1/size)
+ *
+ */
+/************************************************************************************/
+void FFT::Inverse(std::complex< double > *data) const
+{
+    transform( data, size, bitReversal, true );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Forward transform of a real signal
+ *  @param[out]     spectrum : the size / 2 + 1 first bins of the spectrum
+ *  @param[in]      input : size real values
+ *
+ *  @details        The signal is packed into a complex signal of length size / 2,
+ *                  the spectrum buffer being used as workspace
+ */
+/************************************************************************************/
+void FFT::ForwardReal(std::complex< double > *spectrum,
+                      const double *input) const
+{
+    const std::size_t half = size / 2;
+    
+    for( std::size_t k = 0; k < half; k++ )
+    {
+        spectrum[k] = std::complex< double >( input[ 2 * k ], input[ 2 * k + 1 ] );
+    }
+    
+    transform( spectrum, half, halfBitReversal, false );
+    
+    const std::complex< double > z0 = spectrum[0];
+    spectrum[0]     = std::complex< double >( z0.real() + z0.imag(), 0.0 );
+    spectrum[half]  = std::complex< double >( z0.real() - z0.imag(), 0.0 );
+    
+    /// bins k and half - k are computed together
+    for( std::size_t k = 1; k <= half / 2; k++ )
+    {
+        const std::complex< double > zk = spectrum[k];
+        const std::complex< double > zn = std::conj( spectrum[ half - k ] );
+        
+        const std::complex< double > even = 0.5 * ( zk + zn );
+        const std::complex< double > odd  = std::complex< double >( 0.0, -0.5 ) * ( zk - zn );
+        
+        spectrum[k]           = even + twiddles[k] * odd;
+        spectrum[ half - k ]  = std::conj( even ) + twiddles[ half - k ] * std::conj( odd );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Inverse transform to a real signal (scaled by 1/size)
+ *  @param[out]     output : size real values
+ *  @param[in]      spectrum : the size / 2 + 1 first bins of the spectrum
+ *
+ *  @details        The output buffer is used as workspace, as size / 2 complex values
+ */
+/************************************************************************************/
+void FFT::InverseReal(double *output,
+                      const std::complex< double > *spectrum) const
+{
+    const std::size_t half = size / 2;
+    
+    /// std::complex< double > is layout-compatible with double[2]
+    std::complex< double > *z = reinterpret_cast< std::complex< double > * >( output );
+    
+    for( std::size_t k = 0; k < half; k++ )
+    {
+        const std::complex< double > xk = spectrum[k];
+        const std::complex< double > xn = std::conj( spectrum[ half - k ] );
+        
+        const std::complex< double > even = 0.5 * ( xk + xn );
+        const std::complex< double > odd  = 0.5 * ( xk - xn ) * std::conj( twiddles[k] );
+        
+        z[k] = even + std::complex< double >( 0.0, 1.0 ) * odd;
+    }
+    
+    /// z[k] = x[2k] + i x[2k+1] : the output is already in the natural order
+    transform( z, half, halfBitReversal, true );
+}
@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFFT.h
+ *   @brief      Radix-2 fast Fourier transform
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_FFT_H__
+#define _SOFA_FFT_H__
+
+#include "../src/SOFAPlatform.h"
+#include <complex>
+#include <vector>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          FFT
+     *  @brief          Fast Fourier transform of a power-of-two size
+     *
+     *  @details        The twiddle factors and bit-reversal tables are computed once,
+     *                  in the constructor. The transforms do not allocate memory and
+     *                  do not modify the object, so that one FFT can be shared
+     *                  by several threads, each working on its own buffers.
+     *
+     *                  The forward transform is not scaled, the inverse transform is scaled by 1/size.
+     */
+    /************************************************************************************/
+    class SOFA_API FFT
+    {
+    public:
+        FFT(const std::size_t size);
+        ~FFT() {};
+        
+        std::size_t GetSize() const;
+        std::size_t GetNumBins() const;
+        
+        static std::size_t GetNextPowerOfTwo(const std::size_t value);
+        static bool IsPowerOfTwo(const std::size_t value);
+        
+        //==============================================================================
+        void Forward(std::complex< double > *data) const;
+        void Inverse(std::complex< double > *data) const;
+        
+        void ForwardReal(std::complex< double > *spectrum,
+                         const double *input) const;
+        
+        void InverseReal(double *output,
+                         const std::complex< double > *spectrum) const;
+        
+    protected:
+        //==============================================================================
+        void transform(std::complex< double > *data,
+                       const std::size_t length,
+                       const std::vector< std::size_t > &bitReversal,
+                       const bool inverse) const;
+        
+        static void computeBitReversal(std::vector< std::size_t > &table,
+                                       const std::size_t length);
+        
+    protected:
+        const std::size_t size;
+        std::vector< std::complex< double > > twiddles;     ///< exp( -2 i pi k / size ), k < size / 2
+        std::vector< std::size_t > bitReversal;             ///< for complex transforms of length size
+        std::vector< std::size_t > halfBitReversal;         ///< for complex transforms of length size / 2
+    };
+    
+}
+
+#endif /* _SOFA_FFT_H__ */
@@ -54,9 +54,258 @@ http://www.sofaconventions.org
 #include "../src/SOFAEmitter.h"
 #include "../src/SOFAString.h"
 #include "../src/SOFANcUtils.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
 
 using namespace sofa;
 
+namespace sofaLocal
+{
+    /// approximate size (in bytes) of the quantized blocks read at once
+    static const std::size_t kQuantizedBlockSize = 1024 * 1024;
+    
+    template< typename FloatType, typename IntType >
+    static void readQuantizedDataIR(FloatType *values,
+                                    const netCDF::NcVar &varIR,
+                                    const std::vector< double > &gains,
+                                    const std::vector< std::size_t > &dims,
+                                    const std::size_t firstMeasurement,
+                                    const std::size_t numMeasurements)
+    {
+        const std::size_t N                   = dims.back();
+        const std::size_t rowsPerMeasurement  = gains.size() / numMeasurements;
+        const std::size_t measurementSize     = rowsPerMeasurement * N;
+        const std::size_t blockSize           = sofa::smax( (std::size_t) 1, kQuantizedBlockSize / ( measurementSize * sizeof( IntType ) ) );
+        
+        std::vector< IntType > buffer( sofa::smin( blockSize, numMeasurements ) * measurementSize );
+        
+        std::vector< std::size_t > start( dims.size(), 0 );
+        std::vector< std::size_t > count = dims;
+        
+        for( std::size_t i = 0; i < numMeasurements; i += blockSize )
+        {
+            const std::size_t numInBlock = sofa::smin( blockSize, numMeasurements - i );
+            
+            start[0] = firstMeasurement + i;
+            count[0] = numInBlock;
+            
+            varIR.getVar( start, count, &buffer[0] );
+            
+            for( std::size_t row = 0; row < numInBlock * rowsPerMeasurement; row++ )
+            {
+                const std::size_t index = i * rowsPerMeasurement + row;
+                
+                sofa::Quantization::Dequantize( values + index * N,
+                                                &buffer[row * N],
+                                                static_cast< FloatType >( gains[index] ),
+                                                N );
+            }
+        }
+    }
+    
+    static void readDoubleDataIR(double *values,
+                                 const netCDF::NcVar &varIR,
+                                 const std::vector< std::size_t > &start,
+                                 const std::vector< std::size_t > &count)
+    {
+        varIR.getVar( start, count, values );
+    }
+    
+    /// the conversion to single precision is done here, block by block,
+    /// rather than by netCDF which rejects some values that are not representable
+    static void readDoubleDataIR(float *values,
+                                 const netCDF::NcVar &varIR,
+                                 const std::vector< std::size_t > &start,
+                                 const std::vector< std::size_t > &count)
+    {
+        std::size_t measurementSize = 1;
+        for( std::size_t i = 1; i < count.size(); i++ )
+        {
+            measurementSize *= count[i];
+        }
+        
+        const std::size_t blockSize = sofa::smax( (std::size_t) 1, kQuantizedBlockSize / ( measurementSize * sizeof( double ) ) );
+        
+        std::vector< double > buffer( sofa::smin( blockSize, count[0] ) * measurementSize );
+        
+        std::vector< std::size_t > blockStart = start;
+        std::vector< std::size_t > blockCount = count;
+        
+        for( std::size_t i = 0; i < count[0]; i += blockSize )
+        {
+            blockStart[0] = start[0] + i;
+            blockCount[0] = sofa::smin( blockSize, count[0] - i );
+            
+            varIR.getVar( blockStart, blockCount, &buffer[0] );
+            
+            float *dst = values + i * measurementSize;
+            for( std::size_t j = 0; j < blockCount[0] * measurementSize; j++ )
+            {
+                dst[j] = static_cast< float >( buffer[j] );
+            }
+        }
+    }
+    
+    template< typename FloatType >
+    static bool readDataIR(FloatType *values,
+                           const netCDF::NcVar &varIR,
+                           const netCDF::NcVar &varGain,
+                           const std::size_t firstMeasurement,
+                           const std::size_t numMeasurements)
+    {
+        const sofa::Quantization::Type type_ = sofa::Quantization::GetType( varIR );
+        
+        if( type_ == sofa::Quantization::kNumQuantizations )
+        {
+            return false;
+        }
+        
+        std::vector< std::size_t > dims;
+        sofa::NcUtils::GetDimensions( dims, varIR );
+        
+        if( dims.size() < 3 || firstMeasurement + numMeasurements > dims[0] )
+        {
+            return false;
+        }
+        
+        if( numMeasurements == 0 )
+        {
+            return true;
+        }
+        
+        std::vector< std::size_t > start( dims.size(), 0 );
+        std::vector< std::size_t > count = dims;
+        start[0] = firstMeasurement;
+        count[0] = numMeasurements;
+        
+        if( type_ == sofa::Quantization::kNone )
+        {
+            readDoubleDataIR( values, varIR, start, count );
+            return true;
+        }
+        
+        if( sofa::NcUtils::IsDouble( varGain ) == false
+           || static_cast< std::size_t >( sofa::NcUtils::GetDimensionality( varGain ) ) + 1 != dims.size() )
+        {
+            return false;
+        }
+        
+        std::vector< std::size_t > gainStart( start.begin(), start.end() - 1 );
+        std::vector< std::size_t > gainCount( count.begin(), count.end() - 1 );
+        
+        std::size_t numGains = 1;
+        for( std::size_t i = 0; i < gainCount.size(); i++ )
+        {
+            numGains *= gainCount[i];
+        }
+        
+        std::vector< double > gains( numGains );
+        varGain.getVar( gainStart, gainCount, &gains[0] );
+        
+        if( type_ == sofa::Quantization::kInt16 )
+        {
+            readQuantizedDataIR< FloatType, short >( values, varIR, gains, dims, firstMeasurement, numMeasurements );
+        }
+        else
+        {
+            readQuantizedDataIR< FloatType, int >( values, varIR, gains, dims, firstMeasurement, numMeasurements );
+        }
+        
+        return true;
+    }
+    
+    template< typename IntType >
+    static void readQuantizedDataIRSamples(double *values,
+                                           const netCDF::NcVar &varIR,
+                                           const std::vector< double > &gains,
+                                           const std::vector< std::size_t > &start,
+                                           const std::vector< std::size_t > &count)
+    {
+        const std::size_t numSamples = count.back();
+        
+        std::vector< IntType > buffer( gains.size() * numSamples );
+        varIR.getVar( start, count, &buffer[0] );
+        
+        for( std::size_t row = 0; row < gains.size(); row++ )
+        {
+            sofa::Quantization::Dequantize( values + row * numSamples,
+                                            &buffer[row * numSamples],
+                                            gains[row],
+                                            numSamples );
+        }
+    }
+    
+    static bool readDataIRSamples(double *values,
+                                  const netCDF::NcVar &varIR,
+                                  const netCDF::NcVar &varGain,
+                                  const std::size_t measurement,
+                                  const std::size_t firstSample,
+                                  const std::size_t numSamples)
+    {
+        const sofa::Quantization::Type type_ = sofa::Quantization::GetType( varIR );
+        
+        if( type_ == sofa::Quantization::kNumQuantizations )
+        {
+            return false;
+        }
+        
+        std::vector< std::size_t > dims;
+        sofa::NcUtils::GetDimensions( dims, varIR );
+        
+        if( dims.size() < 3 || measurement >= dims[0] || firstSample + numSamples > dims.back() )
+        {
+            return false;
+        }
+        
+        if( numSamples == 0 )
+        {
+            return true;
+        }
+        
+        std::vector< std::size_t > start( dims.size(), 0 );
+        std::vector< std::size_t > count = dims;
+        start[0]        = measurement;
+        count[0]        = 1;
+        start.back()    = firstSample;
+        count.back()    = numSamples;
+        
+        if( type_ == sofa::Quantization::kNone )
+        {
+            varIR.getVar( start, count, values );
+            return true;
+        }
+        
+        if( sofa::NcUtils::IsDouble( varGain ) == false
+           || static_cast< std::size_t >( sofa::NcUtils::GetDimensionality( varGain ) ) + 1 != dims.size() )
+        {
+            return false;
+        }
+        
+        std::vector< std::size_t > gainStart( start.begin(), start.end() - 1 );
+        std::vector< std::size_t > gainCount( count.begin(), count.end() - 1 );
+        
+        std::size_t numGains = 1;
+        for( std::size_t i = 0; i < gainCount.size(); i++ )
+        {
+            numGains *= gainCount[i];
+        }
+        
+        std::vector< double > gains( numGains );
+        varGain.getVar( gainStart, gainCount, &gains[0] );
+        
+        if( type_ == sofa::Quantization::kInt16 )
+        {
+            readQuantizedDataIRSamples< short >( values, varIR, gains, start, count );
+        }
+        else
+        {
+            readQuantizedDataIRSamples< int >( values, varIR, gains, start, count );
+        }
+        
+        return true;
+    }
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Class constructor
@@ -921,7 +1170,9 @@ bool File::checkTFDataType() const
     
     const netCDF::NcVarAtt attNLongName = sofa::NcUtils::GetAttribute( varN, "LongName" );
     
-    if( sofa::Units::IsValid( attNLongName ) == false )
+    /// N:LongName is a free text (e.g. "frequency"), not a unit
+    if( sofa::NcUtils::IsValid( attNLongName ) == false
+       || sofa::NcUtils::IsChar( attNLongName ) == false )
     {
         SOFA_THROW( "invalid 'LongName'" );
         return false;
@@ -954,7 +1205,7 @@ bool File::checkFirDataType() const
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varIR ) == false )
+    if( checkDataIRType() == false )
     {
         SOFA_THROW( "invalid 'Data.IR' variable" );
         return false;
@@ -1030,6 +1281,50 @@ bool File::checkFirDataType() const
 
 
 
+/************************************************************************************/
+/*!
+ *  @brief          Checks the type of the Data.IR variable :
+ *                  either double (AES69), or quantized (see sofa::Quantization)
+ *                  with a double Data.IRGain variable of the proper dimensions
+ *
+ */
+/************************************************************************************/
+bool File::checkDataIRType() const
+{
+    const netCDF::NcVar varIR = NetCDFFile::getVariable( "Data.IR" );
+    
+    const sofa::Quantization::Type type_ = sofa::Quantization::GetType( varIR );
+    
+    if( type_ == sofa::Quantization::kNone )
+    {
+        return true;
+    }
+    
+    if( type_ == sofa::Quantization::kNumQuantizations )
+    {
+        return false;
+    }
+    
+    const netCDF::NcVar varGain = NetCDFFile::getVariable( sofa::Quantization::GainVariableName );
+    
+    if( sofa::NcUtils::IsDouble( varGain ) == false )
+    {
+        return false;
+    }
+    
+    std::vector< std::size_t > dimsIR;
+    std::vector< std::size_t > dimsGain;
+    sofa::NcUtils::GetDimensions( dimsIR, varIR );
+    sofa::NcUtils::GetDimensions( dimsGain, varGain );
+    
+    if( dimsGain.size() + 1 != dimsIR.size() )
+    {
+        return false;
+    }
+    
+    return std::equal( dimsGain.begin(), dimsGain.end(), dimsIR.begin() );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Checks requirements for DataType 'FIRE'
@@ -1054,7 +1349,7 @@ bool File::checkFireDataType() const
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varIR ) == false )
+    if( checkDataIRType() == false )
     {
         SOFA_THROW( "invalid 'Data.IR' variable" );
         return false;
@@ -1533,6 +1828,101 @@ bool File::GetEmitterView(std::vector< double > &values) const
 }
 
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the SourcePosition values, as [M C] cartesian coordinates
+ *  @param[in]      values : the array is resized to M * 3
+ *  @return         true on success
+ *
+ *  @details        Spherical coordinates are converted to cartesian;
+ *                  a [I C] position is repeated for all the measurements
+ */
+/************************************************************************************/
+bool File::GetSourcePositionAsCartesian(std::vector< double > &values) const
+{
+    return getAsCartesian( values, "SourcePosition" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the ListenerPosition values, as [M C] cartesian coordinates
+ *  @param[in]      values : the array is resized to M * 3
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::GetListenerPositionAsCartesian(std::vector< double > &values) const
+{
+    return getAsCartesian( values, "ListenerPosition" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the ListenerView values, as [M C] cartesian coordinates
+ *  @param[in]      values : the array is resized to M * 3
+ *  @return         true on success
+ *
+ *  @details        Spherical coordinates are converted to cartesian;
+ *                  a [I C] view is repeated for all the measurements
+ */
+/************************************************************************************/
+bool File::GetListenerViewAsCartesian(std::vector< double > &values) const
+{
+    return getAsCartesian( values, "ListenerView" );
+}
+
+bool File::getAsCartesian(std::vector< double > &values, const std::string &variableName) const
+{
+    sofa::Coordinates::Type coordinates;
+    
+    if( getCoordinates( coordinates, variableName ) == false )
+    {
+        return false;
+    }
+    
+    std::vector< std::size_t > dims;
+    GetVariableDimensions( dims, variableName );
+    
+    const long M = GetNumMeasurements();
+    
+    if( dims.size() != 2 || dims[1] != 3 || M <= 0 )
+    {
+        return false;
+    }
+    
+    if( dims[0] != 1 && dims[0] != (std::size_t) M )
+    {
+        return false;
+    }
+    
+    std::vector< double > positions;
+    if( NetCDFFile::GetValues( positions, variableName ) == false )
+    {
+        return false;
+    }
+    
+    values.resize( M * 3 );
+    
+    for( long i = 0; i < M; i++ )
+    {
+        const double *src = &positions[ ( dims[0] == 1 ) ? 0 : 3 * i ];
+        double *dst       = &values[ 3 * i ];
+        
+        if( coordinates == sofa::Coordinates::kSpherical )
+        {
+            sofa::SphericalToCartesian( dst, src );
+        }
+        else
+        {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+        }
+    }
+    
+    return true;
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.IR values
@@ -1550,9 +1940,54 @@ bool File::getDataIR(double *values, const unsigned long dim1, const unsigned lo
     SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
     SOFA_ASSERT( GetVariableDimensionality( "Data.IR" ) == 3 );
     
+    if( GetDataIRQuantization() != sofa::Quantization::kNone )
+    {
+        if( VariableHasDimensions( dim1, dim2, dim3, "Data.IR" ) == false )
+        {
+            return false;
+        }
+        
+        return GetDataIRMeasurements( values, 0, dim1 );
+    }
+    
     return NetCDFFile::GetValues( values, dim1, dim2, dim3, "Data.IR" );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of a FIRE file
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough
+ *  @param[in]      dim1 : first dimension (M)
+ *  @param[in]      dim2 : second dimension (R)
+ *  @param[in]      dim3 : third dimension
+ *  @param[in]      dim4 : fourth dimension
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(double *values,
+                     const unsigned long dim1,
+                     const unsigned long dim2,
+                     const unsigned long dim3,
+                     const unsigned long dim4) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    SOFA_ASSERT( GetVariableDimensionality( "Data.IR" ) == 4 );
+    
+    if( GetDataIRQuantization() != sofa::Quantization::kNone )
+    {
+        if( VariableHasDimensions( dim1, dim2, dim3, dim4, "Data.IR" ) == false )
+        {
+            return false;
+        }
+        
+        return GetDataIRMeasurements( values, 0, dim1 );
+    }
+    
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, dim4, "Data.IR" );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.IR values
@@ -1565,9 +2000,99 @@ bool File::getDataIR(std::vector< double > &values) const
 {
     SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
     
+    if( GetDataIRQuantization() != sofa::Quantization::kNone )
+    {
+        std::vector< std::size_t > dims;
+        GetVariableDimensions( dims, "Data.IR" );
+        
+        std::size_t size = 1;
+        for( std::size_t i = 0; i < dims.size(); i++ )
+        {
+            size *= dims[i];
+        }
+        
+        values.resize( size );
+        
+        return ( size == 0 ) ? true : GetDataIRMeasurements( &values[0], 0, dims[0] );
+    }
+    
     return NetCDFFile::GetValues( values, "Data.IR" );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Returns the storage of the Data.IR variable
+ *                  (sofa::Quantization::kNone for the standard double layout)
+ *
+ */
+/************************************************************************************/
+sofa::Quantization::Type File::GetDataIRQuantization() const
+{
+    const netCDF::NcVar varIR = NetCDFFile::getVariable( "Data.IR" );
+    
+    return sofa::Quantization::GetType( varIR );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of consecutive measurements
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e.
+ *                  numMeasurements x R x N (FIR) or numMeasurements x R x E x N (FIRE)
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ *  @details        Quantized responses are dequantized on the fly, block by block,
+ *                  so that this can be used to stream large files
+ */
+/************************************************************************************/
+bool File::GetDataIRMeasurements(double *values,
+                                 const std::size_t firstMeasurement,
+                                 const std::size_t numMeasurements) const
+{
+    const netCDF::NcVar varIR   = NetCDFFile::getVariable( "Data.IR" );
+    const netCDF::NcVar varGain = NetCDFFile::getVariable( sofa::Quantization::GainVariableName );
+    
+    return sofaLocal::readDataIR( values, varIR, varGain, firstMeasurement, numMeasurements );
+}
+
+bool File::GetDataIRMeasurements(float *values,
+                                 const std::size_t firstMeasurement,
+                                 const std::size_t numMeasurements) const
+{
+    const netCDF::NcVar varIR   = NetCDFFile::getVariable( "Data.IR" );
+    const netCDF::NcVar varGain = NetCDFFile::getVariable( sofa::Quantization::GainVariableName );
+    
+    return sofaLocal::readDataIR( values, varIR, varGain, firstMeasurement, numMeasurements );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a range of samples of the Data.IR values of one measurement
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e.
+ *                  R x numSamples (FIR) or R x E x numSamples (FIRE)
+ *  @param[in]      measurement : index of the measurement
+ *  @param[in]      firstSample : index of the first sample to read
+ *  @param[in]      numSamples : number of samples to read
+ *  @return         true on success
+ *
+ *  @details        This is meant for very long responses (e.g. room responses
+ *                  of a long capture session) which do not fit in memory
+ */
+/************************************************************************************/
+bool File::GetDataIRSamples(double *values,
+                            const std::size_t measurement,
+                            const std::size_t firstSample,
+                            const std::size_t numSamples) const
+{
+    const netCDF::NcVar varIR   = NetCDFFile::getVariable( "Data.IR" );
+    const netCDF::NcVar varGain = NetCDFFile::getVariable( sofa::Quantization::GainVariableName );
+    
+    return sofaLocal::readDataIRSamples( values, varIR, varGain, measurement, firstSample, numSamples );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.Delay values
@@ -53,6 +53,7 @@ http://www.sofaconventions.org
 #include "../src/SOFAAttributes.h"
 #include "../src/SOFACoordinates.h"
 #include "../src/SOFAUnits.h"
+#include "../src/SOFAQuantization.h"
 
 namespace sofa
 {
@@ -161,6 +162,27 @@ namespace sofa
         bool GetEmitterUp(std::vector< double > &values) const;
         bool GetEmitterView(std::vector< double > &values) const;
         
+        //==============================================================================
+        bool GetSourcePositionAsCartesian(std::vector< double > &values) const;
+        bool GetListenerPositionAsCartesian(std::vector< double > &values) const;
+        bool GetListenerViewAsCartesian(std::vector< double > &values) const;
+        
+        //==============================================================================
+        sofa::Quantization::Type GetDataIRQuantization() const;
+        
+        bool GetDataIRMeasurements(double *values,
+                                   const std::size_t firstMeasurement,
+                                   const std::size_t numMeasurements) const;
+        
+        bool GetDataIRMeasurements(float *values,
+                                   const std::size_t firstMeasurement,
+                                   const std::size_t numMeasurements) const;
+        
+        bool GetDataIRSamples(double *values,
+                              const std::size_t measurement,
+                              const std::size_t firstSample,
+                              const std::size_t numSamples) const;
+        
     protected:
         //==============================================================================
         bool hasSOFAConvention() const;
@@ -175,16 +197,19 @@ namespace sofa
         bool checkDataVariable() const;
         bool checkFirDataType() const;
         bool checkFireDataType() const;
+        bool checkDataIRType() const;
         bool checkTFDataType() const;
         bool checkSOSDataType() const;
         
         bool getCoordinates(sofa::Coordinates::Type &coordinates, const std::string &variableName) const;
         bool getUnits(sofa::Units::Type &units, const std::string &variableName) const;
         bool get(sofa::Coordinates::Type &coordinates, sofa::Units::Type &units, const std::string &variableName) const;
+        bool getAsCartesian(std::vector< double > &values, const std::string &variableName) const;
         
         //==============================================================================
         bool getDataIR(std::vector< double > &values) const;
         bool getDataIR(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool getDataIR(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3, const unsigned long dim4) const;
         
         //==============================================================================
         bool getDataDelay(double *values, const unsigned long dim1, const unsigned long dim2) const;
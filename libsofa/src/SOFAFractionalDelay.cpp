@@ -0,0 +1,517 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFractionalDelay.cpp
+ *   @brief      Multichannel modulated fractional delay lines
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAFractionalDelay.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// number of tabulated fractional positions of the windowed sinc
+    static const std::size_t kNumSincPhases = 512;
+    
+    /// maximum order of the Lagrange filters / number of taps of the windowed sinc
+    static const std::size_t kMaxLagrangeOrder  = 31;
+    static const std::size_t kMaxSincTaps       = 256;
+    
+    static std::size_t getOrder(const sofa::FractionalDelay::Interpolation &interpolation,
+                                const std::size_t order)
+    {
+        switch( interpolation )
+        {
+            case sofa::FractionalDelay::kLagrange :
+                if( order % 2 == 0 || order > kMaxLagrangeOrder )
+                {
+                    SOFA_THROW( "the order of the Lagrange interpolation must be odd, and not greater than 31" );
+                }
+                return order;
+                
+            case sofa::FractionalDelay::kThiran :
+                /// the allpass is always first order
+                return 1;
+                
+            case sofa::FractionalDelay::kWindowedSinc :
+                if( order % 2 != 0 || order < 4 || order > kMaxSincTaps )
+                {
+                    SOFA_THROW( "the number of taps of the windowed sinc must be even, in [4 256]" );
+                }
+                return order;
+                
+            default :
+                SOFA_THROW( "invalid interpolation" );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of an interpolation method
+ *
+ */
+/************************************************************************************/
+std::string FractionalDelay::GetName(const sofa::FractionalDelay::Interpolation &interpolation)
+{
+    switch( interpolation )
+    {
+        case sofa::FractionalDelay::kLagrange           : return "Lagrange";
+        case sofa::FractionalDelay::kThiran             : return "Thiran";
+        case sofa::FractionalDelay::kWindowedSinc       : return "windowed sinc";
+            
+        default                                         : SOFA_ASSERT( false ); return "";
+        case sofa::FractionalDelay::kNumInterpolations  : SOFA_ASSERT( false ); return "";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      numChannels : number of delay lines
+ *  @param[in]      blockSize : number of samples processed by each call to Process()
+ *  @param[in]      maxDelay : maximum delay, in samples
+ *  @param[in]      interpolation : interpolation method
+ *  @param[in]      order : order of the Lagrange filters (odd), or number of taps
+ *                  of the windowed sinc (even); ignored for the Thiran allpass (first order)
+ *
+ *  @details        The delays are clamped to [GetMinimumDelay() maxDelay] : the filters
+ *                  are centered on the delayed sample, so that the smallest delay is
+ *                  (order - 1) / 2 for Lagrange, 0.5 for Thiran, and taps / 2 - 1 for the sinc
+ */
+/************************************************************************************/
+FractionalDelay::FractionalDelay(const std::size_t numChannels_,
+                                 const std::size_t blockSize_,
+                                 const std::size_t maxDelay_,
+                                 const sofa::FractionalDelay::Interpolation &interpolation_,
+                                 const std::size_t order_)
+: numChannels( numChannels_ )
+, blockSize( blockSize_ )
+, maxDelay( maxDelay_ )
+, interpolation( interpolation_ )
+, order( sofaLocal::getOrder( interpolation_, order_ ) )
+{
+    if( numChannels == 0 || blockSize == 0 )
+    {
+        SOFA_THROW( "invalid number of channels or block size" );
+    }
+    
+    switch( interpolation )
+    {
+        case kLagrange :
+            numTaps     = order + 1;
+            minDelay    = 0.5 * static_cast< double >( order - 1 );
+            break;
+            
+        case kThiran :
+            numTaps     = 2;
+            minDelay    = 0.5;
+            break;
+            
+        case kWindowedSinc :
+        default :
+            numTaps     = order;
+            minDelay    = 0.5 * static_cast< double >( order ) - 1.0;
+            break;
+    }
+    
+    if( static_cast< double >( maxDelay ) < minDelay )
+    {
+        SOFA_THROW( "the maximum delay is smaller than the minimum delay of the interpolation" );
+    }
+    
+    historyLength = maxDelay + numTaps;
+    
+    lines.assign( numChannels * ( historyLength + blockSize ), 0.0 );
+    currentDelays.assign( numChannels, minDelay );
+    targetDelays.assign( numChannels, minDelay );
+    states.assign( numChannels, 0.0 );
+    coefficients.assign( numTaps, 0.0 );
+    
+    if( interpolation == kLagrange )
+    {
+        /// 1 / prod_{j != k} ( k - j )
+        lagrangeWeights.resize( numTaps );
+        for( std::size_t k = 0; k < numTaps; k++ )
+        {
+            double product = 1.0;
+            for( std::size_t j = 0; j < numTaps; j++ )
+            {
+                if( j != k )
+                {
+                    product *= static_cast< double >( k ) - static_cast< double >( j );
+                }
+            }
+            lagrangeWeights[k] = 1.0 / product;
+        }
+    }
+    
+    if( interpolation == kWindowedSinc )
+    {
+        const double pi = 3.14159265358979323846;
+        const double T = static_cast< double >( numTaps );
+        
+        sincTable.resize( ( sofaLocal::kNumSincPhases + 1 ) * numTaps );
+        
+        for( std::size_t p = 0; p <= sofaLocal::kNumSincPhases; p++ )
+        {
+            /// center of the sinc, relative to the first tap
+            const double center = minDelay + static_cast< double >( p ) / static_cast< double >( sofaLocal::kNumSincPhases );
+            
+            double *phase = &sincTable[ p * numTaps ];
+            double sum = 0.0;
+            
+            for( std::size_t k = 0; k < numTaps; k++ )
+            {
+                const double t = static_cast< double >( k ) - center;
+                
+                const double sinc   = ( t == 0.0 ) ? 1.0 : std::sin( pi * t ) / ( pi * t );
+                const double window = 0.42 + 0.5 * std::cos( 2.0 * pi * t / T ) + 0.08 * std::cos( 4.0 * pi * t / T );
+                
+                /// reverse order : the taps are applied to increasing addresses
+                phase[ numTaps - 1 - k ] = sinc * window;
+                sum += sinc * window;
+            }
+            
+            /// unit gain at DC
+            for( std::size_t k = 0; k < numTaps; k++ )
+            {
+                phase[k] /= sum;
+            }
+        }
+    }
+}
+
+std::size_t FractionalDelay::GetNumChannels() const
+{
+    return numChannels;
+}
+
+std::size_t FractionalDelay::GetBlockSize() const
+{
+    return blockSize;
+}
+
+std::size_t FractionalDelay::GetOrder() const
+{
+    return order;
+}
+
+sofa::FractionalDelay::Interpolation FractionalDelay::GetInterpolation() const
+{
+    return interpolation;
+}
+
+double FractionalDelay::GetMinimumDelay() const
+{
+    return minDelay;
+}
+
+double FractionalDelay::GetMaximumDelay() const
+{
+    return static_cast< double >( maxDelay );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the delay of a channel at the end of the next block
+ *  @param[in]      delay : delay, in samples
+ *  @param[in]      ramp : if false, the delay is changed immediately (e.g. for the first block)
+ *
+ */
+/************************************************************************************/
+void FractionalDelay::SetDelay(const std::size_t channel,
+                               const double delay,
+                               const bool ramp)
+{
+    SOFA_ASSERT( channel < numChannels );
+    
+    const double clamped = sofa::smax( minDelay, sofa::smin( static_cast< double >( maxDelay ), delay ) );
+    
+    targetDelays[ channel ] = clamped;
+    
+    if( ramp == false )
+    {
+        currentDelays[ channel ] = clamped;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the delay of a channel as the weighted mean of several delays,
+ *                  e.g. the Data.Delay of the measurements surrounding a direction
+ *                  (see OrientationIndex::FindBracketing)
+ *
+ */
+/************************************************************************************/
+void FractionalDelay::SetDelay(const std::size_t channel,
+                               const double *delays,
+                               const double *weights,
+                               const std::size_t numDelays,
+                               const bool ramp)
+{
+    double sum          = 0.0;
+    double sumWeights   = 0.0;
+    
+    for( std::size_t i = 0; i < numDelays; i++ )
+    {
+        sum         += weights[i] * delays[i];
+        sumWeights  += weights[i];
+    }
+    
+    SOFA_ASSERT( sumWeights > 0.0 );
+    
+    SetDelay( channel, ( sumWeights > 0.0 ) ? sum / sumWeights : targetDelays[ channel ], ramp );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the delays of all the channels (numChannels values, in samples)
+ *
+ */
+/************************************************************************************/
+void FractionalDelay::SetDelays(const double *delays,
+                                const bool ramp)
+{
+    for( std::size_t c = 0; c < numChannels; c++ )
+    {
+        SetDelay( c, delays[c], ramp );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the delay of a channel at the end of the next block
+ *
+ */
+/************************************************************************************/
+double FractionalDelay::GetDelay(const std::size_t channel) const
+{
+    SOFA_ASSERT( channel < numChannels );
+    
+    return targetDelays[ channel ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Processes one block of blockSize samples of all the channels
+ *  @param[out]     outputs : numChannels output buffers
+ *  @param[in]      inputs : numChannels input buffers (which may be the output buffers)
+ *
+ */
+/************************************************************************************/
+void FractionalDelay::Process(double * const *outputs,
+                              const double * const *inputs)
+{
+    const std::size_t lineLength = historyLength + blockSize;
+    
+    for( std::size_t c = 0; c < numChannels; c++ )
+    {
+        double *line = &lines[ c * lineLength ];
+        
+        std::copy( inputs[c], inputs[c] + blockSize, line + historyLength );
+        
+        /// linear ramp from the current delay to the target
+        const double increment  = ( targetDelays[c] - currentDelays[c] ) / static_cast< double >( blockSize );
+        const double startDelay = currentDelays[c] + increment;
+        
+        switch( interpolation )
+        {
+            case kLagrange      : processLagrange( outputs[c], line, startDelay, increment );               break;
+            case kThiran        : processThiran( outputs[c], line, startDelay, increment, states[c] );      break;
+            case kWindowedSinc  : processWindowedSinc( outputs[c], line, startDelay, increment );           break;
+            default             : SOFA_ASSERT( false );                                                     break;
+        }
+        
+        /// keeps the last historyLength samples
+        std::copy( line + blockSize, line + lineLength, line );
+        
+        currentDelays[c] = targetDelays[c];
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the delay lines; the delays jump to their targets
+ *
+ */
+/************************************************************************************/
+void FractionalDelay::Reset()
+{
+    std::fill( lines.begin(), lines.end(), 0.0 );
+    std::fill( states.begin(), states.end(), 0.0 );
+    
+    currentDelays = targetDelays;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Lagrange interpolation : the coefficients are computed for each sample
+ *  @param[in]      history : the delay line, whose sample historyLength is the first
+ *                  sample of the block
+ *
+ */
+/************************************************************************************/
+void FractionalDelay::processLagrange(double *output,
+                                      const double *history,
+                                      const double startDelay,
+                                      const double increment)
+{
+    const std::size_t offset = ( order - 1 ) / 2;
+    double *h = &coefficients[0];
+    
+    for( std::size_t n = 0; n < blockSize; n++ )
+    {
+        const double delay = startDelay + increment * static_cast< double >( n );
+        
+        /// delay = integerDelay + mu, with mu in [offset offset+1[
+        const std::size_t integerDelay = static_cast< std::size_t >( std::floor( delay ) ) - offset;
+        const double mu = delay - static_cast< double >( integerDelay );
+        
+        /// h[k] = prod_{j != k} ( mu - j ) / ( k - j ), with prefix and suffix products;
+        /// stored in reverse order
+        double prefix = 1.0;
+        for( std::size_t k = 0; k < numTaps; k++ )
+        {
+            h[ order - k ] = prefix;
+            prefix *= mu - static_cast< double >( k );
+        }
+        
+        double suffix = 1.0;
+        for( std::size_t k = numTaps; k-- > 0; )
+        {
+            h[ order - k ] *= suffix * lagrangeWeights[k];
+            suffix *= mu - static_cast< double >( k );
+        }
+        
+        const double *x = history + historyLength + n - integerDelay - order;
+        
+        double sum = 0.0;
+        for( std::size_t k = 0; k < numTaps; k++ )
+        {
+            sum += h[k] * x[k];
+        }
+        output[n] = sum;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          First-order Thiran allpass interpolation
+ *  @param[in,out]  state : the last output sample of the allpass
+ *
+ */
+/************************************************************************************/
+void FractionalDelay::processThiran(double *output,
+                                    const double *history,
+                                    const double startDelay,
+                                    const double increment,
+                                    double &state)
+{
+    double previous = state;
+    
+    for( std::size_t n = 0; n < blockSize; n++ )
+    {
+        const double delay = startDelay + increment * static_cast< double >( n );
+        
+        /// delay = integerDelay + mu, with mu in [0.5 1.5[
+        const std::size_t integerDelay = static_cast< std::size_t >( std::floor( delay - 0.5 ) );
+        const double mu = delay - static_cast< double >( integerDelay );
+        const double a  = ( 1.0 - mu ) / ( 1.0 + mu );
+        
+        const double *x = history + historyLength + n - integerDelay;
+        
+        previous = a * x[0] + x[-1] - a * previous;
+        output[n] = previous;
+    }
+    
+    state = previous;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Windowed-sinc interpolation : the coefficients are interpolated
+ *                  between the two nearest tabulated fractional positions
+ *
+ */
+/************************************************************************************/
+void FractionalDelay::processWindowedSinc(double *output,
+                                          const double *history,
+                                          const double startDelay,
+                                          const double increment)
+{
+    const std::size_t offset = numTaps / 2 - 1;
+    const double numPhases = static_cast< double >( sofaLocal::kNumSincPhases );
+    
+    for( std::size_t n = 0; n < blockSize; n++ )
+    {
+        const double delay = startDelay + increment * static_cast< double >( n );
+        
+        const double floorDelay = std::floor( delay );
+        const std::size_t integerDelay = static_cast< std::size_t >( floorDelay ) - offset;
+        
+        const double position = ( delay - floorDelay ) * numPhases;
+        const std::size_t phase = sofa::smin( static_cast< std::size_t >( position ), sofaLocal::kNumSincPhases - 1 );
+        const double alpha = position - static_cast< double >( phase );
+        
+        const double *h0 = &sincTable[ phase * numTaps ];
+        const double *h1 = h0 + numTaps;
+        
+        const double *x = history + historyLength + n - integerDelay - ( numTaps - 1 );
+        
+        double sum0 = 0.0;
+        double sum1 = 0.0;
+        for( std::size_t k = 0; k < numTaps; k++ )
+        {
+            sum0 += h0[k] * x[k];
+            sum1 += h1[k] * x[k];
+        }
+        output[n] = sum0 + alpha * ( sum1 - sum0 );
+    }
+}
+
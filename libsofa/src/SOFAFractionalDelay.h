@@ -0,0 +1,174 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFractionalDelay.h
+ *   @brief      Multichannel modulated fractional delay lines
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_FRACTIONAL_DELAY_H__
+#define _SOFA_FRACTIONAL_DELAY_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          FractionalDelay
+     *  @brief          Applies time-varying fractional delays (e.g. the Data.Delay of
+     *                  minimum-phase responses) to several channels, block by block
+     *
+     *  @details        Each channel has a target delay (in samples) for the end of the next
+     *                  block; within a block, the delay moves linearly from the previous target
+     *                  to the new one, so that the modulation is sample-accurate and
+     *                  free of zipper noise.
+     *                  The interpolation is either a Lagrange filter (odd order), a first-order
+     *                  Thiran allpass (suited to slowly varying delays), or a Blackman-windowed
+     *                  sinc (even number of taps, tabulated for 512 fractional positions).
+     *                  A delay line keeps the input samples contiguous, so that each output
+     *                  sample is a contiguous dot product.
+     *                  All the buffers are allocated by the constructor : setting the delays
+     *                  and processing never allocate memory.
+     *                  An object must not be shared between threads.
+     */
+    /************************************************************************************/
+    class SOFA_API FractionalDelay
+    {
+    public:
+        enum Interpolation
+        {
+            kLagrange           = 0,
+            kThiran             = 1,
+            kWindowedSinc       = 2,
+            
+            kNumInterpolations  = 3
+        };
+        
+        static std::string GetName(const sofa::FractionalDelay::Interpolation &interpolation);
+        
+    public:
+        FractionalDelay(const std::size_t numChannels,
+                        const std::size_t blockSize,
+                        const std::size_t maxDelay,
+                        const sofa::FractionalDelay::Interpolation &interpolation = kLagrange,
+                        const std::size_t order = 3);
+        
+        ~FractionalDelay() {};
+        
+        std::size_t GetNumChannels() const;
+        std::size_t GetBlockSize() const;
+        std::size_t GetOrder() const;
+        sofa::FractionalDelay::Interpolation GetInterpolation() const;
+        
+        double GetMinimumDelay() const;
+        double GetMaximumDelay() const;
+        
+        //==============================================================================
+        void SetDelay(const std::size_t channel,
+                      const double delay,
+                      const bool ramp = true);
+        
+        void SetDelay(const std::size_t channel,
+                      const double *delays,
+                      const double *weights,
+                      const std::size_t numDelays,
+                      const bool ramp = true);
+        
+        void SetDelays(const double *delays,
+                       const bool ramp = true);
+        
+        double GetDelay(const std::size_t channel) const;
+        
+        //==============================================================================
+        void Process(double * const *outputs,
+                     const double * const *inputs);
+        
+        void Reset();
+        
+    protected:
+        //==============================================================================
+        void processLagrange(double *output,
+                             const double *history,
+                             const double startDelay,
+                             const double increment);
+        
+        void processThiran(double *output,
+                           const double *history,
+                           const double startDelay,
+                           const double increment,
+                           double &state);
+        
+        void processWindowedSinc(double *output,
+                                 const double *history,
+                                 const double startDelay,
+                                 const double increment);
+        
+    protected:
+        const std::size_t numChannels;
+        const std::size_t blockSize;
+        const std::size_t maxDelay;
+        const sofa::FractionalDelay::Interpolation interpolation;
+        const std::size_t order;
+        std::size_t numTaps;
+        std::size_t historyLength;                  ///< number of past samples kept before each block
+        double minDelay;
+        
+        std::vector< double > lines;                ///< [numChannels (historyLength + blockSize)]
+        std::vector< double > currentDelays;        ///< numChannels, the delays at the end of the last block
+        std::vector< double > targetDelays;         ///< numChannels, the delays at the end of the next block
+        std::vector< double > states;               ///< numChannels, output memory of the Thiran allpass
+        std::vector< double > coefficients;         ///< numTaps, in reverse order
+        std::vector< double > lagrangeWeights;      ///< numTaps, inverse denominators of the Lagrange coefficients
+        std::vector< double > sincTable;            ///< [(numPhases + 1) numTaps], in reverse order
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( FractionalDelay );
+    };
+    
+}
+
+#endif /* _SOFA_FRACTIONAL_DELAY_H__ */
+
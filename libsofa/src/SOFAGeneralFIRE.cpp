@@ -166,7 +166,7 @@ bool GeneralFIRE::GetDataIR(double *values,
 {
     /// Data.IR is [ M R N E ]
     
-    return NetCDFFile::GetValues( values, dim1, dim2, dim3, dim4, "Data.IR" );
+    return sofa::File::getDataIR( values, dim1, dim2, dim3, dim4 );
 }
 
 
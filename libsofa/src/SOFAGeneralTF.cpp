@@ -118,3 +118,312 @@ bool GeneralTF::IsValid() const
     return true;
 }
 
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the frequencies of the N axis (variable 'N')
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetFrequencies(std::vector< double > &values) const
+{
+    SOFA_ASSERT( HasVariable( "N" ) == true );
+    
+    return NetCDFFile::GetValues( values, "N" );
+}
+
+bool GeneralTF::GetFrequencies(double *values, const unsigned long dim1) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( "N" );
+    
+    if( sofa::NcUtils::IsValid( var ) == false
+       || sofa::NcUtils::IsDouble( var ) == false
+       || sofa::NcUtils::HasDimension( dim1, var ) == false )
+    {
+        return false;
+    }
+    
+    var.getVar( values );
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the units of the N axis
+ *  @return         true on success; false if N or its Units attribute is missing,
+ *                  or if the units are unknown
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetFrequencyUnits(sofa::Units::Type &units) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( "N" );
+    
+    if( sofa::NcUtils::IsValid( var ) == false )
+    {
+        return false;
+    }
+    
+    const netCDF::NcVarAtt attNUnits    = sofa::NcUtils::GetAttribute( var, "Units" );
+    
+    if( sofa::Units::IsValid( attNUnits ) == false )
+    {
+        units = sofa::Units::kNumUnitsTypes;
+        return false;
+    }
+    
+    const std::string unitsName         = sofa::NcUtils::GetAttributeValueAsString( attNUnits );
+    
+    units = sofa::Units::GetType( unitsName );
+    
+    return ( units != sofa::Units::kNumUnitsTypes );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the N axis holds the bins of a real FFT, i.e.
+ *                  f[k] = k * samplingRate / fftSize for k = 0 ... fftSize / 2,
+ *                  fftSize being a power of 2
+ *  @param[out]     fftSize : size of the FFT (2 * (N - 1))
+ *  @param[out]     samplingRate : sampling rate, in hertz (2 * f[N-1])
+ *
+ *  @details        In that case, each spectrum can be used as it is by a
+ *                  frequency-domain convolution of that FFT size, without going back
+ *                  to the time domain.
+ */
+/************************************************************************************/
+bool GeneralTF::IsFFTFrequencyAxis(std::size_t &fftSize, double &samplingRate) const
+{
+    fftSize         = 0;
+    samplingRate    = 0.0;
+    
+    std::vector< double > frequencies;
+    
+    if( GetFrequencies( frequencies ) == false || frequencies.size() < 2 )
+    {
+        return false;
+    }
+    
+    const std::size_t N     = frequencies.size();
+    const std::size_t size  = 2 * ( N - 1 );
+    
+    /// power of 2
+    if( ( size & ( size - 1 ) ) != 0 )
+    {
+        return false;
+    }
+    
+    const double nyquist    = frequencies[ N - 1 ];
+    const double step       = nyquist / static_cast< double >( N - 1 );
+    
+    if( nyquist <= 0.0 )
+    {
+        return false;
+    }
+    
+    for( std::size_t k = 0; k < N; k++ )
+    {
+        if( sofa::FAbs( frequencies[k] - k * step ) > 1e-6 * step )
+        {
+            return false;
+        }
+    }
+    
+    fftSize         = size;
+    samplingRate    = 2.0 * nyquist;
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Real values
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataReal(std::vector< double > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.Real" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.Real" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Imag values
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataImag(std::vector< double > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.Imag" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.Imag" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the transfer functions of a range of measurements,
+ *                  for all receivers and all frequency bins
+ *  @param[in]      real : [numMeasurements R N] array, allocated large enough
+ *  @param[in]      imag : [numMeasurements R N] array, allocated large enough
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataTF(double *real,
+                          double *imag,
+                          const std::size_t firstMeasurement,
+                          const std::size_t numMeasurements) const
+{
+    return GetDataTF( real, imag,
+                      firstMeasurement, numMeasurements,
+                      0, GetNumReceivers(),
+                      0, GetNumDataSamples() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the transfer functions of a range of measurements,
+ *                  for all receivers and all frequency bins, as interleaved complex values
+ *  @param[in]      values : [numMeasurements R N] array, allocated large enough
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataTF(std::complex< double > *values,
+                          const std::size_t firstMeasurement,
+                          const std::size_t numMeasurements) const
+{
+    return GetDataTF( values,
+                      firstMeasurement, numMeasurements,
+                      0, GetNumReceivers(),
+                      0, GetNumDataSamples() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the transfer functions
+ *  @param[in]      real : [numMeasurements numReceivers numBins] array, allocated large enough
+ *  @param[in]      imag : [numMeasurements numReceivers numBins] array, allocated large enough
+ *  @param[in]      firstMeasurement, numMeasurements : range along M
+ *  @param[in]      firstReceiver, numReceivers : range along R
+ *  @param[in]      firstBin, numBins : range along N
+ *  @return         true on success, false if the hyperslab is out of range
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataTF(double *real,
+                          double *imag,
+                          const std::size_t firstMeasurement,
+                          const std::size_t numMeasurements,
+                          const std::size_t firstReceiver,
+                          const std::size_t numReceivers,
+                          const std::size_t firstBin,
+                          const std::size_t numBins) const
+{
+    const std::size_t M = GetNumMeasurements();
+    const std::size_t R = GetNumReceivers();
+    const std::size_t N = GetNumDataSamples();
+    
+    if( firstMeasurement + numMeasurements > M
+       || firstReceiver + numReceivers > R
+       || firstBin + numBins > N )
+    {
+        return false;
+    }
+    
+    if( numMeasurements == 0 || numReceivers == 0 || numBins == 0 )
+    {
+        return true;
+    }
+    
+    const netCDF::NcVar varReal = NetCDFFile::getVariable( "Data.Real" );
+    const netCDF::NcVar varImag = NetCDFFile::getVariable( "Data.Imag" );
+    
+    std::vector< std::size_t > start( 3 );
+    start[0] = firstMeasurement;
+    start[1] = firstReceiver;
+    start[2] = firstBin;
+    
+    std::vector< std::size_t > count( 3 );
+    count[0] = numMeasurements;
+    count[1] = numReceivers;
+    count[2] = numBins;
+    
+    varReal.getVar( start, count, real );
+    varImag.getVar( start, count, imag );
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the transfer functions, as interleaved complex values
+ *  @param[in]      values : [numMeasurements numReceivers numBins] array, allocated large enough
+ *  @return         true on success, false if the hyperslab is out of range
+ *
+ *  @details        Data.Real and Data.Imag are read directly at their place in the
+ *                  interleaved array (netCDF mapped access), without intermediate buffer
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataTF(std::complex< double > *values,
+                          const std::size_t firstMeasurement,
+                          const std::size_t numMeasurements,
+                          const std::size_t firstReceiver,
+                          const std::size_t numReceivers,
+                          const std::size_t firstBin,
+                          const std::size_t numBins) const
+{
+    const std::size_t M = GetNumMeasurements();
+    const std::size_t R = GetNumReceivers();
+    const std::size_t N = GetNumDataSamples();
+    
+    if( firstMeasurement + numMeasurements > M
+       || firstReceiver + numReceivers > R
+       || firstBin + numBins > N )
+    {
+        return false;
+    }
+    
+    if( numMeasurements == 0 || numReceivers == 0 || numBins == 0 )
+    {
+        return true;
+    }
+    
+    const netCDF::NcVar varReal = NetCDFFile::getVariable( "Data.Real" );
+    const netCDF::NcVar varImag = NetCDFFile::getVariable( "Data.Imag" );
+    
+    std::vector< std::size_t > start( 3 );
+    start[0] = firstMeasurement;
+    start[1] = firstReceiver;
+    start[2] = firstBin;
+    
+    std::vector< std::size_t > count( 3 );
+    count[0] = numMeasurements;
+    count[1] = numReceivers;
+    count[2] = numBins;
+    
+    const std::vector< ptrdiff_t > stride( 3, 1 );
+    
+    /// distance between consecutive elements in memory, in doubles
+    std::vector< ptrdiff_t > imap( 3 );
+    imap[0] = static_cast< ptrdiff_t >( 2 * numReceivers * numBins );
+    imap[1] = static_cast< ptrdiff_t >( 2 * numBins );
+    imap[2] = 2;
+    
+    /// std::complex< double > is layout-compatible with double[2]
+    double *interleaved = reinterpret_cast< double * >( values );
+    
+    varReal.getVar( start, count, stride, imap, interleaved );
+    varImag.getVar( start, count, stride, imap, interleaved + 1 );
+    
+    return true;
+}
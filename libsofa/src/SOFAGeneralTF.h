@@ -50,6 +50,7 @@
 #define _SOFA_GENERAL_TF_H__
 
 #include "../src/SOFAFile.h"
+#include <complex>
 
 namespace sofa
 {
@@ -59,7 +60,12 @@ namespace sofa
      *  @class          GeneralTF
      *  @brief          Class for SOFA files with GeneralTF convention
      *
-     *  @details        Provides methods specific to SOFA files with GeneralTF convention
+     *  @details        Provides methods specific to SOFA files with GeneralTF convention.
+     *                  Data.Real and Data.Imag [M R N] can be read as a whole, or as
+     *                  hyperslabs (ranges of measurements, receivers and frequency bins),
+     *                  either split (real and imaginary arrays) or interleaved (std::complex).
+     *                  When the N axis is the regular grid of a real FFT (see IsFFTFrequencyAxis),
+     *                  the spectra can be passed as they are to sofa::Convolver.
      */
     /************************************************************************************/
     class SOFA_API GeneralTF : public sofa::File
@@ -77,6 +83,43 @@ namespace sofa
         
         virtual bool IsValid() const SOFA_OVERRIDE;
         
+        //==============================================================================
+        bool GetFrequencies(std::vector< double > &values) const;
+        bool GetFrequencies(double *values, const unsigned long dim1) const;
+        bool GetFrequencyUnits(sofa::Units::Type &units) const;
+        
+        bool IsFFTFrequencyAxis(std::size_t &fftSize, double &samplingRate) const;
+        
+        //==============================================================================
+        bool GetDataReal(std::vector< double > &values) const;
+        bool GetDataImag(std::vector< double > &values) const;
+        
+        bool GetDataTF(double *real,
+                       double *imag,
+                       const std::size_t firstMeasurement,
+                       const std::size_t numMeasurements) const;
+        
+        bool GetDataTF(std::complex< double > *values,
+                       const std::size_t firstMeasurement,
+                       const std::size_t numMeasurements) const;
+        
+        bool GetDataTF(double *real,
+                       double *imag,
+                       const std::size_t firstMeasurement,
+                       const std::size_t numMeasurements,
+                       const std::size_t firstReceiver,
+                       const std::size_t numReceivers,
+                       const std::size_t firstBin,
+                       const std::size_t numBins) const;
+        
+        bool GetDataTF(std::complex< double > *values,
+                       const std::size_t firstMeasurement,
+                       const std::size_t numMeasurements,
+                       const std::size_t firstReceiver,
+                       const std::size_t numReceivers,
+                       const std::size_t firstBin,
+                       const std::size_t numBins) const;
+        
     private:
         //==============================================================================
         bool checkGlobalAttributes() const;
@@ -0,0 +1,450 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAHeadphoneEqualization.cpp
+ *   @brief      Design of headphone equalization filters from SimpleHeadphoneIR measurements
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAHeadphoneEqualization.h"
+#include "../src/SOFATransferFunctions.h"
+#include "../src/SOFAMinimumPhase.h"
+#include "../src/SOFAQuantization.h"
+#include "../src/SOFAWriter.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /************************************************************************************/
+    /*!
+     *  @brief          Weight of the in-band regularization at a given frequency : 1 inside
+     *                  [lowFrequency highFrequency], 0 one octave away, raised-cosine in between
+     *
+     */
+    /************************************************************************************/
+    static double getInBandWeight(const double frequency,
+                                  const double lowFrequency,
+                                  const double highFrequency)
+    {
+        const double pi = 3.14159265358979323846;
+        
+        if( frequency <= 0.5 * lowFrequency || frequency >= 2.0 * highFrequency )
+        {
+            return 0.0;
+        }
+        
+        if( frequency < lowFrequency )
+        {
+            return 0.5 - 0.5 * std::cos( pi * std::log2( frequency / ( 0.5 * lowFrequency ) ) );
+        }
+        
+        if( frequency > highFrequency )
+        {
+            return 0.5 - 0.5 * std::cos( pi * std::log2( 2.0 * highFrequency / frequency ) );
+        }
+        
+        return 1.0;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of an averaging method
+ *
+ */
+/************************************************************************************/
+std::string HeadphoneEqualization::GetName(const sofa::HeadphoneEqualization::Averaging &averaging)
+{
+    switch( averaging )
+    {
+        case sofa::HeadphoneEqualization::kComplexAverage   : return "complex";
+        case sofa::HeadphoneEqualization::kPowerAverage     : return "power";
+            
+        default                                             : SOFA_ASSERT( false ); return "";
+        case sofa::HeadphoneEqualization::kNumAveragings    : SOFA_ASSERT( false ); return "";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+HeadphoneEqualization::HeadphoneEqualization()
+: numReceivers( 0 )
+, filterLength( 0 )
+, samplingRate( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Designs the equalization filters from a SimpleHeadphoneIR file
+ *  @param[in]      averaging : how the M measurements of a receiver are averaged
+ *  @param[in]      regularizationDB : in-band regularization, relative to the mean in-band
+ *                  power of the average response (out of band, the regularization is 0 dB)
+ *  @param[in]      lowFrequency : lower limit of the equalized band (hertz)
+ *  @param[in]      highFrequency : upper limit of the equalized band (hertz)
+ *  @param[in]      fftSize : power of 2, not smaller than N plus the largest Data.Delay
+ *                  (0 for the default size) : this is the length of the filters
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ */
+/************************************************************************************/
+void HeadphoneEqualization::Design(const sofa::File &file,
+                                   const sofa::HeadphoneEqualization::Averaging &averaging,
+                                   const double regularizationDB,
+                                   const double lowFrequency,
+                                   const double highFrequency,
+                                   const std::size_t fftSize,
+                                   const unsigned int numThreads)
+{
+    sofa::ImpulseResponses responses;
+    responses.Load( file );
+    
+    Design( responses, averaging, regularizationDB, lowFrequency, highFrequency, fftSize, numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Designs the equalization filters from a set of responses [M R N]
+ *
+ */
+/************************************************************************************/
+void HeadphoneEqualization::Design(const sofa::ImpulseResponses &responses,
+                                   const sofa::HeadphoneEqualization::Averaging &averaging,
+                                   const double regularizationDB,
+                                   const double lowFrequency,
+                                   const double highFrequency,
+                                   const std::size_t fftSize,
+                                   const unsigned int numThreads)
+{
+    const std::size_t M = responses.GetNumMeasurements();
+    const std::size_t R = responses.GetNumReceivers();
+    
+    if( responses.GetNumEmitters() != 1 || M == 0 || R == 0 )
+    {
+        SOFA_THROW( "the responses must have one emitter, and at least one measurement" );
+    }
+    
+    if( lowFrequency <= 0.0 || highFrequency <= lowFrequency )
+    {
+        SOFA_THROW( "invalid equalization band" );
+    }
+    
+    /// all the transfer functions at once, spread over the threads
+    sofa::TransferFunctions spectra;
+    spectra.Compute( responses, fftSize, numThreads );
+    
+    const std::size_t K = spectra.GetFFTSize();
+    const std::size_t B = spectra.GetNumBins();
+    
+    numReceivers    = R;
+    filterLength    = K;
+    samplingRate    = responses.GetSamplingRate();
+    
+    averageMagnitudes.assign( R * B, 0.0 );
+    filters.resize( R * K );
+    
+    sofa::Threads::ParallelFor( R,
+                                [&]( const std::size_t r, const unsigned int )
+                                {
+                                    double *magnitude = &averageMagnitudes[ r * B ];
+                                    
+                                    //==============================================================================
+                                    /// average over the measurements
+                                    if( averaging == kComplexAverage )
+                                    {
+                                        std::vector< double > real( B, 0.0 );
+                                        std::vector< double > imag( B, 0.0 );
+                                        
+                                        for( std::size_t m = 0; m < M; m++ )
+                                        {
+                                            const std::complex< double > *spectrum = spectra.GetSpectrum( m * R + r );
+                                            
+                                            for( std::size_t k = 0; k < B; k++ )
+                                            {
+                                                real[k] += spectrum[k].real();
+                                                imag[k] += spectrum[k].imag();
+                                            }
+                                        }
+                                        
+                                        for( std::size_t k = 0; k < B; k++ )
+                                        {
+                                            magnitude[k] = std::sqrt( real[k] * real[k] + imag[k] * imag[k] ) / static_cast< double >( M );
+                                        }
+                                    }
+                                    else
+                                    {
+                                        for( std::size_t m = 0; m < M; m++ )
+                                        {
+                                            const std::complex< double > *spectrum = spectra.GetSpectrum( m * R + r );
+                                            
+                                            for( std::size_t k = 0; k < B; k++ )
+                                            {
+                                                magnitude[k] += std::norm( spectrum[k] );
+                                            }
+                                        }
+                                        
+                                        for( std::size_t k = 0; k < B; k++ )
+                                        {
+                                            magnitude[k] = std::sqrt( magnitude[k] / static_cast< double >( M ) );
+                                        }
+                                    }
+                                    
+                                    //==============================================================================
+                                    /// regularization, relative to the mean in-band power
+                                    double power        = 0.0;
+                                    std::size_t count   = 0;
+                                    
+                                    for( std::size_t k = 1; k < B; k++ )
+                                    {
+                                        const double frequency = spectra.GetFrequency( k );
+                                        
+                                        if( frequency >= lowFrequency && frequency <= highFrequency )
+                                        {
+                                            power += magnitude[k] * magnitude[k];
+                                            count++;
+                                        }
+                                    }
+                                    
+                                    if( count == 0 || power <= 0.0 )
+                                    {
+                                        std::fill( &filters[ r * K ], &filters[ r * K ] + K, 0.0 );
+                                        return;
+                                    }
+                                    
+                                    power /= static_cast< double >( count );
+                                    
+                                    const double logInBand  = std::log( power * std::pow( 10.0, regularizationDB / 10.0 ) );
+                                    const double logOutBand = std::log( power );
+                                    
+                                    //==============================================================================
+                                    /// regularized inverse, as a linear-phase filter (delay of K / 2 samples)
+                                    std::vector< std::complex< double > > inverse( B );
+                                    
+                                    for( std::size_t k = 0; k < B; k++ )
+                                    {
+                                        const double weight = sofaLocal::getInBandWeight( spectra.GetFrequency( k ), lowFrequency, highFrequency );
+                                        const double beta   = std::exp( weight * logInBand + ( 1.0 - weight ) * logOutBand );
+                                        const double gain   = magnitude[k] / ( magnitude[k] * magnitude[k] + beta );
+                                        
+                                        inverse[k] = std::complex< double >( ( k % 2 == 0 ) ? gain : -gain, 0.0 );
+                                    }
+                                    
+                                    std::vector< double > prototype( K );
+                                    
+                                    const sofa::FFT fft( K );
+                                    fft.InverseReal( &prototype[0], &inverse[0] );
+                                    
+                                    /// same magnitude, minimum phase
+                                    sofa::MinimumPhase minimumPhase( K );
+                                    minimumPhase.Process( &filters[ r * K ], &prototype[0] );
+                                },
+                                numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the filters to a new file, with the layout of the source file
+ *                  (e.g. SimpleHeadphoneIR) : one measurement, Data.IR [1 R filterLength]
+ *  @param[in]      source : the file the filters were designed from
+ *  @param[in]      outputPath : path of the file to create
+ *
+ *  @details        The per-measurement variables (SourcePosition, ...) of the first
+ *                  measurement of the source are kept
+ */
+/************************************************************************************/
+void HeadphoneEqualization::Write(const sofa::File &source,
+                                  const std::string &outputPath) const
+{
+    if( static_cast< std::size_t >( source.GetNumReceivers() ) != numReceivers || filters.empty() == true )
+    {
+        SOFA_THROW( "the filters do not match the receivers of the source file" );
+    }
+    
+    sofa::Writer writer( outputPath );
+    
+    writer.CopyGlobalAttributes( source );
+    writer.UpdateModificationAttributes();
+    
+    std::vector< std::string > resized;
+    resized.push_back( "M" );
+    resized.push_back( "N" );
+    
+    writer.CopyDimensions( source, resized );
+    writer.AddDimension( "M", 1 );
+    writer.AddDimension( "N", filterLength );
+    
+    //==============================================================================
+    /// the variables that are rewritten, or that depend on M or N, are not copied as is
+    std::vector< std::string > excluded;
+    excluded.push_back( "Data.IR" );
+    excluded.push_back( "Data.Delay" );
+    excluded.push_back( "Data.SamplingRate" );
+    excluded.push_back( sofa::Quantization::GainVariableName );
+    
+    std::vector< std::string > perMeasurement;
+    
+    std::vector< std::string > variableNames;
+    source.GetAllVariablesNames( variableNames );
+    
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
+    {
+        const std::string name = variableNames[i];
+        
+        if( std::find( excluded.begin(), excluded.end(), name ) != excluded.end() )
+        {
+            continue;
+        }
+        
+        std::vector< std::string > dimNames;
+        source.GetVariableDimensionsNames( dimNames, name );
+        
+        if( std::find( dimNames.begin(), dimNames.end(), "N" ) != dimNames.end() )
+        {
+            excluded.push_back( name );
+        }
+        else if( dimNames.empty() == false && dimNames[0] == "M" )
+        {
+            excluded.push_back( name );
+            perMeasurement.push_back( name );
+        }
+    }
+    
+    writer.CopyVariables( source, excluded );
+    
+    const std::vector< std::size_t > firstMeasurement( 1, 0 );
+    
+    for( std::size_t i = 0; i < perMeasurement.size(); i++ )
+    {
+        writer.CopyVariableDefinition( source, perMeasurement[i] );
+        writer.CopyVariableValues( source, perMeasurement[i], firstMeasurement );
+    }
+    
+    //==============================================================================
+    writer.AddVariable( "Data.SamplingRate", std::vector< std::string >( 1, "I" ) );
+    writer.PutVariableAttribute( "Data.SamplingRate", "Units", "hertz" );
+    writer.PutValues( "Data.SamplingRate", &samplingRate );
+    
+    std::vector< std::string > delayDims;
+    delayDims.push_back( "I" );
+    delayDims.push_back( "R" );
+    
+    const std::vector< double > delays( numReceivers, 0.0 );
+    
+    writer.AddVariable( "Data.Delay", delayDims );
+    writer.PutValues( "Data.Delay", &delays[0] );
+    
+    std::vector< std::string > irDims;
+    irDims.push_back( "M" );
+    irDims.push_back( "R" );
+    irDims.push_back( "N" );
+    
+    writer.AddVariable( "Data.IR", irDims );
+    writer.PutValues( "Data.IR", &filters[0] );
+}
+
+std::size_t HeadphoneEqualization::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t HeadphoneEqualization::GetFilterLength() const
+{
+    return filterLength;
+}
+
+std::size_t HeadphoneEqualization::GetNumBins() const
+{
+    return ( filterLength > 0 ) ? filterLength / 2 + 1 : 0;
+}
+
+double HeadphoneEqualization::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the equalization filter of a receiver, GetFilterLength() samples
+ *
+ */
+/************************************************************************************/
+const double * HeadphoneEqualization::GetFilter(const std::size_t receiver) const
+{
+    SOFA_ASSERT( receiver < numReceivers );
+    
+    return &filters[ receiver * filterLength ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns all the filters, [R filterLength]
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & HeadphoneEqualization::GetFilters() const
+{
+    return filters;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the averaged magnitude response of a receiver, GetNumBins() values
+ *
+ */
+/************************************************************************************/
+const double * HeadphoneEqualization::GetAverageMagnitude(const std::size_t receiver) const
+{
+    SOFA_ASSERT( receiver < numReceivers );
+    
+    return &averageMagnitudes[ receiver * GetNumBins() ];
+}
@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAHeadphoneEqualization.h
+ *   @brief      Design of headphone equalization filters from SimpleHeadphoneIR measurements
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_HEADPHONE_EQUALIZATION_H__
+#define _SOFA_HEADPHONE_EQUALIZATION_H__
+
+#include "../src/SOFAImpulseResponses.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          HeadphoneEqualization
+     *  @brief          Designs one minimum-phase equalization filter per receiver, from the
+     *                  repeated headphone measurements of a SimpleHeadphoneIR file
+     *
+     *  @details        The transfer functions of all the measurements are computed at once
+     *                  (in parallel), then averaged over the M repositionings of each receiver.
+     *                  The average is inverted with a frequency-dependent regularization :
+     *                  weak inside [lowFrequency highFrequency], strong outside (with one-octave
+     *                  transitions), so that the roll-offs of the headphones are not boosted.
+     *                  The magnitude of the inverse is turned into a minimum-phase FIR filter
+     *                  with the cepstral method (sofa::MinimumPhase).
+     */
+    /************************************************************************************/
+    class SOFA_API HeadphoneEqualization
+    {
+    public:
+        enum Averaging
+        {
+            kComplexAverage     = 0,    ///< magnitude of the mean transfer function
+            kPowerAverage       = 1,    ///< root mean square of the magnitudes
+            
+            kNumAveragings      = 2
+        };
+        
+        static std::string GetName(const sofa::HeadphoneEqualization::Averaging &averaging);
+        
+    public:
+        HeadphoneEqualization();
+        ~HeadphoneEqualization() {};
+        
+        //==============================================================================
+        void Design(const sofa::File &file,
+                    const sofa::HeadphoneEqualization::Averaging &averaging = kPowerAverage,
+                    const double regularizationDB = -20.0,
+                    const double lowFrequency = 50.0,
+                    const double highFrequency = 16000.0,
+                    const std::size_t fftSize = 0,
+                    const unsigned int numThreads = 0);
+        
+        void Design(const sofa::ImpulseResponses &responses,
+                    const sofa::HeadphoneEqualization::Averaging &averaging = kPowerAverage,
+                    const double regularizationDB = -20.0,
+                    const double lowFrequency = 50.0,
+                    const double highFrequency = 16000.0,
+                    const std::size_t fftSize = 0,
+                    const unsigned int numThreads = 0);
+        
+        void Write(const sofa::File &source,
+                   const std::string &outputPath) const;
+        
+        //==============================================================================
+        std::size_t GetNumReceivers() const;
+        std::size_t GetFilterLength() const;
+        std::size_t GetNumBins() const;
+        double GetSamplingRate() const;
+        
+        const double * GetFilter(const std::size_t receiver) const;
+        const std::vector< double > & GetFilters() const;
+        
+        const double * GetAverageMagnitude(const std::size_t receiver) const;
+        
+    protected:
+        std::size_t numReceivers;
+        std::size_t filterLength;
+        double samplingRate;
+        
+        std::vector< double > averageMagnitudes;    ///< [R filterLength/2+1]
+        std::vector< double > filters;              ///< [R filterLength]
+    };
+    
+}
+
+#endif /* _SOFA_HEADPHONE_EQUALIZATION_H__ */
@@ -0,0 +1,481 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAImpulseResponses.cpp
+ *   @brief      In-memory set of impulse responses, for batch processing
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAImpulseResponses.h"
+#include "../src/SOFAWriter.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// target size (in bytes) of the HDF5 chunks of Data.IR
+    static const std::size_t kChunkSize = 256 * 1024;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : an empty set
+ *
+ */
+/************************************************************************************/
+ImpulseResponses::ImpulseResponses()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numEmitters( 1 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, hasEmitterDimension( false )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : a set of zero responses
+ *  @param[in]      numEmitters : more than 1 emitter implies FIRE data
+ *
+ */
+/************************************************************************************/
+ImpulseResponses::ImpulseResponses(const std::size_t numMeasurements_,
+                                   const std::size_t numReceivers_,
+                                   const std::size_t numEmitters_,
+                                   const std::size_t numDataSamples_,
+                                   const double samplingRate_)
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numEmitters( 1 )
+, numDataSamples( 0 )
+, samplingRate( samplingRate_ )
+, hasEmitterDimension( numEmitters_ > 1 )
+{
+    Resize( numMeasurements_, numReceivers_, numEmitters_, numDataSamples_ );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads the responses, delays and sampling rate of a FIR or FIRE file
+ *
+ *  @details        Quantized files are dequantized. A Data.SamplingRate [M]
+ *                  is accepted only if all the measurements share the same rate
+ */
+/************************************************************************************/
+void ImpulseResponses::Load(const sofa::File &file)
+{
+    Load( file, 0, file.GetNumMeasurements() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads a range of measurements of a FIR or FIRE file
+ *  @param[in]      firstMeasurement : index of the first measurement to load
+ *  @param[in]      numMeasurements : number of measurements to load
+ *
+ *  @details        This allows to process large files block by block
+ */
+/************************************************************************************/
+void ImpulseResponses::Load(const sofa::File &file,
+                            const std::size_t firstMeasurement,
+                            const std::size_t numMeasurements_)
+{
+    std::vector< std::size_t > dims;
+    file.GetVariableDimensions( dims, "Data.IR" );
+    
+    if( dims.size() != 3 && dims.size() != 4 )
+    {
+        SOFA_THROW( "invalid dimensions for 'Data.IR'" );
+    }
+    
+    if( firstMeasurement + numMeasurements_ > dims[0] )
+    {
+        SOFA_THROW( "invalid range of measurements" );
+    }
+    
+    hasEmitterDimension = ( dims.size() == 4 );
+    
+    Resize( numMeasurements_, dims[1], hasEmitterDimension == true ? dims[2] : 1, dims.back() );
+    
+    if( numMeasurements > 0 && file.GetDataIRMeasurements( &values[0], firstMeasurement, numMeasurements ) == false )
+    {
+        SOFA_THROW( "cannot read 'Data.IR'" );
+    }
+    
+    //==============================================================================
+    std::vector< double > rates;
+    if( file.GetValues( rates, "Data.SamplingRate" ) == false || rates.empty() == true )
+    {
+        SOFA_THROW( "invalid 'Data.SamplingRate' variable" );
+    }
+    
+    for( std::size_t i = 1; i < rates.size(); i++ )
+    {
+        if( rates[i] != rates[0] )
+        {
+            SOFA_THROW( "measurements with different sampling rates are not supported" );
+        }
+    }
+    
+    samplingRate = rates[0];
+    
+    //==============================================================================
+    std::vector< double > fileDelays;
+    if( file.GetValues( fileDelays, "Data.Delay" ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' variable" );
+    }
+    
+    std::vector< std::size_t > delayDims;
+    file.GetVariableDimensions( delayDims, "Data.Delay" );
+    
+    const std::size_t delaysPerMeasurement = numReceivers * numEmitters;
+    
+    if( delayDims.empty() == true
+       || fileDelays.size() != delayDims[0] * delaysPerMeasurement
+       || ( delayDims[0] != 1 && delayDims[0] != dims[0] ) )
+    {
+        SOFA_THROW( "invalid dimensions for 'Data.Delay'" );
+    }
+    
+    for( std::size_t m = 0; m < numMeasurements; m++ )
+    {
+        const std::size_t src = ( delayDims[0] == 1 ) ? 0 : firstMeasurement + m;
+        
+        std::copy( fileDelays.begin() + src * delaysPerMeasurement,
+                   fileDelays.begin() + ( src + 1 ) * delaysPerMeasurement,
+                   delays.begin() + m * delaysPerMeasurement );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the responses as a new SOFA file
+ *  @param[in]      source : the file the responses were loaded from; all its attributes,
+ *                  dimensions and variables are copied, except the ones depending on N
+ *  @param[in]      outputPath : path of the new file (replaced if it exists)
+ *
+ *  @details        Data.IR is written as double, Data.Delay as [M R] (or [M R E])
+ *                  and Data.SamplingRate as [I]
+ */
+/************************************************************************************/
+void ImpulseResponses::Write(const sofa::File &source,
+                             const std::string &outputPath) const
+{
+    if( static_cast< std::size_t >( source.GetNumMeasurements() ) != numMeasurements
+       || static_cast< std::size_t >( source.GetNumReceivers() ) != numReceivers
+       || ( hasEmitterDimension == true && static_cast< std::size_t >( source.GetNumEmitters() ) != numEmitters ) )
+    {
+        SOFA_THROW( "the responses do not match the dimensions of the source file" );
+    }
+    
+    sofa::Writer writer( outputPath );
+    
+    writer.CopyGlobalAttributes( source );
+    writer.UpdateModificationAttributes();
+    
+    writer.CopyDimensions( source, std::vector< std::string >( 1, "N" ) );
+    writer.AddDimension( "N", numDataSamples );
+    
+    //==============================================================================
+    /// the variables that are rewritten, or that depend on N, are not copied
+    std::vector< std::string > excluded;
+    excluded.push_back( "Data.IR" );
+    excluded.push_back( "Data.Delay" );
+    excluded.push_back( "Data.SamplingRate" );
+    excluded.push_back( sofa::Quantization::GainVariableName );
+    
+    std::vector< std::string > variableNames;
+    source.GetAllVariablesNames( variableNames );
+    
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
+    {
+        std::vector< std::string > dimNames;
+        source.GetVariableDimensionsNames( dimNames, variableNames[i] );
+        
+        if( std::find( dimNames.begin(), dimNames.end(), "N" ) != dimNames.end() )
+        {
+            excluded.push_back( variableNames[i] );
+        }
+    }
+    
+    writer.CopyVariables( source, excluded );
+    
+    //==============================================================================
+    writer.AddVariable( "Data.SamplingRate", std::vector< std::string >( 1, "I" ) );
+    writer.PutVariableAttribute( "Data.SamplingRate", "Units", "hertz" );
+    writer.PutValues( "Data.SamplingRate", &samplingRate );
+    
+    std::vector< std::string > delayDims;
+    delayDims.push_back( "M" );
+    delayDims.push_back( "R" );
+    if( hasEmitterDimension == true )
+    {
+        delayDims.push_back( "E" );
+    }
+    
+    writer.AddVariable( "Data.Delay", delayDims );
+    
+    std::vector< std::string > irDims = delayDims;
+    irDims.push_back( "N" );
+    
+    writer.AddVariable( "Data.IR", irDims );
+    
+    const std::size_t measurementSize = numReceivers * numEmitters * numDataSamples;
+    
+    if( numMeasurements > 0 && measurementSize > 0 )
+    {
+        std::vector< std::size_t > chunkSizes;
+        chunkSizes.push_back( sofa::smin( numMeasurements, sofa::smax( (std::size_t) 1, sofaLocal::kChunkSize / ( measurementSize * sizeof( double ) ) ) ) );
+        chunkSizes.push_back( numReceivers );
+        if( hasEmitterDimension == true )
+        {
+            chunkSizes.push_back( numEmitters );
+        }
+        chunkSizes.push_back( numDataSamples );
+        
+        writer.SetChunking( "Data.IR", chunkSizes );
+        
+        writer.PutValues( "Data.Delay", &delays[0] );
+        writer.PutValues( "Data.IR", &values[0] );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Resizes the set; all the responses and delays are set to zero
+ *
+ */
+/************************************************************************************/
+void ImpulseResponses::Resize(const std::size_t numMeasurements_,
+                              const std::size_t numReceivers_,
+                              const std::size_t numEmitters_,
+                              const std::size_t numDataSamples_)
+{
+    numMeasurements = numMeasurements_;
+    numReceivers    = numReceivers_;
+    numEmitters     = sofa::smax( (std::size_t) 1, numEmitters_ );
+    numDataSamples  = numDataSamples_;
+    
+    values.assign( GetNumResponses() * numDataSamples, 0.0 );
+    delays.assign( GetNumResponses(), 0.0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Changes the length of the responses, keeping their first samples
+ *                  (and padding them with zeros if needed)
+ *
+ */
+/************************************************************************************/
+void ImpulseResponses::SetNumDataSamples(const std::size_t numDataSamples_)
+{
+    if( numDataSamples_ == numDataSamples )
+    {
+        return;
+    }
+    
+    const std::size_t numResponses  = GetNumResponses();
+    const std::size_t numCopied     = sofa::smin( numDataSamples, numDataSamples_ );
+    
+    std::vector< double > resized( numResponses * numDataSamples_, 0.0 );
+    
+    for( std::size_t i = 0; i < numResponses; i++ )
+    {
+        std::copy( values.begin() + i * numDataSamples,
+                   values.begin() + i * numDataSamples + numCopied,
+                   resized.begin() + i * numDataSamples_ );
+    }
+    
+    values.swap( resized );
+    numDataSamples = numDataSamples_;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Dimensions of the set
+ *
+ */
+/************************************************************************************/
+std::size_t ImpulseResponses::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+std::size_t ImpulseResponses::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t ImpulseResponses::GetNumEmitters() const
+{
+    return numEmitters;
+}
+
+std::size_t ImpulseResponses::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+std::size_t ImpulseResponses::GetNumResponses() const
+{
+    return numMeasurements * numReceivers * numEmitters;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true for FIRE data ([M R E N])
+ *
+ */
+/************************************************************************************/
+bool ImpulseResponses::HasEmitterDimension() const
+{
+    return hasEmitterDimension;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sampling rate, in hertz
+ *
+ */
+/************************************************************************************/
+double ImpulseResponses::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+void ImpulseResponses::SetSamplingRate(const double samplingRate_)
+{
+    samplingRate = samplingRate_;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the flat index of a response, i.e. its row in [M R E]
+ *
+ */
+/************************************************************************************/
+std::size_t ImpulseResponses::GetResponseIndex(const std::size_t measurement,
+                                               const std::size_t receiver,
+                                               const std::size_t emitter) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers && emitter < numEmitters );
+    
+    return ( measurement * numReceivers + receiver ) * numEmitters + emitter;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the numDataSamples samples of a response
+ *
+ */
+/************************************************************************************/
+double * ImpulseResponses::GetResponse(const std::size_t responseIndex)
+{
+    SOFA_ASSERT( responseIndex < GetNumResponses() );
+    
+    return &values[ responseIndex * numDataSamples ];
+}
+
+const double * ImpulseResponses::GetResponse(const std::size_t responseIndex) const
+{
+    SOFA_ASSERT( responseIndex < GetNumResponses() );
+    
+    return &values[ responseIndex * numDataSamples ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delay of a response, in samples
+ *
+ */
+/************************************************************************************/
+double ImpulseResponses::GetDelay(const std::size_t responseIndex) const
+{
+    SOFA_ASSERT( responseIndex < GetNumResponses() );
+    
+    return delays[ responseIndex ];
+}
+
+void ImpulseResponses::SetDelay(const std::size_t responseIndex, const double delay)
+{
+    SOFA_ASSERT( responseIndex < GetNumResponses() );
+    
+    delays[ responseIndex ] = delay;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Direct access to the [M R E N] samples
+ *
+ */
+/************************************************************************************/
+std::vector< double > & ImpulseResponses::GetValues()
+{
+    return values;
+}
+
+const std::vector< double > & ImpulseResponses::GetValues() const
+{
+    return values;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Direct access to the [M R E] delays
+ *
+ */
+/************************************************************************************/
+std::vector< double > & ImpulseResponses::GetDelays()
+{
+    return delays;
+}
+
+const std::vector< double > & ImpulseResponses::GetDelays() const
+{
+    return delays;
+}
@@ -0,0 +1,142 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAImpulseResponses.h
+ *   @brief      In-memory set of impulse responses, for batch processing
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_IMPULSE_RESPONSES_H__
+#define _SOFA_IMPULSE_RESPONSES_H__
+
+#include "../src/SOFAFile.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          ImpulseResponses
+     *  @brief          The Data.IR, Data.Delay and Data.SamplingRate of a FIR or FIRE file,
+     *                  loaded in memory
+     *
+     *  @details        The responses are stored as [M R E N] (E = 1 for FIR files),
+     *                  the delays (in samples) are always expanded to [M R E].
+     *                  Processing classes (minimum-phase, truncation, resampling, ...)
+     *                  modify an ImpulseResponses, which can then be written as a new
+     *                  SOFA file, all the other variables being copied from the source file.
+     */
+    /************************************************************************************/
+    class SOFA_API ImpulseResponses
+    {
+    public:
+        ImpulseResponses();
+        ImpulseResponses(const std::size_t numMeasurements,
+                         const std::size_t numReceivers,
+                         const std::size_t numEmitters,
+                         const std::size_t numDataSamples,
+                         const double samplingRate);
+        
+        ~ImpulseResponses() {};
+        
+        //==============================================================================
+        void Load(const sofa::File &file);
+        
+        void Load(const sofa::File &file,
+                  const std::size_t firstMeasurement,
+                  const std::size_t numMeasurements);
+        
+        void Write(const sofa::File &source,
+                   const std::string &outputPath) const;
+        
+        //==============================================================================
+        void Resize(const std::size_t numMeasurements,
+                    const std::size_t numReceivers,
+                    const std::size_t numEmitters,
+                    const std::size_t numDataSamples);
+        
+        void SetNumDataSamples(const std::size_t numDataSamples);
+        
+        std::size_t GetNumMeasurements() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetNumEmitters() const;
+        std::size_t GetNumDataSamples() const;
+        std::size_t GetNumResponses() const;
+        
+        bool HasEmitterDimension() const;
+        
+        double GetSamplingRate() const;
+        void SetSamplingRate(const double samplingRate);
+        
+        //==============================================================================
+        std::size_t GetResponseIndex(const std::size_t measurement,
+                                     const std::size_t receiver,
+                                     const std::size_t emitter = 0) const;
+        
+        double * GetResponse(const std::size_t responseIndex);
+        const double * GetResponse(const std::size_t responseIndex) const;
+        
+        double GetDelay(const std::size_t responseIndex) const;
+        void SetDelay(const std::size_t responseIndex, const double delay);
+        
+        std::vector< double > & GetValues();
+        const std::vector< double > & GetValues() const;
+        
+        std::vector< double > & GetDelays();
+        const std::vector< double > & GetDelays() const;
+        
+    protected:
+        std::size_t numMeasurements;
+        std::size_t numReceivers;
+        std::size_t numEmitters;
+        std::size_t numDataSamples;
+        double samplingRate;
+        bool hasEmitterDimension;           ///< true for FIRE data ([M R E N])
+        
+        std::vector< double > values;       ///< [M R E N]
+        std::vector< double > delays;       ///< [M R E], in samples
+    };
+    
+}
+
+#endif /* _SOFA_IMPULSE_RESPONSES_H__ */
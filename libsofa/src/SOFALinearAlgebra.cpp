@@ -0,0 +1,276 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFALinearAlgebra.cpp
+ *   @brief      Small dense linear algebra routines
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          In-place Cholesky decomposition of a symmetric positive-definite matrix
+ *  @param[in]      matrix : [size size], replaced by L (lower triangle, A = L L^T)
+ *  @return         false if the matrix is not positive-definite
+ *
+ */
+/************************************************************************************/
+bool LinearAlgebra::CholeskyDecomposition(std::vector< double > &matrix,
+                                          const std::size_t size)
+{
+    SOFA_ASSERT( matrix.size() == size * size );
+    
+    for( std::size_t j = 0; j < size; j++ )
+    {
+        double *rowJ = &matrix[ j * size ];
+        
+        double diagonal = rowJ[j];
+        for( std::size_t k = 0; k < j; k++ )
+        {
+            diagonal -= rowJ[k] * rowJ[k];
+        }
+        
+        if( diagonal <= 0.0 )
+        {
+            return false;
+        }
+        
+        diagonal = std::sqrt( diagonal );
+        rowJ[j] = diagonal;
+        
+        for( std::size_t i = j + 1; i < size; i++ )
+        {
+            double *rowI = &matrix[ i * size ];
+            
+            double value = rowI[j];
+            for( std::size_t k = 0; k < j; k++ )
+            {
+                value -= rowI[k] * rowJ[k];
+            }
+            
+            rowI[j] = value / diagonal;
+        }
+        
+        /// clear the upper triangle
+        std::fill( rowJ + j + 1, rowJ + size, 0.0 );
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Solves A X = B, given the Cholesky decomposition of A
+ *  @param[in]      decomposition : [size size] output of CholeskyDecomposition()
+ *  @param[in]      rightHandSides : [size numRightHandSides] B, replaced by X
+ *
+ */
+/************************************************************************************/
+void LinearAlgebra::CholeskySolve(const std::vector< double > &decomposition,
+                                  const std::size_t size,
+                                  double *rightHandSides,
+                                  const std::size_t numRightHandSides)
+{
+    const std::size_t n = numRightHandSides;
+    
+    /// L Y = B
+    for( std::size_t i = 0; i < size; i++ )
+    {
+        double *rowI = rightHandSides + i * n;
+        
+        for( std::size_t k = 0; k < i; k++ )
+        {
+            const double l      = decomposition[ i * size + k ];
+            const double *rowK  = rightHandSides + k * n;
+            
+            for( std::size_t c = 0; c < n; c++ )
+            {
+                rowI[c] -= l * rowK[c];
+            }
+        }
+        
+        const double inverse = 1.0 / decomposition[ i * size + i ];
+        for( std::size_t c = 0; c < n; c++ )
+        {
+            rowI[c] *= inverse;
+        }
+    }
+    
+    /// L^T X = Y
+    for( std::size_t ii = size; ii > 0; ii-- )
+    {
+        const std::size_t i = ii - 1;
+        double *rowI = rightHandSides + i * n;
+        
+        for( std::size_t k = i + 1; k < size; k++ )
+        {
+            const double l      = decomposition[ k * size + i ];
+            const double *rowK  = rightHandSides + k * n;
+            
+            for( std::size_t c = 0; c < n; c++ )
+            {
+                rowI[c] -= l * rowK[c];
+            }
+        }
+        
+        const double inverse = 1.0 / decomposition[ i * size + i ];
+        for( std::size_t c = 0; c < n; c++ )
+        {
+            rowI[c] *= inverse;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the Tikhonov-regularized pseudo-inverse ( A^T A + l I )^-1 A^T
+ *  @param[out]     pseudoInverse : [numColumns numRows]
+ *  @param[in]      matrix : A, [numRows numColumns]
+ *  @param[in]      regularization : l, relative to the mean of the diagonal of A^T A
+ *                  (so that it does not depend on the scaling of A)
+ *
+ *  @details        X = pseudoInverse B is the solution of min |A X - B|^2 + l |X|^2
+ */
+/************************************************************************************/
+void LinearAlgebra::GetRegularizedPseudoInverse(std::vector< double > &pseudoInverse,
+                                                const std::vector< double > &matrix,
+                                                const std::size_t numRows,
+                                                const std::size_t numColumns,
+                                                const double regularization)
+{
+    SOFA_ASSERT( matrix.size() == numRows * numColumns );
+    
+    const std::size_t n = numColumns;
+    
+    /// A^T A
+    std::vector< double > normal( n * n, 0.0 );
+    
+    for( std::size_t r = 0; r < numRows; r++ )
+    {
+        const double *row = &matrix[ r * n ];
+        
+        for( std::size_t i = 0; i < n; i++ )
+        {
+            const double a  = row[i];
+            double *dst     = &normal[ i * n ];
+            
+            for( std::size_t j = 0; j < n; j++ )
+            {
+                dst[j] += a * row[j];
+            }
+        }
+    }
+    
+    double trace = 0.0;
+    for( std::size_t i = 0; i < n; i++ )
+    {
+        trace += normal[ i * n + i ];
+    }
+    
+    const double lambda = sofa::smax( 0.0, regularization ) * trace / static_cast< double >( sofa::smax( n, (std::size_t) 1 ) );
+    
+    for( std::size_t i = 0; i < n; i++ )
+    {
+        normal[ i * n + i ] += lambda;
+    }
+    
+    if( CholeskyDecomposition( normal, n ) == false )
+    {
+        SOFA_THROW( "singular least-squares problem (increase the regularization)" );
+    }
+    
+    /// A^T, then solved in place
+    pseudoInverse.resize( n * numRows );
+    
+    for( std::size_t r = 0; r < numRows; r++ )
+    {
+        for( std::size_t i = 0; i < n; i++ )
+        {
+            pseudoInverse[ i * numRows + r ] = matrix[ r * n + i ];
+        }
+    }
+    
+    CholeskySolve( normal, n, &pseudoInverse[0], numRows );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Matrix product
+ *  @param[out]     result : [numRowsA numColumnsB]
+ *  @param[in]      a : [numRowsA numColumnsA]
+ *  @param[in]      b : [numColumnsA numColumnsB]
+ *
+ */
+/************************************************************************************/
+void LinearAlgebra::Multiply(std::vector< double > &result,
+                             const std::vector< double > &a,
+                             const std::vector< double > &b,
+                             const std::size_t numRowsA,
+                             const std::size_t numColumnsA,
+                             const std::size_t numColumnsB)
+{
+    result.assign( numRowsA * numColumnsB, 0.0 );
+    
+    for( std::size_t i = 0; i < numRowsA; i++ )
+    {
+        double *dst = &result[ i * numColumnsB ];
+        
+        for( std::size_t k = 0; k < numColumnsA; k++ )
+        {
+            const double value  = a[ i * numColumnsA + k ];
+            const double *src   = &b[ k * numColumnsB ];
+            
+            for( std::size_t j = 0; j < numColumnsB; j++ )
+            {
+                dst[j] += value * src[j];
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFALinearAlgebra.h
+ *   @brief      Small dense linear algebra routines
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_LINEAR_ALGEBRA_H__
+#define _SOFA_LINEAR_ALGEBRA_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          LinearAlgebra
+     *  @brief          Static class for the (small) least-squares problems of the library
+     *
+     *  @details        Matrices are stored row-major, in std::vector< double >
+     */
+    /************************************************************************************/
+    class SOFA_API LinearAlgebra
+    {
+    public:
+        static bool CholeskyDecomposition(std::vector< double > &matrix,
+                                          const std::size_t size);
+        
+        static void CholeskySolve(const std::vector< double > &decomposition,
+                                  const std::size_t size,
+                                  double *rightHandSides,
+                                  const std::size_t numRightHandSides);
+        
+        static void GetRegularizedPseudoInverse(std::vector< double > &pseudoInverse,
+                                                const std::vector< double > &matrix,
+                                                const std::size_t numRows,
+                                                const std::size_t numColumns,
+                                                const double regularization);
+        
+        static void Multiply(std::vector< double > &result,
+                             const std::vector< double > &a,
+                             const std::vector< double > &b,
+                             const std::size_t numRowsA,
+                             const std::size_t numColumnsA,
+                             const std::size_t numColumnsB);
+        
+    private:
+        LinearAlgebra() SOFA_DELETED_FUNCTION;
+    };
+    
+}
+
+#endif /* _SOFA_LINEAR_ALGEBRA_H__ */
@@ -0,0 +1,514 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMeasurementOrder.cpp
+ *   @brief      Spatially coherent ordering of the measurements
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAMeasurementOrder.h"
+#include "../src/SOFAWriter.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+const std::string MeasurementOrder::OriginalIndexVariableName = "MeasurementOriginalIndex";
+
+namespace sofaLocal
+{
+    /// target size (in bytes) of the HDF5 chunks of the per-measurement variables
+    static const std::size_t kTargetChunkSize = 256 * 1024;
+    
+    /// per-measurement variables smaller than this (in bytes per measurement) keep the default chunking
+    static const std::size_t kMinSlabSizeForChunking = 1024;
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Distance along a Hilbert curve of order log2(n), in a n x n grid
+     *
+     */
+    /************************************************************************************/
+    static unsigned long long hilbertDistance(const unsigned long long n,
+                                              unsigned long long x,
+                                              unsigned long long y)
+    {
+        unsigned long long d = 0;
+        
+        for( unsigned long long s = n / 2; s > 0; s /= 2 )
+        {
+            const unsigned long long rx = ( x & s ) > 0 ? 1 : 0;
+            const unsigned long long ry = ( y & s ) > 0 ? 1 : 0;
+            
+            d += s * s * ( ( 3 * rx ) ^ ry );
+            
+            if( ry == 0 )
+            {
+                if( rx == 1 )
+                {
+                    x = n - 1 - x;
+                    y = n - 1 - y;
+                }
+                
+                std::swap( x, y );
+            }
+        }
+        
+        return d;
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Maps a face coordinate in [-1 1] to a cell of the grid,
+     *                  with the equi-angular projection of the cube-sphere
+     *
+     */
+    /************************************************************************************/
+    static unsigned long long toCell(const double u, const unsigned long long n)
+    {
+        const double a = ( 4.0 / 3.14159265358979323846 ) * atan( u );      ///< in [-1 1]
+        const double c = 0.5 * ( a + 1.0 ) * static_cast< double >( n );
+        
+        const unsigned long long cell = static_cast< unsigned long long >( sofa::smax( 0.0, c ) );
+        
+        return sofa::smin( cell, n - 1 );
+    }
+    
+    struct SortKey
+    {
+        unsigned long long key;
+        std::size_t index;
+        
+        bool operator<(const SortKey &other) const
+        {
+            return key < other.key;
+        }
+    };
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the position of a direction along the cube-sphere Hilbert curve
+ *  @param[in]      x, y, z : cartesian direction (need not be normalized)
+ *  @param[in]      order : order of the Hilbert curve on each face (from 1 to 29)
+ *  @return         the sort key, face * 4^order + hilbert distance on the face
+ *
+ *  @details        The faces are sorted +x, +y, -x, -y, +z, -z so that the four
+ *                  equatorial faces follow the azimuth
+ */
+/************************************************************************************/
+unsigned long long MeasurementOrder::GetCubeSphereHilbertKey(const double x,
+                                                             const double y,
+                                                             const double z,
+                                                             const unsigned int order)
+{
+    if( order < 1 || order > 29 )
+    {
+        SOFA_THROW( "invalid Hilbert curve order" );
+    }
+    
+    const double ax = sofa::FAbs( x );
+    const double ay = sofa::FAbs( y );
+    const double az = sofa::FAbs( z );
+    
+    if( ax == 0.0 && ay == 0.0 && az == 0.0 )
+    {
+        return 0;
+    }
+    
+    unsigned long long face;
+    double u, v;
+    
+    if( ax >= ay && ax >= az )
+    {
+        face = ( x > 0.0 ) ? 0 : 2;
+        u    = ( x > 0.0 ) ? y / ax : -y / ax;
+        v    = z / ax;
+    }
+    else if( ay >= az )
+    {
+        face = ( y > 0.0 ) ? 1 : 3;
+        u    = ( y > 0.0 ) ? -x / ay : x / ay;
+        v    = z / ay;
+    }
+    else
+    {
+        face = ( z > 0.0 ) ? 4 : 5;
+        u    = y / az;
+        v    = ( z > 0.0 ) ? -x / az : x / az;
+    }
+    
+    const unsigned long long n = 1ULL << order;
+    
+    const unsigned long long d = sofaLocal::hilbertDistance( n,
+                                                             sofaLocal::toCell( u, n ),
+                                                             sofaLocal::toCell( v, n ) );
+    
+    return face * n * n + d;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the spatially coherent order of a set of directions
+ *  @param[out]     measurementsOrder : the i-th direction of the sorted set is
+ *                  the measurementsOrder[i]-th input direction
+ *  @param[in]      directions : cartesian directions, [M 3]
+ *  @param[in]      order : order of the Hilbert curve on each face
+ *
+ *  @details        The sort is stable : coincident directions keep their relative order
+ */
+/************************************************************************************/
+void MeasurementOrder::ComputeSpatialOrder(std::vector< std::size_t > &measurementsOrder,
+                                           const std::vector< double > &directions,
+                                           const unsigned int order)
+{
+    if( directions.size() % 3 != 0 )
+    {
+        SOFA_THROW( "directions must be [M 3]" );
+    }
+    
+    const std::size_t M = directions.size() / 3;
+    
+    std::vector< sofaLocal::SortKey > keys( M );
+    
+    for( std::size_t i = 0; i < M; i++ )
+    {
+        keys[i].key   = GetCubeSphereHilbertKey( directions[3 * i + 0],
+                                                 directions[3 * i + 1],
+                                                 directions[3 * i + 2],
+                                                 order );
+        keys[i].index = i;
+    }
+    
+    std::stable_sort( keys.begin(), keys.end() );
+    
+    measurementsOrder.resize( M );
+    
+    for( std::size_t i = 0; i < M; i++ )
+    {
+        measurementsOrder[i] = keys[i].index;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the direction of each measurement, as [M 3] cartesian coordinates
+ *
+ *  @details        The SourcePosition relative to the ListenerPosition is used when it
+ *                  varies across the measurements; otherwise the ListenerView is used
+ *                  (e.g. for head-tracked or rotating-listener measurements)
+ */
+/************************************************************************************/
+void MeasurementOrder::GetMeasurementDirections(const sofa::File &file,
+                                                std::vector< double > &directions)
+{
+    const long M = file.GetNumMeasurements();
+    
+    if( M <= 0 )
+    {
+        SOFA_THROW( "invalid number of measurements" );
+    }
+    
+    std::vector< std::size_t > dims;
+    file.GetVariableDimensions( dims, "SourcePosition" );
+    
+    if( dims.size() == 2 && dims[0] == (std::size_t) M && M > 1 )
+    {
+        if( file.GetSourcePositionAsCartesian( directions ) == false )
+        {
+            SOFA_THROW( "invalid 'SourcePosition' variable" );
+        }
+        
+        std::vector< double > listener;
+        if( file.GetListenerPositionAsCartesian( listener ) == true )
+        {
+            for( std::size_t i = 0; i < directions.size(); i++ )
+            {
+                directions[i] -= listener[i];
+            }
+        }
+        
+        return;
+    }
+    
+    if( file.GetListenerViewAsCartesian( directions ) == true )
+    {
+        return;
+    }
+    
+    SOFA_THROW( "no per-measurement direction found" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the direction of each measurement (see GetMeasurementDirections),
+ *                  as [M 3] unit vectors
+ *
+ *  @details        A null direction is left unchanged
+ */
+/************************************************************************************/
+void MeasurementOrder::GetUnitMeasurementDirections(const sofa::File &file,
+                                                    std::vector< double > &directions)
+{
+    GetMeasurementDirections( file, directions );
+    
+    for( std::size_t i = 0; i + 2 < directions.size(); i += 3 )
+    {
+        double *u = &directions[i];
+        const double norm = std::sqrt( u[0] * u[0] + u[1] * u[1] + u[2] * u[2] );
+        
+        if( norm > 0.0 )
+        {
+            u[0] /= norm;
+            u[1] /= norm;
+            u[2] /= norm;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the index of the direction closest to a direction
+ *  @param[in]      direction : unit vector
+ *  @param[in]      directions : [M 3] unit vectors (at least one)
+ *  @param[out]     dot : if not NULL, the dot product of the two directions
+ *
+ */
+/************************************************************************************/
+std::size_t MeasurementOrder::FindNearestDirection(const double *direction,
+                                                   const std::vector< double > &directions,
+                                                   double *dot)
+{
+    std::size_t nearest = 0;
+    double maxDot       = -2.0;
+    
+    FindNearestDirections( &nearest, &maxDot, 1, direction, directions );
+    
+    if( dot != NULL )
+    {
+        *dot = maxDot;
+    }
+    
+    return nearest;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Finds the directions closest to a direction
+ *  @param[out]     measurements : the numNearest closest directions, the closest first
+ *  @param[out]     dots : their dot products with the direction (decreasing)
+ *  @param[in]      direction : unit vector
+ *  @param[in]      directions : [M 3] unit vectors
+ *  @return         the number of directions found, i.e. min( numNearest, M )
+ *
+ *  @details        This is a linear scan, which does not allocate memory
+ */
+/************************************************************************************/
+std::size_t MeasurementOrder::FindNearestDirections(std::size_t *measurements,
+                                                    double *dots,
+                                                    const std::size_t numNearest,
+                                                    const double *direction,
+                                                    const std::vector< double > &directions)
+{
+    const std::size_t M         = directions.size() / 3;
+    const std::size_t numFound  = sofa::smin( numNearest, M );
+    
+    if( numFound == 0 )
+    {
+        return 0;
+    }
+    
+    for( std::size_t i = 0; i < numFound; i++ )
+    {
+        dots[i]         = -2.0;
+        measurements[i] = 0;
+    }
+    
+    const double *u = direction;
+    
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        const double *v  = &directions[ 3 * m ];
+        const double dot = u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+        
+        if( dot > dots[ numFound - 1 ] )
+        {
+            std::size_t i = numFound - 1;
+            for( ; i > 0 && dot > dots[ i - 1 ]; i-- )
+            {
+                dots[i]         = dots[ i - 1 ];
+                measurements[i] = measurements[ i - 1 ];
+            }
+            dots[i]         = dot;
+            measurements[i] = m;
+        }
+    }
+    
+    return numFound;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a copy of a SOFA file, with the measurements sorted
+ *                  along the cube-sphere Hilbert curve
+ *  @param[in]      source : the file to repack
+ *  @param[in]      outputPath : path of the new file (replaced if it exists)
+ *  @param[in]      order : order of the Hilbert curve on each face
+ *
+ *  @details        All the variables with a leading M dimension (SourcePosition, Data.IR,
+ *                  Data.Delay, ...) are permuted consistently.
+ *                  The per-measurement variables are chunked by groups of neighbouring
+ *                  measurements, so that reading a region of the sphere touches few chunks.
+ *                  The permutation table is stored in 'MeasurementOriginalIndex' [M];
+ *                  when the source file was already reordered, the tables are composed
+ *                  so that the indices still refer to the original acquisition order.
+ */
+/************************************************************************************/
+void MeasurementOrder::Reorder(const sofa::File &source,
+                               const std::string &outputPath,
+                               const unsigned int order)
+{
+    std::vector< double > directions;
+    GetMeasurementDirections( source, directions );
+    
+    std::vector< std::size_t > measurementsOrder;
+    ComputeSpatialOrder( measurementsOrder, directions, order );
+    
+    std::vector< std::size_t > previousIndices;
+    GetOriginalIndices( source, previousIndices );
+    
+    const std::size_t M = measurementsOrder.size();
+    
+    sofa::Writer writer( outputPath );
+    
+    writer.CopyGlobalAttributes( source );
+    writer.UpdateModificationAttributes();
+    writer.CopyDimensions( source );
+    
+    std::vector< std::string > variableNames;
+    source.GetAllVariablesNames( variableNames );
+    
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
+    {
+        const std::string name = variableNames[i];
+        
+        if( name == OriginalIndexVariableName )
+        {
+            continue;
+        }
+        
+        writer.CopyVariableDefinition( source, name );
+        
+        std::vector< std::string > dimNames;
+        source.GetVariableDimensionsNames( dimNames, name );
+        
+        if( dimNames.empty() == true || dimNames[0] != "M" )
+        {
+            writer.CopyVariableValues( source, name );
+            continue;
+        }
+        
+        std::vector< std::size_t > dims;
+        source.GetVariableDimensions( dims, name );
+        
+        std::size_t slabSize = source.GetVariableType( name ).getSize();
+        for( std::size_t j = 1; j < dims.size(); j++ )
+        {
+            slabSize *= dims[j];
+        }
+        
+        if( slabSize >= sofaLocal::kMinSlabSizeForChunking )
+        {
+            std::vector< std::size_t > chunkSizes = dims;
+            chunkSizes[0] = sofa::smin( M, sofa::smax( (std::size_t) 1, sofaLocal::kTargetChunkSize / slabSize ) );
+            
+            writer.SetChunking( name, chunkSizes );
+        }
+        
+        writer.CopyVariableValues( source, name, measurementsOrder );
+    }
+    
+    std::vector< double > originalIndices( M );
+    for( std::size_t i = 0; i < M; i++ )
+    {
+        const std::size_t j = measurementsOrder[i];
+        originalIndices[i]  = static_cast< double >( previousIndices.empty() == false ? previousIndices[j] : j );
+    }
+    
+    writer.AddVariable( OriginalIndexVariableName, std::vector< std::string >( 1, "M" ) );
+    writer.PutVariableAttribute( OriginalIndexVariableName, "LongName", "index of the measurement in the original file" );
+    writer.PutValues( OriginalIndexVariableName, &originalIndices[0] );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the permutation table of a reordered file
+ *  @param[out]     originalIndices : index of each measurement in the original file,
+ *                  or empty if the file was not reordered
+ *
+ */
+/************************************************************************************/
+void MeasurementOrder::GetOriginalIndices(const sofa::File &file,
+                                          std::vector< std::size_t > &originalIndices)
+{
+    originalIndices.clear();
+    
+    if( file.HasVariable( OriginalIndexVariableName ) == false )
+    {
+        return;
+    }
+    
+    std::vector< double > values;
+    if( file.GetValues( values, OriginalIndexVariableName ) == false )
+    {
+        SOFA_THROW( "invalid '" + OriginalIndexVariableName + "' variable" );
+    }
+    
+    originalIndices.resize( values.size() );
+    for( std::size_t i = 0; i < values.size(); i++ )
+    {
+        originalIndices[i] = static_cast< std::size_t >( values[i] );
+    }
+}
@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMeasurementOrder.h
+ *   @brief      Spatially coherent ordering of the measurements
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_MEASUREMENT_ORDER_H__
+#define _SOFA_MEASUREMENT_ORDER_H__
+
+#include "../src/SOFAFile.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          MeasurementOrder
+     *  @brief          Static class to sort the measurements of a SOFA file along
+     *                  a space-filling curve
+     *
+     *  @details        Measurements are usually stored in the order of the acquisition sweep,
+     *                  so that neighbouring directions are far apart in Data.IR.
+     *                  The directions are projected on a cube-sphere (equi-angular mapping),
+     *                  and sorted along a Hilbert curve on each face of the cube.
+     *                  The repacked file stores the original index of each measurement in the
+     *                  'MeasurementOriginalIndex' variable [M].
+     */
+    /************************************************************************************/
+    class SOFA_API MeasurementOrder
+    {
+    public:
+        static const std::string OriginalIndexVariableName;
+        
+    public:
+        static unsigned long long GetCubeSphereHilbertKey(const double x,
+                                                          const double y,
+                                                          const double z,
+                                                          const unsigned int order);
+        
+        static void ComputeSpatialOrder(std::vector< std::size_t > &measurementsOrder,
+                                        const std::vector< double > &directions,
+                                        const unsigned int order = 10);
+        
+        static void GetMeasurementDirections(const sofa::File &file,
+                                             std::vector< double > &directions);
+        
+        static void GetUnitMeasurementDirections(const sofa::File &file,
+                                                 std::vector< double > &directions);
+        
+        static std::size_t FindNearestDirection(const double *direction,
+                                                const std::vector< double > &directions,
+                                                double *dot = NULL);
+        
+        static std::size_t FindNearestDirections(std::size_t *measurements,
+                                                 double *dots,
+                                                 const std::size_t numNearest,
+                                                 const double *direction,
+                                                 const std::vector< double > &directions);
+        
+        static void Reorder(const sofa::File &source,
+                            const std::string &outputPath,
+                            const unsigned int order = 10);
+        
+        static void GetOriginalIndices(const sofa::File &file,
+                                       std::vector< std::size_t > &originalIndices);
+        
+    private:
+        MeasurementOrder() SOFA_DELETED_FUNCTION;
+    };
+    
+}
+
+#endif /* _SOFA_MEASUREMENT_ORDER_H__ */
+
@@ -0,0 +1,607 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMeasurementWriter.cpp
+ *   @brief      Writes a FIR / FIRE file measurement by measurement, with an unlimited M dimension
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAMeasurementWriter.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFANcUtils.h"
+#include "../src/SOFAUtils.h"
+#include "../src/SOFAAttributes.h"
+#include "../src/SOFADate.h"
+#include "../src/SOFASimpleFreeFieldHRIR.h"
+#include "../src/SOFASingleRoomDRIR.h"
+#include <algorithm>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// target number of values of the chunks of the variables depending on M
+    static const std::size_t kChunkNumValues = 4096;
+    
+    static bool HasMeasurementDimension(const netCDF::NcVar &var)
+    {
+        const std::vector< netCDF::NcDim > dims = var.getDims();
+        
+        for( std::size_t i = 0; i < dims.size(); i++ )
+        {
+            if( dims[i].getName() == "M" )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    static std::vector< std::string > MakeDimensions(const std::string &dim1,
+                                                     const std::string &dim2,
+                                                     const std::string &dim3 = "")
+    {
+        std::vector< std::string > dims;
+        dims.push_back( dim1 );
+        dims.push_back( dim2 );
+        if( dim3.empty() == false )
+        {
+            dims.push_back( dim3 );
+        }
+        return dims;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Creates a new file of a FIR convention, without measurements
+ *  @param[in]      path : the file to create (or replace)
+ *  @param[in]      convention : SimpleFreeFieldHRIR (2 receivers at the ears) or
+ *                  SingleRoomDRIR (e.g. the capsules of a microphone array)
+ *  @param[in]      numReceivers : R
+ *  @param[in]      numDataSamples : N
+ *  @param[in]      samplingRate : in Hz
+ *  @param[in]      flushInterval : the file is flushed every flushInterval measurements
+ *                  (0 to only flush with Flush())
+ *
+ *  @details        The listener is at the origin, looking along x. The receivers of a
+ *                  SimpleFreeFieldHRIR file are at +/- 9 cm along y, the ones of a
+ *                  SingleRoomDRIR file at the origin; SourcePosition is spherical.
+ *                  The descriptive attributes (DatabaseName, RoomDescription, ...) can be
+ *                  set with PutGlobalAttribute().
+ */
+/************************************************************************************/
+MeasurementWriter::MeasurementWriter(const std::string &path,
+                                     const sofa::MeasurementWriter::Convention &convention,
+                                     const std::size_t numReceivers,
+                                     const std::size_t numDataSamples,
+                                     const double samplingRate,
+                                     const std::size_t flushInterval_)
+: sofa::Writer( path )
+, numMeasurements( 0 )
+, flushInterval( flushInterval_ )
+{
+    if( convention != kSimpleFreeFieldHRIR && convention != kSingleRoomDRIR )
+    {
+        SOFA_THROW( "invalid convention" );
+    }
+    
+    if( convention == kSimpleFreeFieldHRIR && numReceivers != 2 )
+    {
+        SOFA_THROW( "a SimpleFreeFieldHRIR file has 2 receivers" );
+    }
+    
+    const bool isHRIR = ( convention == kSimpleFreeFieldHRIR );
+    
+    //==============================================================================
+    sofa::Attributes attributes;
+    attributes.ResetToDefault();
+    
+    attributes.Set( sofa::Attributes::kSOFAConventions, isHRIR ? "SimpleFreeFieldHRIR" : "SingleRoomDRIR" );
+    attributes.Set( sofa::Attributes::kSOFAConventionsVersion,
+                    isHRIR ? sofa::SimpleFreeFieldHRIR::GetConventionVersion() : sofa::SingleRoomDRIR::GetConventionVersion() );
+    attributes.Set( sofa::Attributes::kDataType, "FIR" );
+    attributes.Set( sofa::Attributes::kRoomType, isHRIR ? "free field" : "reverberant" );
+    attributes.Set( sofa::Attributes::kDateCreated, sofa::Date::GetCurrentDate().ToISO8601() );
+    
+    for( unsigned int k = 0; k < sofa::Attributes::kNumAttributes; k++ )
+    {
+        const sofa::Attributes::Type attType = static_cast< sofa::Attributes::Type >( k );
+        
+        PutGlobalAttribute( sofa::Attributes::GetName( attType ), attributes.Get( attType ) );
+    }
+    
+    PutGlobalAttribute( isHRIR ? "DatabaseName" : "RoomDescription", "" );
+    
+    UpdateModificationAttributes();
+    
+    //==============================================================================
+    AddDimension( "I", 1 );
+    AddDimension( "C", 3 );
+    AddDimension( "R", numReceivers );
+    AddDimension( "E", 1 );
+    AddDimension( "N", numDataSamples );
+    AddUnlimitedDimension( "M" );
+    
+    AddVariable( "Data.SamplingRate", std::vector< std::string >( 1, "I" ) );
+    PutVariableAttribute( "Data.SamplingRate", "Units", "hertz" );
+    
+    AddVariable( "Data.Delay", sofaLocal::MakeDimensions( "M", "R" ) );
+    AddVariable( "Data.IR", sofaLocal::MakeDimensions( "M", "R", "N" ) );
+    
+    addPositionVariable( "ListenerPosition", sofaLocal::MakeDimensions( "I", "C" ), "cartesian", "meter" );
+    addPositionVariable( "ListenerUp", sofaLocal::MakeDimensions( "I", "C" ), "", "" );
+    addPositionVariable( "ListenerView", sofaLocal::MakeDimensions( "I", "C" ), "cartesian", "meter" );
+    addPositionVariable( "ReceiverPosition", sofaLocal::MakeDimensions( "R", "C", "I" ), "cartesian", "meter" );
+    addPositionVariable( "SourcePosition", sofaLocal::MakeDimensions( "M", "C" ), "spherical", "degree, degree, meter" );
+    
+    if( isHRIR == false )
+    {
+        addPositionVariable( "SourceUp", sofaLocal::MakeDimensions( "I", "C" ), "", "" );
+        addPositionVariable( "SourceView", sofaLocal::MakeDimensions( "I", "C" ), "cartesian", "meter" );
+    }
+    
+    addPositionVariable( "EmitterPosition", sofaLocal::MakeDimensions( "E", "C", "I" ), "cartesian", "meter" );
+    
+    /// the chunk shapes are set before any value is written
+    addVariables( nullptr );
+    setMeasurementChunking();
+    
+    //==============================================================================
+    const double origin[3]  = { 0.0, 0.0, 0.0 };
+    const double up[3]      = { 0.0, 0.0, 1.0 };
+    const double view[3]    = { 1.0, 0.0, 0.0 };
+    
+    std::vector< double > receivers( numReceivers * 3, 0.0 );
+    if( isHRIR == true )
+    {
+        receivers[1] = 0.09;
+        receivers[4] = -0.09;
+    }
+    
+    PutValues( "ListenerPosition", origin );
+    PutValues( "ListenerUp", up );
+    PutValues( "ListenerView", view );
+    PutValues( "ReceiverPosition", &receivers[0] );
+    PutValues( "EmitterPosition", origin );
+    
+    if( isHRIR == false )
+    {
+        PutValues( "SourceUp", up );
+        PutValues( "SourceView", view );
+    }
+    
+    PutValues( "Data.SamplingRate", &samplingRate );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Defines a position (or orientation) variable
+ *  @param[in]      type_, units : the Type and Units attributes (none if empty)
+ *
+ */
+/************************************************************************************/
+void MeasurementWriter::addPositionVariable(const std::string &variableName,
+                                            const std::vector< std::string > &dimensionNames,
+                                            const std::string &type_,
+                                            const std::string &units)
+{
+    AddVariable( variableName, dimensionNames );
+    
+    if( type_.empty() == false )
+    {
+        PutVariableAttribute( variableName, "Type", type_ );
+    }
+    
+    if( units.empty() == false )
+    {
+        PutVariableAttribute( variableName, "Units", units );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Creates a new file from a template file
+ *  @param[in]      templateFile : a FIR or FIRE file of the convention to write (e.g. a
+ *                  SimpleFreeFieldHRIR file with one measurement); its attributes, dimensions
+ *                  (except M) and the variables that do not depend on M are copied;
+ *                  Data.Delay and SourcePosition are always defined along M, and the
+ *                  other variables depending on M must be floating-point (not strings)
+ *  @param[in]      path : the file to create (or replace)
+ *  @param[in]      flushInterval : the file is flushed every flushInterval measurements
+ *                  (0 to only flush with Flush())
+ *
+ */
+/************************************************************************************/
+MeasurementWriter::MeasurementWriter(const sofa::File &templateFile,
+                                     const std::string &path,
+                                     const std::size_t flushInterval_)
+: sofa::Writer( path )
+, numMeasurements( 0 )
+, flushInterval( flushInterval_ )
+{
+    if( templateFile.HasVariable( "Data.IR" ) == false || templateFile.HasDimension( "M" ) == false )
+    {
+        SOFA_THROW( "the template file must be a FIR or FIRE file" );
+    }
+    
+    CopyGlobalAttributes( templateFile );
+    UpdateModificationAttributes();
+    
+    std::vector< std::string > excludedDimensions;
+    excludedDimensions.push_back( "M" );
+    
+    CopyDimensions( templateFile, excludedDimensions );
+    AddUnlimitedDimension( "M" );
+    
+    /// all the definitions (and chunk shapes) come before the first values
+    std::vector< std::string > variableNames;
+    templateFile.GetAllVariablesNames( variableNames );
+    
+    std::vector< std::string > constantVariables;
+    
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
+    {
+        const std::string name = variableNames[i];
+        
+        std::vector< std::string > dimNames;
+        templateFile.GetVariableDimensionsNames( dimNames, name );
+        
+        /// the delays and the source position may change with every measurement
+        if( ( name == "Data.Delay" || name == "SourcePosition" )
+           && dimNames.empty() == false && dimNames[0] == "I" )
+        {
+            dimNames[0] = "M";
+        }
+        
+        CopyVariableDefinition( templateFile, name, dimNames );
+        
+        if( std::find( dimNames.begin(), dimNames.end(), "M" ) == dimNames.end() )
+        {
+            constantVariables.push_back( name );
+        }
+    }
+    
+    addVariables( &templateFile );
+    setMeasurementChunking();
+    
+    for( std::size_t i = 0; i < constantVariables.size(); i++ )
+    {
+        CopyVariableValues( templateFile, constantVariables[i] );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Opens an existing file, to append measurements after its last one
+ *  @param[in]      path : a file whose M dimension is unlimited (e.g. written by a
+ *                  MeasurementWriter)
+ *
+ */
+/************************************************************************************/
+MeasurementWriter::MeasurementWriter(const std::string &path,
+                                     const std::size_t flushInterval_)
+: sofa::Writer( path, netCDF::NcFile::write )
+, numMeasurements( 0 )
+, flushInterval( flushInterval_ )
+{
+    const netCDF::NcDim dim = file.getDim( "M" );
+    
+    if( sofa::NcUtils::IsValid( dim ) == false || dim.isUnlimited() == false )
+    {
+        SOFA_THROW( path + " does not have an unlimited M dimension" );
+    }
+    
+    numMeasurements = dim.getSize();
+    
+    addVariables( nullptr );
+    
+    UpdateModificationAttributes();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Lists the variables depending on M, and reads their default values :
+ *                  the first measurement of the template file, or the last measurement
+ *                  of this file
+ *
+ */
+/************************************************************************************/
+void MeasurementWriter::addVariables(const sofa::NetCDFFile *templateFile)
+{
+    const std::multimap< std::string, netCDF::NcVar > vars = file.getVars();
+    
+    for( std::multimap< std::string, netCDF::NcVar >::const_iterator it = vars.begin();
+        it != vars.end();
+        ++it )
+    {
+        const netCDF::NcVar var = (*it).second;
+        
+        if( sofaLocal::HasMeasurementDimension( var ) == false )
+        {
+            continue;
+        }
+        
+        const netCDF::NcType type_ = var.getType();
+        
+        if( type_ != netCDF::NcType::nc_DOUBLE && type_ != netCDF::NcType::nc_FLOAT )
+        {
+            SOFA_THROW( "'" + (*it).first + "' must be a floating-point variable" );
+        }
+        
+        Variable variable;
+        variable.name = (*it).first;
+        variable.measurementDimension = 0;
+        
+        const std::vector< netCDF::NcDim > dims = var.getDims();
+        
+        std::size_t size = 1;
+        for( std::size_t i = 0; i < dims.size(); i++ )
+        {
+            if( dims[i].getName() == "M" )
+            {
+                variable.measurementDimension = i;
+                variable.dimensions.push_back( 1 );
+            }
+            else
+            {
+                variable.dimensions.push_back( dims[i].getSize() );
+                size *= dims[i].getSize();
+            }
+        }
+        
+        variable.values.assign( size, 0.0 );
+        
+        std::vector< std::size_t > start( dims.size(), 0 );
+        
+        if( templateFile != nullptr )
+        {
+            if( templateFile->GetDimension( "M" ) > 0 )
+            {
+                getSourceVariable( *templateFile, variable.name ).getVar( start, variable.dimensions, &variable.values[0] );
+            }
+        }
+        else if( numMeasurements > 0 )
+        {
+            start[ variable.measurementDimension ] = numMeasurements - 1;
+            var.getVar( start, variable.dimensions, &variable.values[0] );
+        }
+        
+        variables.push_back( variable );
+    }
+    
+    if( findMeasurementVariable( "Data.IR" ) == nullptr )
+    {
+        SOFA_THROW( "Data.IR must depend on M" );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the chunk shape of the variables depending on M (in a new file) :
+ *                  whole records, about kChunkNumValues values per chunk
+ *
+ */
+/************************************************************************************/
+void MeasurementWriter::setMeasurementChunking()
+{
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        const Variable &variable = variables[i];
+        
+        const std::size_t size = sofa::smax( variable.values.size(), (std::size_t) 1 );
+        
+        std::vector< std::size_t > chunkSizes = variable.dimensions;
+        chunkSizes[ variable.measurementDimension ] = sofa::smax( (std::size_t) 1, sofaLocal::kChunkNumValues / size );
+        
+        SetChunking( variable.name, chunkSizes );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of measurements written so far
+ *
+ */
+/************************************************************************************/
+std::size_t MeasurementWriter::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the value of Data.SamplingRate (0 if it is missing,
+ *                  or depends on M)
+ *
+ */
+/************************************************************************************/
+double MeasurementWriter::GetSamplingRate() const
+{
+    if( HasVariable( "Data.SamplingRate" ) == false || HasMeasurementVariable( "Data.SamplingRate" ) == true )
+    {
+        return 0.0;
+    }
+    
+    double samplingRate = 0.0;
+    getVariable( "Data.SamplingRate" ).getVar( std::vector< std::size_t >( 1, 0 ), std::vector< std::size_t >( 1, 1 ), &samplingRate );
+    
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if a variable depends on M
+ *
+ */
+/************************************************************************************/
+bool MeasurementWriter::HasMeasurementVariable(const std::string &variableName) const
+{
+    return findMeasurementVariable( variableName ) != nullptr;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of values of a variable for one measurement
+ *                  (e.g. R x N for the Data.IR of a FIR file)
+ *
+ */
+/************************************************************************************/
+std::size_t MeasurementWriter::GetMeasurementSize(const std::string &variableName) const
+{
+    const Variable *variable = findMeasurementVariable( variableName );
+    
+    if( variable == nullptr )
+    {
+        SOFA_THROW( "'" + variableName + "' does not depend on M" );
+    }
+    
+    return variable->values.size();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the values of a variable for the next measurement
+ *  @param[in]      values : GetMeasurementSize( variableName ) values, in the order of the
+ *                  dimensions of the variable (M excluded)
+ *
+ *  @details        They are written by the next call to AppendMeasurement(), and are kept
+ *                  for the following measurements, until they are set again
+ */
+/************************************************************************************/
+void MeasurementWriter::SetMeasurementValues(const std::string &variableName,
+                                             const double *values)
+{
+    Variable &variable = getMeasurementVariable( variableName );
+    
+    std::copy( values, values + variable.values.size(), variable.values.begin() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes one measurement at the end of the file
+ *  @param[in]      ir : the Data.IR of the measurement ([R N] or [R E N])
+ *  @param[in]      delays : the Data.Delay of the measurement ([R] or [R E]), or nullptr to
+ *                  keep the previous ones; Data.Delay must depend on M
+ *  @param[in]      sourcePosition : the SourcePosition of the measurement ([C]), or nullptr
+ *                  to keep the previous one; SourcePosition must depend on M
+ *
+ *  @details        The other variables depending on M are written with their values set by
+ *                  SetMeasurementValues(), or the previous ones
+ */
+/************************************************************************************/
+void MeasurementWriter::AppendMeasurement(const double *ir,
+                                          const double *delays,
+                                          const double *sourcePosition)
+{
+    if( ir == nullptr )
+    {
+        SOFA_THROW( "missing Data.IR values" );
+    }
+    
+    SetMeasurementValues( "Data.IR", ir );
+    
+    if( delays != nullptr )
+    {
+        SetMeasurementValues( "Data.Delay", delays );
+    }
+    
+    if( sourcePosition != nullptr )
+    {
+        SetMeasurementValues( "SourcePosition", sourcePosition );
+    }
+    
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        const Variable &variable = variables[i];
+        
+        std::vector< std::size_t > start( variable.dimensions.size(), 0 );
+        start[ variable.measurementDimension ] = numMeasurements;
+        
+        PutValues( variable.name, &variable.values[0], start, variable.dimensions );
+    }
+    
+    numMeasurements++;
+    
+    if( flushInterval > 0 && numMeasurements % flushInterval == 0 )
+    {
+        Flush();
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the pending measurements to disk : the file is then complete
+ *
+ */
+/************************************************************************************/
+void MeasurementWriter::Flush()
+{
+    Sync();
+}
+
+sofa::MeasurementWriter::Variable & MeasurementWriter::getMeasurementVariable(const std::string &variableName)
+{
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        if( variables[i].name == variableName )
+        {
+            return variables[i];
+        }
+    }
+    
+    SOFA_THROW( "'" + variableName + "' does not depend on M" );
+}
+
+const sofa::MeasurementWriter::Variable * MeasurementWriter::findMeasurementVariable(const std::string &variableName) const
+{
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        if( variables[i].name == variableName )
+        {
+            return &variables[i];
+        }
+    }
+    
+    return nullptr;
+}
@@ -0,0 +1,167 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMeasurementWriter.h
+ *   @brief      Writes a FIR / FIRE file measurement by measurement, with an unlimited M dimension
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_MEASUREMENT_WRITER_H__
+#define _SOFA_MEASUREMENT_WRITER_H__
+
+#include "../src/SOFAWriter.h"
+#include "../src/SOFAFile.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          MeasurementWriter
+     *  @brief          Writes a FIR or FIRE file one measurement at a time (e.g. from capture
+     *                  software), without knowing the number of measurements in advance
+     *
+     *  @details        M is an unlimited (record) dimension : AppendMeasurement() writes
+     *                  one record of every variable depending on M (Data.IR, Data.Delay,
+     *                  SourcePosition, ...), i.e. a constant amount of I/O per measurement.
+     *                  These variables are chunked along M so that a chunk holds about
+     *                  32 KB, and at least one measurement.
+     *                  The values that are not given for a measurement are the ones of
+     *                  the previous measurement (or of the first measurement of the
+     *                  template file), so that every record is complete.
+     *                  A new file is created from a template file of the same convention
+     *                  (attributes, dimensions and variables that do not depend on M), or
+     *                  as a minimal SimpleFreeFieldHRIR or SingleRoomDRIR file;
+     *                  an existing file with an unlimited M can be reopened to append
+     *                  more measurements.
+     *                  Once at least one measurement is written, the file is valid after
+     *                  every Flush(). HDF5 locks the files open for writing : readers
+     *                  opening the file meanwhile must disable the locking
+     *                  (HDF5_USE_FILE_LOCKING=FALSE).
+     */
+    /************************************************************************************/
+    class SOFA_API MeasurementWriter : public sofa::Writer
+    {
+    public:
+        
+        /// conventions of the files created without a template
+        enum Convention
+        {
+            kSimpleFreeFieldHRIR    = 0,
+            kSingleRoomDRIR         = 1,
+            kNumConventions         = 2
+        };
+        
+    public:
+        MeasurementWriter(const std::string &path,
+                          const sofa::MeasurementWriter::Convention &convention,
+                          const std::size_t numReceivers,
+                          const std::size_t numDataSamples,
+                          const double samplingRate,
+                          const std::size_t flushInterval = 0);
+        
+        MeasurementWriter(const sofa::File &templateFile,
+                          const std::string &path,
+                          const std::size_t flushInterval = 0);
+        
+        MeasurementWriter(const std::string &path,
+                          const std::size_t flushInterval = 0);
+        
+        virtual ~MeasurementWriter() {};
+        
+        //==============================================================================
+        std::size_t GetNumMeasurements() const;
+        
+        double GetSamplingRate() const;
+        
+        bool HasMeasurementVariable(const std::string &variableName) const;
+        
+        std::size_t GetMeasurementSize(const std::string &variableName) const;
+        
+        void SetMeasurementValues(const std::string &variableName,
+                                  const double *values);
+        
+        void AppendMeasurement(const double *ir,
+                               const double *delays = nullptr,
+                               const double *sourcePosition = nullptr);
+        
+        void Flush();
+        
+    protected:
+        //==============================================================================
+        /// a variable with the dimension M
+        struct Variable
+        {
+            std::string name;
+            std::vector< std::size_t > dimensions;  ///< sizes, M excluded (1)
+            std::size_t measurementDimension;       ///< index of M in the dimensions
+            std::vector< double > values;           ///< the values of the next measurement
+        };
+        
+        void addVariables(const sofa::NetCDFFile *templateFile);
+        
+        void setMeasurementChunking();
+        
+        void addPositionVariable(const std::string &variableName,
+                                 const std::vector< std::string > &dimensionNames,
+                                 const std::string &type_,
+                                 const std::string &units);
+        
+        sofa::MeasurementWriter::Variable & getMeasurementVariable(const std::string &variableName);
+        
+        const sofa::MeasurementWriter::Variable * findMeasurementVariable(const std::string &variableName) const;
+        
+    protected:
+        std::vector< Variable > variables;
+        std::size_t numMeasurements;
+        const std::size_t flushInterval;
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( MeasurementWriter );
+    };
+    
+}
+
+#endif /* _SOFA_MEASUREMENT_WRITER_H__ */
@@ -0,0 +1,870 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMicrophoneArrayEncoder.cpp
+ *   @brief      Spherical-harmonic encoding of spherical microphone array responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAMicrophoneArrayEncoder.h"
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAWriter.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// number of samples processed by each call to the radial filters
+    static const std::size_t kBlockSize = 512;
+    
+    /// number of blocks read from / written to the files at once
+    static const std::size_t kNumBlocksPerChunk = 64;
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Spherical Bessel functions of the first and second kind,
+     *                  for the orders 0 to maxOrder (x > 0)
+     *
+     *  @details        j is computed with the downward (Miller) recurrence when x is
+     *                  small compared to the order, where the upward recurrence is unstable
+     */
+    /************************************************************************************/
+    static void computeSphericalBessel(std::vector< double > &j,
+                                       std::vector< double > &y,
+                                       const unsigned int maxOrder,
+                                       const double x)
+    {
+        j.resize( maxOrder + 1 );
+        y.resize( maxOrder + 1 );
+        
+        const double j0 = std::sin( x ) / x;
+        const double j1 = std::sin( x ) / ( x * x ) - std::cos( x ) / x;
+        
+        y[0] = -std::cos( x ) / x;
+        if( maxOrder > 0 )
+        {
+            y[1] = -std::cos( x ) / ( x * x ) - std::sin( x ) / x;
+        }
+        for( unsigned int n = 1; n < maxOrder; n++ )
+        {
+            y[n + 1] = ( 2.0 * n + 1.0 ) / x * y[n] - y[n - 1];
+        }
+        
+        if( x > static_cast< double >( maxOrder ) )
+        {
+            j[0] = j0;
+            if( maxOrder > 0 )
+            {
+                j[1] = j1;
+            }
+            for( unsigned int n = 1; n < maxOrder; n++ )
+            {
+                j[n + 1] = ( 2.0 * n + 1.0 ) / x * j[n] - j[n - 1];
+            }
+            return;
+        }
+        
+        const unsigned int start = maxOrder + 20 + static_cast< unsigned int >( x );
+        
+        std::vector< double > f( start + 2, 0.0 );
+        f[start] = 1e-30;
+        
+        for( unsigned int n = start; n > 0; n-- )
+        {
+            f[n - 1] = ( 2.0 * n + 1.0 ) / x * f[n] - f[n + 1];
+            
+            if( std::fabs( f[n - 1] ) > 1e200 )
+            {
+                for( unsigned int i = n - 1; i <= start; i++ )
+                {
+                    f[i] *= 1e-200;
+                }
+            }
+        }
+        
+        /// normalization with the larger of j0 and j1 (j0 vanishes at x = pi, 2 pi, ...)
+        const double scale = ( std::fabs( j0 ) > std::fabs( j1 ) ) ? j0 / f[0] : j1 / f[1];
+        
+        for( unsigned int n = 0; n <= maxOrder; n++ )
+        {
+            j[n] = f[n] * scale;
+        }
+    }
+    
+    static double getSamplingRate(const sofa::File &file)
+    {
+        std::vector< double > rates;
+        if( file.GetValues( rates, "Data.SamplingRate" ) == false || rates.empty() == true )
+        {
+            SOFA_THROW( "invalid 'Data.SamplingRate' variable" );
+        }
+        
+        return rates[0];
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of an array type
+ *
+ */
+/************************************************************************************/
+std::string MicrophoneArrayEncoder::GetName(const sofa::MicrophoneArrayEncoder::ArrayType &arrayType_)
+{
+    switch( arrayType_ )
+    {
+        case sofa::MicrophoneArrayEncoder::kOpenSphere      : return "open sphere";
+        case sofa::MicrophoneArrayEncoder::kRigidSphere     : return "rigid sphere";
+            
+        default                                             : SOFA_ASSERT( false ); return "";
+        case sofa::MicrophoneArrayEncoder::kNumArrayTypes   : SOFA_ASSERT( false ); return "";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : Setup() must be called before processing
+ *
+ */
+/************************************************************************************/
+MicrophoneArrayEncoder::MicrophoneArrayEncoder()
+: order( 0 )
+, normalization( sofa::SphericalHarmonics::kSN3D )
+, arrayType( kRigidSphere )
+, numReceivers( 0 )
+, arrayRadius( 0.0 )
+, samplingRate( 0.0 )
+, filterLength( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the modal strength b_n(kr) of a plane wave, for the
+ *                  degrees 0 to order (N3D harmonics)
+ *  @param[out]     values : order + 1 values
+ *  @param[in]      kr : wave number times the radius of the array
+ *  @param[in]      arrayType : open or rigid sphere
+ *
+ *  @details        The pressure of a unit plane wave coming from the direction s is
+ *                  sum_n b_n(kr) sum_m Y_nm(x) Y_nm(s), with b_n = i^n j_n(kr) for an open
+ *                  sphere, and b_n = i^n ( j_n - j_n' h_n / h_n' )(kr) for a rigid sphere.
+ *                  The sign conventions match sofa::FFT (a delay T is exp( -i w T ))
+ */
+/************************************************************************************/
+void MicrophoneArrayEncoder::GetModalStrength(std::complex< double > *values,
+                                              const unsigned int order_,
+                                              const double kr,
+                                              const sofa::MicrophoneArrayEncoder::ArrayType &arrayType_)
+{
+    if( kr <= 0.0 )
+    {
+        values[0] = std::complex< double >( 1.0, 0.0 );
+        for( unsigned int n = 1; n <= order_; n++ )
+        {
+            values[n] = std::complex< double >( 0.0, 0.0 );
+        }
+        return;
+    }
+    
+    std::vector< double > j;
+    std::vector< double > y;
+    sofaLocal::computeSphericalBessel( j, y, order_ + 1, kr );
+    
+    const std::complex< double > powersOfI[4] =
+    {
+        std::complex< double >( 1.0, 0.0 ),
+        std::complex< double >( 0.0, 1.0 ),
+        std::complex< double >( -1.0, 0.0 ),
+        std::complex< double >( 0.0, -1.0 )
+    };
+    
+    for( unsigned int n = 0; n <= order_; n++ )
+    {
+        if( arrayType_ == kOpenSphere )
+        {
+            values[n] = powersOfI[ n % 4 ] * j[n];
+        }
+        else
+        {
+            /// derivatives from the recurrence f_n' = n / x f_n - f_{n+1}
+            const double dj = n / kr * j[n] - j[n + 1];
+            const double dy = n / kr * y[n] - y[n + 1];
+            
+            /// with the Wronskian, j_n - j_n' h_n / h_n' = -i / ( x^2 h_n' ), h_n = j_n - i y_n
+            const std::complex< double > dh( dj, -dy );
+            
+            values[n] = powersOfI[ n % 4 ] * std::complex< double >( 0.0, -1.0 ) / ( kr * kr * dh );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the receiver positions of a file, as [R 3] cartesian
+ *                  coordinates relative to the center of the array
+ *
+ *  @details        For a [R C M] ReceiverPosition, the positions of the first
+ *                  measurement are used
+ */
+/************************************************************************************/
+void MicrophoneArrayEncoder::GetReceiverPositions(const sofa::File &file,
+                                                  std::vector< double > &positions)
+{
+    sofa::Coordinates::Type coordinates;
+    sofa::Units::Type units;
+    
+    std::vector< std::size_t > dims;
+    file.GetVariableDimensions( dims, "ReceiverPosition" );
+    
+    std::vector< double > values;
+    
+    if( file.GetReceiverPosition( coordinates, units ) == false
+       || file.GetReceiverPosition( values ) == false
+       || dims.size() != 3 || dims[1] != 3 )
+    {
+        SOFA_THROW( "invalid 'ReceiverPosition' variable" );
+    }
+    
+    const std::size_t R = dims[0];
+    const std::size_t I = dims[2];
+    
+    positions.resize( R * 3 );
+    
+    for( std::size_t r = 0; r < R; r++ )
+    {
+        const double position[3] =
+        {
+            values[ ( r * 3 + 0 ) * I ],
+            values[ ( r * 3 + 1 ) * I ],
+            values[ ( r * 3 + 2 ) * I ]
+        };
+        
+        if( coordinates == sofa::Coordinates::kSpherical )
+        {
+            sofa::SphericalToCartesian( &positions[ r * 3 ], position );
+        }
+        else
+        {
+            positions[ r * 3 + 0 ] = position[0];
+            positions[ r * 3 + 1 ] = position[1];
+            positions[ r * 3 + 2 ] = position[2];
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the encoding matrix and the radial filters
+ *  @param[in]      receiverPositions : [R 3] cartesian positions of the capsules,
+ *                  relative to the center of the array (in metres)
+ *  @param[in]      order : Ambisonic order
+ *  @param[in]      samplingRate : sampling rate of the responses
+ *  @param[in]      arrayType : open or rigid sphere
+ *  @param[in]      normalization : normalization of the Ambisonic channels (ACN ordering)
+ *  @param[in]      maxGainDB : maximum gain of the radial filters
+ *  @param[in]      regularization : Tikhonov parameter of the pseudo-inverse,
+ *                  relative to the energy of the harmonics
+ *  @param[in]      filterLength : length of the radial filters (power of 2)
+ *  @param[in]      speedOfSound : in metres per second
+ *
+ */
+/************************************************************************************/
+void MicrophoneArrayEncoder::Setup(const std::vector< double > &receiverPositions,
+                                   const unsigned int order_,
+                                   const double samplingRate_,
+                                   const sofa::MicrophoneArrayEncoder::ArrayType &arrayType_,
+                                   const sofa::SphericalHarmonics::Normalization &normalization_,
+                                   const double maxGainDB,
+                                   const double regularization,
+                                   const std::size_t filterLength_,
+                                   const double speedOfSound)
+{
+    const std::size_t R = receiverPositions.size() / 3;
+    
+    if( R == 0 || receiverPositions.size() != 3 * R )
+    {
+        SOFA_THROW( "invalid receiver positions" );
+    }
+    
+    if( samplingRate_ <= 0.0 || speedOfSound <= 0.0 )
+    {
+        SOFA_THROW( "invalid sampling rate or speed of sound" );
+    }
+    
+    if( sofa::FFT::IsPowerOfTwo( filterLength_ ) == false || filterLength_ < 4 )
+    {
+        SOFA_THROW( "the length of the radial filters must be a power of 2" );
+    }
+    
+    double radius = 0.0;
+    for( std::size_t r = 0; r < R; r++ )
+    {
+        const double *p = &receiverPositions[ r * 3 ];
+        radius += std::sqrt( p[0] * p[0] + p[1] * p[1] + p[2] * p[2] );
+    }
+    radius /= static_cast< double >( R );
+    
+    if( radius <= 0.0 )
+    {
+        SOFA_THROW( "the receivers must be on a sphere around the origin" );
+    }
+    
+    order           = order_;
+    normalization   = normalization_;
+    arrayType       = arrayType_;
+    numReceivers    = R;
+    arrayRadius     = radius;
+    samplingRate    = samplingRate_;
+    filterLength    = filterLength_;
+    
+    const std::size_t Q = GetNumChannels();
+    
+    //==============================================================================
+    /// projection of the capsules on the N3D harmonics (the modal strengths are defined for N3D)
+    std::vector< double > harmonics;
+    sofa::SphericalHarmonics::GetMatrix( harmonics, receiverPositions, order, sofa::SphericalHarmonics::kN3D );
+    
+    sofa::LinearAlgebra::GetRegularizedPseudoInverse( encodingMatrix, harmonics, R, Q, regularization );
+    
+    if( normalization == sofa::SphericalHarmonics::kSN3D )
+    {
+        for( std::size_t q = 0; q < Q; q++ )
+        {
+            const double scale = 1.0 / std::sqrt( 2.0 * sofa::SphericalHarmonics::GetDegree( q ) + 1.0 );
+            
+            for( std::size_t r = 0; r < R; r++ )
+            {
+                encodingMatrix[ q * R + r ] *= scale;
+            }
+        }
+    }
+    
+    //==============================================================================
+    designRadialFilters( maxGainDB, speedOfSound );
+    
+    convolvers.resize( Q );
+    workspaces.resize( Q );
+    
+    for( std::size_t q = 0; q < Q; q++ )
+    {
+        convolvers[q] = std::make_shared< sofa::Convolver >( sofaLocal::kBlockSize, filterLength );
+        convolvers[q]->SetFilter( GetRadialFilter( sofa::SphericalHarmonics::GetDegree( q ) ), filterLength );
+        
+        workspaces[q].resize( sofaLocal::kBlockSize );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the encoder for the receivers of a file (e.g. SingleRoomDRIR)
+ *
+ */
+/************************************************************************************/
+void MicrophoneArrayEncoder::Setup(const sofa::File &file,
+                                   const unsigned int order_,
+                                   const sofa::MicrophoneArrayEncoder::ArrayType &arrayType_,
+                                   const sofa::SphericalHarmonics::Normalization &normalization_,
+                                   const double maxGainDB,
+                                   const double regularization,
+                                   const std::size_t filterLength_,
+                                   const double speedOfSound)
+{
+    std::vector< double > positions;
+    GetReceiverPositions( file, positions );
+    
+    Setup( positions, order_, sofaLocal::getSamplingRate( file ), arrayType_, normalization_, maxGainDB, regularization, filterLength_, speedOfSound );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Designs the linear-phase radial filters (frequency sampling method)
+ *
+ *  @details        The inverse of the modal strength b is limited with
+ *                  conj( b ) / ( |b|^2 + a ), whose maximum gain is 1 / ( 2 sqrt( a ) )
+ */
+/************************************************************************************/
+void MicrophoneArrayEncoder::designRadialFilters(const double maxGainDB,
+                                                 const double speedOfSound)
+{
+    const std::size_t K = filterLength;
+    const std::size_t B = K / 2 + 1;
+    
+    const double pi         = 3.14159265358979323846;
+    const double maxGain    = std::pow( 10.0, maxGainDB / 20.0 );
+    const double a          = 1.0 / ( 4.0 * maxGain * maxGain );
+    
+    std::vector< std::vector< std::complex< double > > > spectra( order + 1, std::vector< std::complex< double > >( B ) );
+    std::vector< std::complex< double > > modalStrength( order + 1 );
+    
+    for( std::size_t k = 0; k < B; k++ )
+    {
+        const double kr = 2.0 * pi * static_cast< double >( k ) * samplingRate / static_cast< double >( K ) * arrayRadius / speedOfSound;
+        
+        GetModalStrength( &modalStrength[0], order, kr, arrayType );
+        
+        /// delay of K / 2 samples
+        const double delay = ( k % 2 == 0 ) ? 1.0 : -1.0;
+        
+        for( unsigned int n = 0; n <= order; n++ )
+        {
+            const std::complex< double > b = modalStrength[n];
+            
+            spectra[n][k] = delay * std::conj( b ) / ( std::norm( b ) + a );
+        }
+    }
+    
+    const sofa::FFT fft( K );
+    
+    radialFilters.resize( ( order + 1 ) * K );
+    
+    for( unsigned int n = 0; n <= order; n++ )
+    {
+        /// the spectrum of a real filter is real at Nyquist
+        spectra[n][B - 1] = std::complex< double >( spectra[n][B - 1].real(), 0.0 );
+        
+        double *filter = &radialFilters[ n * K ];
+        
+        fft.InverseReal( filter, &spectra[n][0] );
+        
+        /// Hann window, centered on the peak of the filter
+        for( std::size_t i = 0; i < K; i++ )
+        {
+            filter[i] *= 0.5 - 0.5 * std::cos( 2.0 * pi * static_cast< double >( i ) / static_cast< double >( K ) );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the state of the radial filters
+ *
+ */
+/************************************************************************************/
+void MicrophoneArrayEncoder::Reset()
+{
+    for( std::size_t q = 0; q < convolvers.size(); q++ )
+    {
+        convolvers[q]->Reset();
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Encodes consecutive blocks of the receiver signals
+ *  @param[out]     output : [(order+1)^2 numBlocks*GetBlockSize()] Ambisonic signals
+ *  @param[in]      input : [R numBlocks*GetBlockSize()] receiver signals
+ *  @param[in]      numBlocks : number of blocks
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ *  @details        The channels are processed in parallel. For each block, the row of
+ *                  the encoding matrix is accumulated over the receivers (four at a time) with contiguous
+ *                  loops on the samples, then the radial filter of the channel is applied.
+ *                  The output is delayed by GetLatency() samples.
+ */
+/************************************************************************************/
+void MicrophoneArrayEncoder::Process(double *output,
+                                     const double *input,
+                                     const std::size_t numBlocks,
+                                     const unsigned int numThreads)
+{
+    if( convolvers.empty() == true )
+    {
+        SOFA_THROW( "the encoder is not set up" );
+    }
+    
+    const std::size_t R         = numReceivers;
+    const std::size_t Q         = GetNumChannels();
+    const std::size_t B         = sofaLocal::kBlockSize;
+    const std::size_t length    = numBlocks * B;
+    
+    sofa::Threads::ParallelFor( Q,
+                                [&]( const std::size_t q, const unsigned int )
+                                {
+                                    const double *coefficients  = &encodingMatrix[ q * R ];
+                                    double *block               = &workspaces[q][0];
+                                    
+                                    for( std::size_t b = 0; b < numBlocks; b++ )
+                                    {
+                                        std::fill( block, block + B, 0.0 );
+                                        
+                                        /// four receivers per pass, to limit the loads and stores of the block
+                                        std::size_t r = 0;
+                                        for( ; r + 4 <= R; r += 4 )
+                                        {
+                                            const double c0 = coefficients[r];
+                                            const double c1 = coefficients[r + 1];
+                                            const double c2 = coefficients[r + 2];
+                                            const double c3 = coefficients[r + 3];
+                                            
+                                            const double *x0 = input + r * length + b * B;
+                                            const double *x1 = x0 + length;
+                                            const double *x2 = x1 + length;
+                                            const double *x3 = x2 + length;
+                                            
+                                            for( std::size_t i = 0; i < B; i++ )
+                                            {
+                                                block[i] += c0 * x0[i] + c1 * x1[i] + c2 * x2[i] + c3 * x3[i];
+                                            }
+                                        }
+                                        
+                                        for( ; r < R; r++ )
+                                        {
+                                            const double c = coefficients[r];
+                                            const double *x = input + r * length + b * B;
+                                            
+                                            for( std::size_t i = 0; i < B; i++ )
+                                            {
+                                                block[i] += c * x[i];
+                                            }
+                                        }
+                                        
+                                        convolvers[q]->Process( output + q * length + b * B, block );
+                                    }
+                                },
+                                numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Encodes all the measurements of a file, and writes the Ambisonic
+ *                  responses to a new file
+ *  @param[in]      source : a FIR file whose receivers are the capsules the encoder was
+ *                  set up for (e.g. SingleRoomDRIR)
+ *  @param[in]      outputPath : path of the file to create
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ *  @details        The output file is a copy of the source where the receivers are
+ *                  replaced by the (order+1)^2 Ambisonic channels, located at the center
+ *                  of the array. Data.IR carries the 'ChannelOrdering' and 'Normalization'
+ *                  attributes, and the global attribute 'AmbisonicsOrder' is added.
+ *                  The latency of the radial filters is compensated, so that the responses
+ *                  keep the same length and time alignment.
+ *                  The responses are read, encoded and written by chunks of samples,
+ *                  so that responses of any length can be processed.
+ */
+/************************************************************************************/
+void MicrophoneArrayEncoder::Process(const sofa::File &source,
+                                     const std::string &outputPath,
+                                     const unsigned int numThreads)
+{
+    if( source.IsFIRDataType() == false )
+    {
+        SOFA_THROW( "'DataType' shall be FIR" );
+    }
+    
+    const std::size_t M = source.GetNumMeasurements();
+    const std::size_t R = source.GetNumReceivers();
+    const std::size_t N = source.GetNumDataSamples();
+    const std::size_t Q = GetNumChannels();
+    
+    if( convolvers.empty() == true
+       || R != numReceivers
+       || sofaLocal::getSamplingRate( source ) != samplingRate )
+    {
+        SOFA_THROW( "the encoder does not match the receivers of the source file" );
+    }
+    
+    //==============================================================================
+    /// Data.Delay : the receivers of a measurement must share the same delay
+    std::vector< std::size_t > delayDims;
+    source.GetVariableDimensions( delayDims, "Data.Delay" );
+    
+    std::vector< double > delays;
+    if( source.GetValues( delays, "Data.Delay" ) == false
+       || delayDims.size() != 2 || delayDims[1] != R )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' variable" );
+    }
+    
+    const std::size_t numDelays = delayDims[0];
+    
+    std::vector< double > channelDelays( numDelays * Q );
+    for( std::size_t i = 0; i < numDelays; i++ )
+    {
+        for( std::size_t r = 1; r < R; r++ )
+        {
+            if( delays[ i * R + r ] != delays[ i * R ] )
+            {
+                SOFA_THROW( "the receivers of a measurement shall have the same 'Data.Delay'" );
+            }
+        }
+        
+        std::fill( channelDelays.begin() + i * Q, channelDelays.begin() + ( i + 1 ) * Q, delays[ i * R ] );
+    }
+    
+    std::vector< std::string > delayDimNames;
+    source.GetVariableDimensionsNames( delayDimNames, "Data.Delay" );
+    
+    //==============================================================================
+    sofa::Writer writer( outputPath );
+    
+    writer.CopyGlobalAttributes( source );
+    writer.UpdateModificationAttributes();
+    
+    std::ostringstream orderString;
+    orderString << order;
+    writer.PutGlobalAttribute( "AmbisonicsOrder", orderString.str() );
+    
+    writer.CopyDimensions( source, std::vector< std::string >( 1, "R" ) );
+    writer.AddDimension( "R", Q );
+    
+    /// the variables that depend on R are rewritten
+    std::vector< std::string > excluded;
+    
+    std::vector< std::string > variableNames;
+    source.GetAllVariablesNames( variableNames );
+    
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
+    {
+        std::vector< std::string > dimNames;
+        source.GetVariableDimensionsNames( dimNames, variableNames[i] );
+        
+        if( std::find( dimNames.begin(), dimNames.end(), "R" ) != dimNames.end() )
+        {
+            excluded.push_back( variableNames[i] );
+        }
+    }
+    
+    writer.CopyVariables( source, excluded );
+    
+    std::vector< std::string > positionDims;
+    positionDims.push_back( "R" );
+    positionDims.push_back( "C" );
+    positionDims.push_back( "I" );
+    
+    const std::vector< double > positions( Q * 3, 0.0 );
+    
+    writer.AddVariable( "ReceiverPosition", positionDims );
+    writer.PutVariableAttribute( "ReceiverPosition", "Type", "cartesian" );
+    writer.PutVariableAttribute( "ReceiverPosition", "Units", "metre" );
+    writer.PutValues( "ReceiverPosition", &positions[0] );
+    
+    writer.AddVariable( "Data.Delay", delayDimNames );
+    writer.PutValues( "Data.Delay", &channelDelays[0] );
+    
+    std::vector< std::string > irDims;
+    irDims.push_back( "M" );
+    irDims.push_back( "R" );
+    irDims.push_back( "N" );
+    
+    writer.AddVariable( "Data.IR", irDims );
+    writer.PutVariableAttribute( "Data.IR", "ChannelOrdering", "acn" );
+    writer.PutVariableAttribute( "Data.IR", "Normalization", ( normalization == sofa::SphericalHarmonics::kSN3D ) ? "sn3d" : "n3d" );
+    
+    const std::size_t B             = sofaLocal::kBlockSize;
+    const std::size_t chunkLength   = B * sofaLocal::kNumBlocksPerChunk;
+    
+    if( M == 0 || N == 0 )
+    {
+        return;
+    }
+    
+    std::vector< std::size_t > chunkSizes;
+    chunkSizes.push_back( 1 );
+    chunkSizes.push_back( Q );
+    chunkSizes.push_back( sofa::smin( N, chunkLength ) );
+    writer.SetChunking( "Data.IR", chunkSizes );
+    
+    //==============================================================================
+    std::vector< double > input( R * chunkLength );
+    std::vector< double > output( Q * chunkLength );
+    std::vector< double > compact( Q * chunkLength );
+    std::vector< double > block( R * chunkLength );
+    
+    const std::size_t latency = GetLatency();
+    
+    std::vector< std::size_t > start( 3, 0 );
+    std::vector< std::size_t > count( 3 );
+    count[0] = 1;
+    count[1] = Q;
+    
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        Reset();
+        
+        /// the stream is N + latency samples long, the first latency samples being dropped
+        for( std::size_t position = 0; position < N + latency; position += chunkLength )
+        {
+            const std::size_t numRead = ( position < N ) ? sofa::smin( chunkLength, N - position ) : 0;
+            
+            if( numRead > 0 )
+            {
+                if( source.GetDataIRSamples( &block[0], m, position, numRead ) == false )
+                {
+                    SOFA_THROW( "cannot read 'Data.IR'" );
+                }
+            }
+            
+            for( std::size_t r = 0; r < R; r++ )
+            {
+                std::copy( block.begin() + r * numRead, block.begin() + ( r + 1 ) * numRead, input.begin() + r * chunkLength );
+                std::fill( input.begin() + r * chunkLength + numRead, input.begin() + ( r + 1 ) * chunkLength, 0.0 );
+            }
+            
+            Process( &output[0], &input[0], sofaLocal::kNumBlocksPerChunk, numThreads );
+            
+            /// output samples [position - latency, position - latency + chunkLength[
+            const std::size_t first = ( position >= latency ) ? 0 : latency - position;
+            const std::size_t outputStart = position + first - latency;
+            
+            if( first >= chunkLength || outputStart >= N )
+            {
+                continue;
+            }
+            
+            const std::size_t numWritten = sofa::smin( chunkLength - first, N - outputStart );
+            
+            for( std::size_t q = 0; q < Q; q++ )
+            {
+                std::copy( output.begin() + q * chunkLength + first,
+                           output.begin() + q * chunkLength + first + numWritten,
+                           compact.begin() + q * numWritten );
+            }
+            
+            start[0] = m;
+            start[2] = outputStart;
+            count[2] = numWritten;
+            
+            writer.PutValues( "Data.IR", &compact[0], start, count );
+        }
+    }
+}
+
+unsigned int MicrophoneArrayEncoder::GetOrder() const
+{
+    return order;
+}
+
+sofa::SphericalHarmonics::Normalization MicrophoneArrayEncoder::GetNormalization() const
+{
+    return normalization;
+}
+
+sofa::MicrophoneArrayEncoder::ArrayType MicrophoneArrayEncoder::GetArrayType() const
+{
+    return arrayType;
+}
+
+std::size_t MicrophoneArrayEncoder::GetNumChannels() const
+{
+    return sofa::SphericalHarmonics::GetNumCoefficients( order );
+}
+
+std::size_t MicrophoneArrayEncoder::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the mean distance of the receivers to the origin, in metres
+ *
+ */
+/************************************************************************************/
+double MicrophoneArrayEncoder::GetArrayRadius() const
+{
+    return arrayRadius;
+}
+
+double MicrophoneArrayEncoder::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of samples of the blocks given to Process()
+ *
+ */
+/************************************************************************************/
+std::size_t MicrophoneArrayEncoder::GetBlockSize() const
+{
+    return sofaLocal::kBlockSize;
+}
+
+std::size_t MicrophoneArrayEncoder::GetFilterLength() const
+{
+    return filterLength;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the delay (in samples) introduced by the radial filters
+ *
+ */
+/************************************************************************************/
+std::size_t MicrophoneArrayEncoder::GetLatency() const
+{
+    return filterLength / 2;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the [(order+1)^2 R] encoding matrix
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & MicrophoneArrayEncoder::GetEncodingMatrix() const
+{
+    return encodingMatrix;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the radial filter of a degree, GetFilterLength() samples
+ *
+ */
+/************************************************************************************/
+const double * MicrophoneArrayEncoder::GetRadialFilter(const unsigned int degree) const
+{
+    SOFA_ASSERT( degree <= order );
+    
+    return &radialFilters[ degree * filterLength ];
+}
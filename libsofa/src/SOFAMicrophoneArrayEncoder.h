@@ -0,0 +1,179 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMicrophoneArrayEncoder.h
+ *   @brief      Spherical-harmonic encoding of spherical microphone array responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_MICROPHONE_ARRAY_ENCODER_H__
+#define _SOFA_MICROPHONE_ARRAY_ENCODER_H__
+
+#include "../src/SOFAFile.h"
+#include "../src/SOFAConvolver.h"
+#include "../src/SOFASphericalHarmonics.h"
+#include <memory>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          MicrophoneArrayEncoder
+     *  @brief          Converts the R responses of a spherical microphone array
+     *                  (e.g. a SingleRoomDRIR file) to (order+1)^2 Ambisonic responses
+     *
+     *  @details        The receivers are projected on the harmonics with the regularized
+     *                  pseudo-inverse of their [R (order+1)^2] harmonic matrix, and each
+     *                  Ambisonic channel is then equalized by the inverse of the modal
+     *                  strength of its degree (open or rigid sphere), limited to a
+     *                  maximum gain. The radial filters are linear-phase FIR filters :
+     *                  the encoder has a latency of half the filter length, which is
+     *                  compensated when a file is processed.
+     *                  The responses are processed block by block, so that responses
+     *                  of any length (e.g. hour-long capture sessions) are encoded with a
+     *                  bounded amount of memory; the Ambisonic channels are processed
+     *                  in parallel.
+     */
+    /************************************************************************************/
+    class SOFA_API MicrophoneArrayEncoder
+    {
+    public:
+        enum ArrayType
+        {
+            kOpenSphere     = 0,    ///< omnidirectional capsules on an acoustically transparent sphere
+            kRigidSphere    = 1,    ///< omnidirectional capsules flush-mounted on a rigid sphere
+            
+            kNumArrayTypes  = 2
+        };
+        
+        static std::string GetName(const sofa::MicrophoneArrayEncoder::ArrayType &arrayType);
+        
+    public:
+        MicrophoneArrayEncoder();
+        ~MicrophoneArrayEncoder() {};
+        
+        //==============================================================================
+        void Setup(const std::vector< double > &receiverPositions,
+                   const unsigned int order,
+                   const double samplingRate,
+                   const sofa::MicrophoneArrayEncoder::ArrayType &arrayType = kRigidSphere,
+                   const sofa::SphericalHarmonics::Normalization &normalization = sofa::SphericalHarmonics::kSN3D,
+                   const double maxGainDB = 20.0,
+                   const double regularization = 1e-3,
+                   const std::size_t filterLength = 512,
+                   const double speedOfSound = 343.0);
+        
+        void Setup(const sofa::File &file,
+                   const unsigned int order,
+                   const sofa::MicrophoneArrayEncoder::ArrayType &arrayType = kRigidSphere,
+                   const sofa::SphericalHarmonics::Normalization &normalization = sofa::SphericalHarmonics::kSN3D,
+                   const double maxGainDB = 20.0,
+                   const double regularization = 1e-3,
+                   const std::size_t filterLength = 512,
+                   const double speedOfSound = 343.0);
+        
+        static void GetReceiverPositions(const sofa::File &file,
+                                         std::vector< double > &positions);
+        
+        //==============================================================================
+        void Reset();
+        
+        void Process(double *output,
+                     const double *input,
+                     const std::size_t numBlocks,
+                     const unsigned int numThreads = 0);
+        
+        void Process(const sofa::File &source,
+                     const std::string &outputPath,
+                     const unsigned int numThreads = 0);
+        
+        //==============================================================================
+        unsigned int GetOrder() const;
+        sofa::SphericalHarmonics::Normalization GetNormalization() const;
+        sofa::MicrophoneArrayEncoder::ArrayType GetArrayType() const;
+        std::size_t GetNumChannels() const;
+        std::size_t GetNumReceivers() const;
+        double GetArrayRadius() const;
+        double GetSamplingRate() const;
+        std::size_t GetBlockSize() const;
+        std::size_t GetFilterLength() const;
+        std::size_t GetLatency() const;
+        
+        const std::vector< double > & GetEncodingMatrix() const;
+        const double * GetRadialFilter(const unsigned int degree) const;
+        
+        static void GetModalStrength(std::complex< double > *values,
+                                     const unsigned int order,
+                                     const double kr,
+                                     const sofa::MicrophoneArrayEncoder::ArrayType &arrayType);
+        
+    protected:
+        //==============================================================================
+        void designRadialFilters(const double maxGainDB,
+                                 const double speedOfSound);
+        
+    protected:
+        unsigned int order;
+        sofa::SphericalHarmonics::Normalization normalization;
+        sofa::MicrophoneArrayEncoder::ArrayType arrayType;
+        std::size_t numReceivers;
+        double arrayRadius;
+        double samplingRate;
+        std::size_t filterLength;
+        
+        std::vector< double > encodingMatrix;      ///< [(order+1)^2 R]
+        std::vector< double > radialFilters;       ///< [(order+1) filterLength]
+        
+        std::vector< std::shared_ptr< sofa::Convolver > > convolvers;  ///< one per Ambisonic channel
+        std::vector< std::vector< double > > workspaces;               ///< one block per Ambisonic channel
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( MicrophoneArrayEncoder );
+    };
+    
+}
+
+#endif /* _SOFA_MICROPHONE_ARRAY_ENCODER_H__ */
@@ -0,0 +1,329 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMinimumPhase.cpp
+ *   @brief      Minimum-phase + pure delay decomposition of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAMinimumPhase.h"
+#include "../src/SOFADelayEstimation.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// magnitudes are floored at this level below the peak before taking the log
+    static const double kMagnitudeFloor = 1e-10;
+    
+    /// log-magnitude of a null response (the reconstructed response is null)
+    static const double kNullLogMagnitude = -700.0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      length : length of the responses
+ *  @param[in]      oversampling : the FFT size is the next power of two of
+ *                  length x oversampling; a large value limits the time-aliasing of the cepstrum
+ *
+ */
+/************************************************************************************/
+MinimumPhase::MinimumPhase(const std::size_t length_,
+                           const std::size_t oversampling)
+: length( length_ )
+, fft( sofa::FFT::GetNextPowerOfTwo( sofa::smax( (std::size_t) 2, length_ * sofa::smax( (std::size_t) 1, oversampling ) ) ) )
+, spectrum( fft.GetNumBins() )
+, buffer( fft.GetSize() )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the length of the responses
+ *
+ */
+/************************************************************************************/
+std::size_t MinimumPhase::GetLength() const
+{
+    return length;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of bins of the log-magnitude spectra
+ *                  (see GetLogMagnitude() and ProcessLogMagnitude())
+ *
+ */
+/************************************************************************************/
+std::size_t MinimumPhase::GetNumBins() const
+{
+    return fft.GetNumBins();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the minimum-phase response having the same magnitude spectrum
+ *  @param[out]     output : length samples (may be the same buffer as input)
+ *  @param[in]      input : length samples
+ *
+ *  @details        The real cepstrum of the log-magnitude spectrum is folded onto
+ *                  the positive quefrencies, then exponentiated back
+ */
+/************************************************************************************/
+void MinimumPhase::Process(double *output, const double *input)
+{
+    if( computeLogMagnitude( input ) == false )
+    {
+        std::fill( output, output + length, 0.0 );
+        return;
+    }
+    
+    reconstruct( output );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the log-magnitude spectrum of a response
+ *  @param[out]     logMagnitude : GetNumBins() values (natural logarithm)
+ *  @param[in]      input : length samples
+ *
+ *  @details        Spectra can be combined in this domain (e.g. interpolated), and turned
+ *                  back into minimum-phase responses with ProcessLogMagnitude()
+ */
+/************************************************************************************/
+void MinimumPhase::GetLogMagnitude(double *logMagnitude, const double *input)
+{
+    const std::size_t numBins = fft.GetNumBins();
+    
+    if( computeLogMagnitude( input ) == false )
+    {
+        std::fill( logMagnitude, logMagnitude + numBins, sofaLocal::kNullLogMagnitude );
+        return;
+    }
+    
+    for( std::size_t k = 0; k < numBins; k++ )
+    {
+        logMagnitude[k] = spectrum[k].real();
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the minimum-phase response of a log-magnitude spectrum
+ *  @param[out]     output : length samples
+ *  @param[in]      logMagnitude : GetNumBins() values (natural logarithm)
+ *
+ */
+/************************************************************************************/
+void MinimumPhase::ProcessLogMagnitude(double *output, const double *logMagnitude)
+{
+    const std::size_t numBins = fft.GetNumBins();
+    
+    for( std::size_t k = 0; k < numBins; k++ )
+    {
+        spectrum[k] = std::complex< double >( logMagnitude[k], 0.0 );
+    }
+    
+    reconstruct( output );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Stores the floored log-magnitude spectrum of a response in spectrum
+ *  @return         false if the response is null
+ *
+ */
+/************************************************************************************/
+bool MinimumPhase::computeLogMagnitude(const double *input)
+{
+    const std::size_t half = fft.GetSize() / 2;
+    
+    std::copy( input, input + length, buffer.begin() );
+    std::fill( buffer.begin() + length, buffer.end(), 0.0 );
+    
+    fft.ForwardReal( &spectrum[0], &buffer[0] );
+    
+    double peak = 0.0;
+    for( std::size_t k = 0; k <= half; k++ )
+    {
+        peak = sofa::smax( peak, std::abs( spectrum[k] ) );
+    }
+    
+    if( peak == 0.0 )
+    {
+        return false;
+    }
+    
+    const double floor_ = peak * sofaLocal::kMagnitudeFloor;
+    
+    for( std::size_t k = 0; k <= half; k++ )
+    {
+        spectrum[k] = std::complex< double >( std::log( sofa::smax( floor_, std::abs( spectrum[k] ) ) ), 0.0 );
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Turns the log-magnitude spectrum held in spectrum into a
+ *                  minimum-phase response
+ *
+ */
+/************************************************************************************/
+void MinimumPhase::reconstruct(double *output)
+{
+    const std::size_t half = fft.GetSize() / 2;
+    
+    /// real cepstrum
+    fft.InverseReal( &buffer[0], &spectrum[0] );
+    
+    /// fold the anticausal part onto the causal part
+    for( std::size_t n = 1; n < half; n++ )
+    {
+        buffer[n] *= 2.0;
+    }
+    std::fill( buffer.begin() + half + 1, buffer.end(), 0.0 );
+    
+    fft.ForwardReal( &spectrum[0], &buffer[0] );
+    
+    for( std::size_t k = 0; k <= half; k++ )
+    {
+        spectrum[k] = std::exp( spectrum[k] );
+    }
+    
+    fft.InverseReal( &buffer[0], &spectrum[0] );
+    
+    std::copy( buffer.begin(), buffer.begin() + length, output );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Estimates the onset of a response (see DelayEstimation::GetOnset())
+ *  @param[in]      thresholdDB : threshold, in dB below the peak
+ *  @return         the onset, in (fractional) samples
+ *
+ */
+/************************************************************************************/
+double MinimumPhase::EstimateOnset(const double *input,
+                                   const std::size_t length_,
+                                   const double thresholdDB)
+{
+    return sofa::DelayEstimation::GetOnset( input, length_, thresholdDB );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Replaces every response of a set by its minimum-phase version
+ *  @param[in]      responses : the set to process
+ *  @param[in]      delayMode : whether the estimated onsets are added to the delays
+ *  @param[in]      thresholdDB : onset threshold, in dB below the peak of each response
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ */
+/************************************************************************************/
+void MinimumPhase::Process(sofa::ImpulseResponses &responses,
+                           const sofa::MinimumPhase::DelayMode &delayMode,
+                           const double thresholdDB,
+                           const unsigned int numThreads)
+{
+    const std::size_t N             = responses.GetNumDataSamples();
+    const std::size_t numResponses  = responses.GetNumResponses();
+    
+    if( N == 0 || numResponses == 0 )
+    {
+        return;
+    }
+    
+    const unsigned int numWorkers = sofa::Threads::GetNumThreads( numThreads );
+    
+    /// one workspace per thread
+    std::vector< std::shared_ptr< sofa::MinimumPhase > > workspaces( numWorkers );
+    for( unsigned int t = 0; t < numWorkers; t++ )
+    {
+        workspaces[t] = std::make_shared< sofa::MinimumPhase >( N );
+    }
+    
+    sofa::Threads::ParallelFor( numResponses,
+                                [&]( const std::size_t i, const unsigned int threadIndex )
+                                {
+                                    double *response = responses.GetResponse( i );
+                                    
+                                    if( delayMode == kEstimateOnset )
+                                    {
+                                        const double onset = EstimateOnset( response, N, thresholdDB );
+                                        responses.SetDelay( i, responses.GetDelay( i ) + onset );
+                                    }
+                                    
+                                    workspaces[ threadIndex ]->Process( response, response );
+                                },
+                                numWorkers );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a copy of a FIR or FIRE file, where Data.IR holds the minimum-phase
+ *                  responses and Data.Delay [M R] (or [M R E]) the pure delays
+ *
+ */
+/************************************************************************************/
+void MinimumPhase::Process(const sofa::File &source,
+                           const std::string &outputPath,
+                           const sofa::MinimumPhase::DelayMode &delayMode,
+                           const double thresholdDB,
+                           const unsigned int numThreads)
+{
+    sofa::ImpulseResponses responses;
+    responses.Load( source );
+    
+    Process( responses, delayMode, thresholdDB, numThreads );
+    
+    responses.Write( source, outputPath );
+}
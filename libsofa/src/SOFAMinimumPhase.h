@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMinimumPhase.h
+ *   @brief      Minimum-phase + pure delay decomposition of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_MINIMUM_PHASE_H__
+#define _SOFA_MINIMUM_PHASE_H__
+
+#include "../src/SOFAImpulseResponses.h"
+#include "../src/SOFAFFT.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          MinimumPhase
+     *  @brief          Computes the minimum-phase version of impulse responses,
+     *                  with the homomorphic (cepstral) method
+     *
+     *  @details        An object holds the FFT tables and the buffers for one response
+     *                  length, and must not be shared between threads.
+     *                  The static Process() methods decompose a whole set of responses
+     *                  into minimum-phase filters (Data.IR) and pure delays (Data.Delay),
+     *                  spreading the responses over several threads.
+     */
+    /************************************************************************************/
+    class SOFA_API MinimumPhase
+    {
+    public:
+        
+        enum DelayMode
+        {
+            kKeepDataDelay      = 0,    ///< the delays are the ones of Data.Delay
+            kEstimateOnset      = 1,    ///< the onset of each response is added to Data.Delay
+            kNumDelayModes      = 2
+        };
+        
+    public:
+        MinimumPhase(const std::size_t length,
+                     const std::size_t oversampling = 8);
+        
+        ~MinimumPhase() {};
+        
+        std::size_t GetLength() const;
+        std::size_t GetNumBins() const;
+        
+        void Process(double *output, const double *input);
+        
+        void GetLogMagnitude(double *logMagnitude, const double *input);
+        void ProcessLogMagnitude(double *output, const double *logMagnitude);
+        
+        //==============================================================================
+        static double EstimateOnset(const double *input,
+                                    const std::size_t length,
+                                    const double thresholdDB = -20.0);
+        
+        static void Process(sofa::ImpulseResponses &responses,
+                            const sofa::MinimumPhase::DelayMode &delayMode = kEstimateOnset,
+                            const double thresholdDB = -20.0,
+                            const unsigned int numThreads = 0);
+        
+        static void Process(const sofa::File &source,
+                            const std::string &outputPath,
+                            const sofa::MinimumPhase::DelayMode &delayMode = kEstimateOnset,
+                            const double thresholdDB = -20.0,
+                            const unsigned int numThreads = 0);
+        
+    protected:
+        //==============================================================================
+        bool computeLogMagnitude(const double *input);
+        void reconstruct(double *output);
+        
+    protected:
+        const std::size_t length;
+        const sofa::FFT fft;
+        std::vector< std::complex< double > > spectrum;
+        std::vector< double > buffer;
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( MinimumPhase );
+    };
+    
+}
+
+#endif /* _SOFA_MINIMUM_PHASE_H__ */
@@ -0,0 +1,414 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMorphing.cpp
+ *   @brief      Blending of the HRTF sets of two files, direction by direction
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAMorphing.h"
+#include "../src/SOFAMeasurementOrder.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// resolution of the blend factor
+    static const std::size_t kNumBlendSteps = 256;
+    
+    /// the cepstrum is computed with a FFT of ( at least ) this times the filter length
+    static const std::size_t kOversampling = 4;
+    
+    /// onset threshold, in dB below the peak of each response
+    static const double kOnsetThresholdDB = -20.0;
+    
+    /// default number of blended directions kept in the cache
+    static const std::size_t kDefaultCacheSize = 4096;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+Morphing::Morphing()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, filterLength( 0 )
+, numBins( 0 )
+, samplingRate( 0.0 )
+, blendStep( 0 )
+, cacheSize( sofaLocal::kDefaultCacheSize )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Decomposes the responses of two files
+ *  @param[in]      file1 : FIR file with one emitter (e.g. SimpleFreeFieldHRIR), blend 0
+ *  @param[in]      file2 : FIR file with one emitter, the same number of receivers and
+ *                  the same sampling rate, blend 1
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ *  @details        The blend is reset to 0, and the cache is cleared
+ */
+/************************************************************************************/
+void Morphing::Load(const sofa::File &file1,
+                    const sofa::File &file2,
+                    const unsigned int numThreads)
+{
+    sofa::ImpulseResponses responses[2];
+    responses[0].Load( file1 );
+    responses[1].Load( file2 );
+    
+    for( std::size_t f = 0; f < 2; f++ )
+    {
+        if( responses[f].GetNumEmitters() != 1 || responses[f].GetNumMeasurements() == 0 )
+        {
+            SOFA_THROW( "the responses must have one emitter, and at least one measurement" );
+        }
+    }
+    
+    if( responses[0].GetNumReceivers() != responses[1].GetNumReceivers() )
+    {
+        SOFA_THROW( "the files do not have the same number of receivers" );
+    }
+    
+    if( responses[0].GetSamplingRate() != responses[1].GetSamplingRate() )
+    {
+        SOFA_THROW( "the files do not have the same sampling rate (see sofa::Resampler)" );
+    }
+    
+    cache.clear();
+    recentlyUsed.clear();
+    blendStep = 0;
+    
+    numMeasurements = responses[0].GetNumMeasurements();
+    numReceivers    = responses[0].GetNumReceivers();
+    filterLength    = sofa::smax( responses[0].GetNumDataSamples(), responses[1].GetNumDataSamples() );
+    samplingRate    = responses[0].GetSamplingRate();
+    
+    minimumPhase.reset( new sofa::MinimumPhase( filterLength, sofaLocal::kOversampling ) );
+    numBins = minimumPhase->GetNumBins();
+    workspace.resize( numBins );
+    
+    //==============================================================================
+    /// measurements of the second file matched to the directions of the first one
+    std::vector< double > directions2;
+    sofa::MeasurementOrder::GetUnitMeasurementDirections( file1, directions );
+    sofa::MeasurementOrder::GetUnitMeasurementDirections( file2, directions2 );
+    
+    const std::size_t M2 = responses[1].GetNumMeasurements();
+    
+    matches.resize( numMeasurements );
+    
+    sofa::Threads::ParallelFor( numMeasurements,
+                                [&]( const std::size_t m, const unsigned int )
+                                {
+                                    const double *u = &directions[ 3 * m ];
+                                    
+                                    /// same grid : same index
+                                    if( m < M2 )
+                                    {
+                                        const double *v = &directions2[ 3 * m ];
+                                        
+                                        if( u[0] * v[0] + u[1] * v[1] + u[2] * v[2] > 1.0 - 1e-9 )
+                                        {
+                                            matches[m] = m;
+                                            return;
+                                        }
+                                    }
+                                    
+                                    matches[m] = sofa::MeasurementOrder::FindNearestDirection( u, directions2 );
+                                },
+                                numThreads );
+    
+    //==============================================================================
+    /// log-magnitudes and delays of the responses used
+    const unsigned int numWorkers = sofa::Threads::GetNumThreads( numThreads );
+    
+    /// one workspace per thread
+    std::vector< std::shared_ptr< sofa::MinimumPhase > > workspaces( numWorkers );
+    std::vector< std::vector< double > > buffers( numWorkers, std::vector< double >( filterLength, 0.0 ) );
+    for( unsigned int t = 0; t < numWorkers; t++ )
+    {
+        workspaces[t] = std::make_shared< sofa::MinimumPhase >( filterLength, sofaLocal::kOversampling );
+    }
+    
+    logMagnitudes.resize( 2 * numMeasurements * numReceivers * numBins );
+    delays.resize( 2 * numMeasurements * numReceivers );
+    
+    sofa::Threads::ParallelFor( 2 * numMeasurements * numReceivers,
+                                [&]( const std::size_t i, const unsigned int threadIndex )
+                                {
+                                    const std::size_t f = i / ( numMeasurements * numReceivers );
+                                    const std::size_t m = ( i / numReceivers ) % numMeasurements;
+                                    const std::size_t r = i % numReceivers;
+                                    
+                                    const sofa::ImpulseResponses &source = responses[f];
+                                    const std::size_t index   = source.GetResponseIndex( ( f == 0 ) ? m : matches[m], r );
+                                    const std::size_t N       = source.GetNumDataSamples();
+                                    const double *response    = source.GetResponse( index );
+                                    
+                                    std::vector< double > &buffer = buffers[ threadIndex ];
+                                    std::copy( response, response + N, buffer.begin() );
+                                    std::fill( buffer.begin() + N, buffer.end(), 0.0 );
+                                    
+                                    delays[i] = source.GetDelay( index ) + sofa::MinimumPhase::EstimateOnset( &buffer[0], filterLength, sofaLocal::kOnsetThresholdDB );
+                                    
+                                    workspaces[ threadIndex ]->GetLogMagnitude( &logMagnitudes[ i * numBins ], &buffer[0] );
+                                },
+                                numWorkers );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the blend factor
+ *  @param[in]      blend : 0 for the first file, 1 for the second file
+ *
+ *  @details        The filters of each direction are blended again when they are requested
+ */
+/************************************************************************************/
+void Morphing::SetBlend(const double blend)
+{
+    const double clipped = sofa::smax( 0.0, sofa::smin( 1.0, blend ) );
+    
+    blendStep = static_cast< std::size_t >( clipped * static_cast< double >( sofaLocal::kNumBlendSteps ) + 0.5 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the blend factor, as quantized
+ *
+ */
+/************************************************************************************/
+double Morphing::GetBlend() const
+{
+    return static_cast< double >( blendStep ) / static_cast< double >( sofaLocal::kNumBlendSteps );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the maximum number of blended directions kept in memory
+ *                  (at least 1)
+ *
+ */
+/************************************************************************************/
+void Morphing::SetCacheSize(const std::size_t numEntries)
+{
+    cacheSize = sofa::smax( numEntries, (std::size_t) 1 );
+    
+    while( cache.size() > cacheSize )
+    {
+        cache.erase( recentlyUsed.back() );
+        recentlyUsed.pop_back();
+    }
+}
+
+std::size_t Morphing::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+std::size_t Morphing::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t Morphing::GetFilterLength() const
+{
+    return filterLength;
+}
+
+double Morphing::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of distinct blend factors
+ *
+ */
+/************************************************************************************/
+std::size_t Morphing::GetNumBlendSteps()
+{
+    return sofaLocal::kNumBlendSteps;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement of the first file closest to a direction
+ *  @param[in]      azimuth : in degrees
+ *  @param[in]      elevation : in degrees
+ *
+ */
+/************************************************************************************/
+std::size_t Morphing::GetNearestMeasurement(const double azimuth,
+                                            const double elevation) const
+{
+    const double aed[3] = { azimuth, elevation, 1.0 };
+    double u[3];
+    sofa::SphericalToCartesian( u, aed );
+    
+    return sofa::MeasurementOrder::FindNearestDirection( u, directions );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement of the second file blended with a measurement
+ *                  of the first file
+ *
+ */
+/************************************************************************************/
+std::size_t Morphing::GetMatchedMeasurement(const std::size_t measurement) const
+{
+    SOFA_ASSERT( measurement < numMeasurements );
+    
+    return matches[ measurement ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the blended minimum-phase filter of a direction
+ *  @return         GetFilterLength() samples, valid until the entry is evicted from the
+ *                  cache (i.e. after as many other directions or blends as the cache size)
+ *
+ */
+/************************************************************************************/
+const double * Morphing::GetFilter(const std::size_t measurement,
+                                   const std::size_t receiver)
+{
+    SOFA_ASSERT( receiver < numReceivers );
+    
+    return &getEntry( measurement ).filters[ receiver * filterLength ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the blended delay of a direction, in samples
+ *
+ */
+/************************************************************************************/
+double Morphing::GetDelay(const std::size_t measurement,
+                          const std::size_t receiver)
+{
+    SOFA_ASSERT( receiver < numReceivers );
+    
+    return getEntry( measurement ).delays[ receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the cache entry of a direction for the current blend,
+ *                  computing it if needed
+ *
+ */
+/************************************************************************************/
+const sofa::Morphing::Entry & Morphing::getEntry(const std::size_t measurement)
+{
+    if( measurement >= numMeasurements )
+    {
+        SOFA_THROW( "invalid measurement" );
+    }
+    
+    const std::size_t key = measurement * ( sofaLocal::kNumBlendSteps + 1 ) + blendStep;
+    
+    std::unordered_map< std::size_t, Entry >::iterator found = cache.find( key );
+    
+    if( found != cache.end() )
+    {
+        recentlyUsed.splice( recentlyUsed.begin(), recentlyUsed, found->second.position );
+        return found->second;
+    }
+    
+    //==============================================================================
+    /// the least recently used entry is recycled
+    Entry entry;
+    
+    if( cache.size() >= cacheSize )
+    {
+        std::unordered_map< std::size_t, Entry >::iterator oldest = cache.find( recentlyUsed.back() );
+        
+        entry.filters.swap( oldest->second.filters );
+        entry.delays.swap( oldest->second.delays );
+        
+        cache.erase( oldest );
+        recentlyUsed.pop_back();
+    }
+    
+    entry.filters.resize( numReceivers * filterLength );
+    entry.delays.resize( numReceivers );
+    
+    const double alpha          = GetBlend();
+    const std::size_t offset    = numMeasurements * numReceivers;
+    
+    for( std::size_t r = 0; r < numReceivers; r++ )
+    {
+        const std::size_t i1 = measurement * numReceivers + r;
+        const std::size_t i2 = offset + i1;
+        
+        const double *log1 = &logMagnitudes[ i1 * numBins ];
+        const double *log2 = &logMagnitudes[ i2 * numBins ];
+        
+        for( std::size_t k = 0; k < numBins; k++ )
+        {
+            workspace[k] = log1[k] + alpha * ( log2[k] - log1[k] );
+        }
+        
+        minimumPhase->ProcessLogMagnitude( &entry.filters[ r * filterLength ], &workspace[0] );
+        
+        entry.delays[r] = delays[ i1 ] + alpha * ( delays[ i2 ] - delays[ i1 ] );
+    }
+    
+    recentlyUsed.push_front( key );
+    entry.position = recentlyUsed.begin();
+    
+    return cache.insert( std::make_pair( key, std::move( entry ) ) ).first->second;
+}
@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMorphing.h
+ *   @brief      Blending of the HRTF sets of two files, direction by direction
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_MORPHING_H__
+#define _SOFA_MORPHING_H__
+
+#include "../src/SOFAMinimumPhase.h"
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Morphing
+     *  @brief          Blends the HRTF sets of two files (e.g. SimpleFreeFieldHRIR of two
+     *                  subjects), with a blend factor that can change at control rate
+     *
+     *  @details        Load() decomposes every response of both files into a log-magnitude
+     *                  spectrum and a delay (onset + Data.Delay). The measurements of the
+     *                  second file are matched to the directions of the first one (same
+     *                  index for identical grids, nearest neighbour otherwise).
+     *                  A blended filter is only computed when it is requested : the
+     *                  log-magnitudes are interpolated, the result is turned into a
+     *                  minimum-phase filter, and the delays are interpolated linearly.
+     *                  The blend factor is quantized to 1 / GetNumBlendSteps(), and the
+     *                  blended filters are kept in a least-recently-used cache, so that
+     *                  moving the blend back and forth does not compute them again.
+     *                  An object must not be shared between threads.
+     */
+    /************************************************************************************/
+    class SOFA_API Morphing
+    {
+    public:
+        Morphing();
+        ~Morphing() {};
+        
+        //==============================================================================
+        void Load(const sofa::File &file1,
+                  const sofa::File &file2,
+                  const unsigned int numThreads = 0);
+        
+        void SetBlend(const double blend);
+        double GetBlend() const;
+        
+        void SetCacheSize(const std::size_t numEntries);
+        
+        //==============================================================================
+        std::size_t GetNumMeasurements() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetFilterLength() const;
+        double GetSamplingRate() const;
+        
+        static std::size_t GetNumBlendSteps();
+        
+        std::size_t GetNearestMeasurement(const double azimuth,
+                                          const double elevation) const;
+        
+        std::size_t GetMatchedMeasurement(const std::size_t measurement) const;
+        
+        //==============================================================================
+        const double * GetFilter(const std::size_t measurement,
+                                 const std::size_t receiver);
+        
+        double GetDelay(const std::size_t measurement,
+                        const std::size_t receiver);
+        
+    protected:
+        //==============================================================================
+        /// the blended filters [R filterLength] and delays [R] of one direction
+        struct Entry
+        {
+            std::vector< double > filters;
+            std::vector< double > delays;
+            std::list< std::size_t >::iterator position;    ///< in the LRU list
+        };
+        
+        const sofa::Morphing::Entry & getEntry(const std::size_t measurement);
+        
+    protected:
+        std::size_t numMeasurements;
+        std::size_t numReceivers;
+        std::size_t filterLength;
+        std::size_t numBins;
+        double samplingRate;
+        
+        std::vector< double > directions;                   ///< [M 3] unit vectors of the first file
+        std::vector< std::size_t > matches;                 ///< [M] measurement of the second file
+        std::vector< double > logMagnitudes;                ///< [2 M R numBins]
+        std::vector< double > delays;                       ///< [2 M R]
+        
+        std::size_t blendStep;                              ///< in [0 GetNumBlendSteps()]
+        std::size_t cacheSize;
+        std::unordered_map< std::size_t, sofa::Morphing::Entry > cache;   ///< by measurement and blend step
+        std::list< std::size_t > recentlyUsed;              ///< cache keys, the most recent first
+        
+        std::unique_ptr< sofa::MinimumPhase > minimumPhase;
+        std::vector< double > workspace;                    ///< numBins
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( Morphing );
+    };
+    
+}
+
+#endif /* _SOFA_MORPHING_H__ */
@@ -291,7 +291,9 @@ bool MultiSpeakerBRIR::GetDataIR(double *values,
                                  const unsigned long dim3,
                                  const unsigned long dim4) const
 {
-    return NetCDFFile::GetValues( values, dim1, dim2, dim3, dim4, "Data.IR" );
+    /// Data.IR is [ M R N E ]
+    
+    return sofa::File::getDataIR( values, dim1, dim2, dim3, dim4 );
 }
 
 
@@ -55,6 +55,7 @@ http://www.sofaconventions.org
 
 namespace sofa
 {
+    class Writer;
     
     /************************************************************************************/
     /*!
@@ -193,6 +194,9 @@ namespace sofa
         netCDF::NcFile file;
         const std::string filename;
         
+        /// the writer copies definitions and values straight from the source NcFile
+        friend class sofa::Writer;
+        
     private:
         //==============================================================================
         /// avoid shallow and copy constructor
@@ -0,0 +1,522 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAOrientationIndex.cpp
+ *   @brief      Lookup of measurements by head orientation
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAOrientationIndex.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    struct AngleComparator
+    {
+        AngleComparator(const std::vector< double > &angles_) : angles( angles_ ) {}
+        
+        bool operator()(const std::size_t a, const std::size_t b) const
+        {
+            return angles[a] < angles[b];
+        }
+        
+        const std::vector< double > &angles;
+    };
+    
+    static void AddNeighbour(sofa::OrientationIndex::Neighbours &neighbours,
+                             const std::size_t measurement,
+                             const double weight)
+    {
+        if( weight <= 0.0 )
+        {
+            return;
+        }
+        
+        for( std::size_t i = 0; i < neighbours.numNeighbours; i++ )
+        {
+            if( neighbours.measurements[i] == measurement )
+            {
+                neighbours.weights[i] += weight;
+                return;
+            }
+        }
+        
+        SOFA_ASSERT( neighbours.numNeighbours < sofa::OrientationIndex::Neighbours::kMaxNeighbours );
+        
+        neighbours.measurements[ neighbours.numNeighbours ] = measurement;
+        neighbours.weights[ neighbours.numNeighbours ]      = weight;
+        neighbours.numNeighbours++;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : an empty index
+ *
+ */
+/************************************************************************************/
+OrientationIndex::OrientationIndex()
+: pitchTolerance( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Wraps an angle to [-180 180[ degrees
+ *
+ */
+/************************************************************************************/
+double OrientationIndex::WrapAngle(const double angle)
+{
+    double wrapped = std::fmod( angle + 180.0, 360.0 );
+    
+    if( wrapped < 0.0 )
+    {
+        wrapped += 360.0;
+    }
+    
+    return wrapped - 180.0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Builds the index from the orientations of the measurements
+ *  @param[in]      yaws : [M] yaw of each measurement, in degrees
+ *  @param[in]      pitches : [M] pitch of each measurement, in degrees
+ *  @param[in]      pitchTolerance : measurements whose pitches differ by less than this
+ *                  value (in degrees) belong to the same row
+ *
+ *  @details        The responses previously loaded are released
+ */
+/************************************************************************************/
+void OrientationIndex::Build(const std::vector< double > &yaws_,
+                             const std::vector< double > &pitches_,
+                             const double pitchTolerance_)
+{
+    if( yaws_.size() != pitches_.size() )
+    {
+        SOFA_THROW( "yaws and pitches must have the same size" );
+    }
+    
+    const std::size_t M = yaws_.size();
+    
+    yaws.resize( M );
+    pitches.resize( M );
+    directions.resize( 3 * M );
+    rows.clear();
+    responses       = sofa::ImpulseResponses();
+    pitchTolerance  = sofa::FAbs( pitchTolerance_ );
+    
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        yaws[m]     = WrapAngle( yaws_[m] );
+        pitches[m]  = sofa::smax( -90.0, sofa::smin( 90.0, pitches_[m] ) );
+        
+        const double aed[3] = { yaws[m], pitches[m], 1.0 };
+        sofa::SphericalToCartesian( &directions[ 3 * m ], aed );
+    }
+    
+    //==============================================================================
+    /// group the measurements by pitch
+    std::vector< std::size_t > order( M );
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        order[m] = m;
+    }
+    
+    std::stable_sort( order.begin(), order.end(), sofaLocal::AngleComparator( pitches ) );
+    
+    std::size_t first = 0;
+    
+    while( first < M )
+    {
+        std::size_t last = first + 1;
+        
+        while( last < M && pitches[ order[last] ] - pitches[ order[first] ] <= pitchTolerance )
+        {
+            last++;
+        }
+        
+        std::vector< std::size_t > members( order.begin() + first, order.begin() + last );
+        std::stable_sort( members.begin(), members.end(), sofaLocal::AngleComparator( yaws ) );
+        
+        Row row;
+        row.pitch = 0.0;
+        
+        for( std::size_t i = 0; i < members.size(); i++ )
+        {
+            row.pitch += pitches[ members[i] ];
+            
+            /// duplicated orientations : the first measurement is kept
+            if( row.yaws.empty() == false && yaws[ members[i] ] == row.yaws.back() )
+            {
+                continue;
+            }
+            
+            row.yaws.push_back( yaws[ members[i] ] );
+            row.measurements.push_back( members[i] );
+        }
+        
+        row.pitch /= static_cast< double >( members.size() );
+        
+        rows.push_back( row );
+        
+        first = last;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Builds the index from the ListenerView of a file, and optionally
+ *                  loads its responses (FIR or FIRE)
+ *
+ */
+/************************************************************************************/
+void OrientationIndex::Load(const sofa::File &file,
+                            const bool loadResponses,
+                            const double pitchTolerance_)
+{
+    std::vector< double > views;
+    if( file.GetListenerViewAsCartesian( views ) == false )
+    {
+        SOFA_THROW( "cannot read 'ListenerView'" );
+    }
+    
+    const std::size_t M = views.size() / 3;
+    
+    std::vector< double > yaws_( M );
+    std::vector< double > pitches_( M );
+    
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        double aed[3];
+        sofa::CartesianToSpherical( aed, &views[ 3 * m ] );
+        
+        yaws_[m]    = aed[0];
+        pitches_[m] = aed[1];
+    }
+    
+    Build( yaws_, pitches_, pitchTolerance_ );
+    
+    if( loadResponses == true )
+    {
+        responses.Load( file );
+    }
+}
+
+std::size_t OrientationIndex::GetNumMeasurements() const
+{
+    return yaws.size();
+}
+
+double OrientationIndex::GetYaw(const std::size_t measurement) const
+{
+    return yaws[ measurement ];
+}
+
+double OrientationIndex::GetPitch(const std::size_t measurement) const
+{
+    return pitches[ measurement ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the angle (in degrees) between a measurement and an orientation
+ *
+ */
+/************************************************************************************/
+double OrientationIndex::GetAngularDistance(const std::size_t measurement,
+                                            const double yaw,
+                                            const double pitch) const
+{
+    const double aed[3] = { yaw, pitch, 1.0 };
+    double xyz[3];
+    sofa::SphericalToCartesian( xyz, aed );
+    
+    const double *direction = &directions[ 3 * measurement ];
+    
+    const double dot = direction[0] * xyz[0] + direction[1] * xyz[1] + direction[2] * xyz[2];
+    
+    return sofa::RadiansToDegrees( std::acos( sofa::smax( -1.0, sofa::smin( 1.0, dot ) ) ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Finds the two measurements of a row surrounding a yaw
+ *  @param[out]     lower : position in the row of the measurement before the yaw
+ *  @param[out]     upper : position in the row of the measurement after the yaw
+ *  @param[out]     weight : interpolation weight of 'upper' (the one of 'lower' is 1 - weight)
+ *
+ */
+/************************************************************************************/
+void OrientationIndex::findInRow(std::size_t &lower,
+                                 std::size_t &upper,
+                                 double &weight,
+                                 const Row &row,
+                                 const double yaw) const
+{
+    const std::size_t n = row.yaws.size();
+    
+    if( n == 1 )
+    {
+        lower   = 0;
+        upper   = 0;
+        weight  = 0.0;
+        return;
+    }
+    
+    const double y = WrapAngle( yaw );
+    
+    upper = std::lower_bound( row.yaws.begin(), row.yaws.end(), y ) - row.yaws.begin();
+    
+    if( upper == n )
+    {
+        upper = 0;
+    }
+    
+    lower = ( upper + n - 1 ) % n;
+    
+    double span = row.yaws[ upper ] - row.yaws[ lower ];
+    if( span <= 0.0 )
+    {
+        span += 360.0;
+    }
+    
+    double offset = y - row.yaws[ lower ];
+    if( offset < 0.0 )
+    {
+        offset += 360.0;
+    }
+    
+    weight = sofa::smin( 1.0, offset / span );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement closest to an orientation (great-circle distance)
+ *
+ *  @details        The result is exact when the measurements of a row share the same pitch;
+ *                  otherwise it may be off by the pitch tolerance
+ */
+/************************************************************************************/
+std::size_t OrientationIndex::FindNearest(const double yaw,
+                                          const double pitch) const
+{
+    if( rows.empty() == true )
+    {
+        SOFA_THROW( "empty orientation index" );
+    }
+    
+    const double p = sofa::smax( -90.0, sofa::smin( 90.0, pitch ) );
+    
+    /// rows are visited by increasing pitch difference, which is a lower bound of the distance
+    std::size_t above = 0;
+    while( above < rows.size() && rows[ above ].pitch < p )
+    {
+        above++;
+    }
+    std::size_t below = above;
+    
+    std::size_t nearest = rows[0].measurements[0];
+    double bestDistance = 360.0;
+    
+    while( below > 0 || above < rows.size() )
+    {
+        const bool takeBelow = ( above == rows.size() )
+                            || ( below > 0 && p - rows[ below - 1 ].pitch < rows[ above ].pitch - p );
+        
+        const Row &row = takeBelow == true ? rows[ --below ] : rows[ above++ ];
+        
+        /// the pitches of a row differ from its mean by less than the tolerance
+        if( sofa::FAbs( row.pitch - p ) - pitchTolerance > bestDistance )
+        {
+            break;
+        }
+        
+        std::size_t lower, upper;
+        double weight;
+        findInRow( lower, upper, weight, row, yaw );
+        
+        const std::size_t candidates[2] = { row.measurements[ lower ], row.measurements[ upper ] };
+        
+        for( std::size_t i = 0; i < 2; i++ )
+        {
+            const double distance = GetAngularDistance( candidates[i], yaw, p );
+            
+            if( distance < bestDistance )
+            {
+                bestDistance    = distance;
+                nearest         = candidates[i];
+            }
+        }
+    }
+    
+    return nearest;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement closest to an orientation, keeping the current one
+ *                  unless the new one is closer by more than 'hysteresis' degrees
+ *
+ *  @details        This avoids switching back and forth between two measurements
+ *                  when the head stays close to the middle of them
+ */
+/************************************************************************************/
+std::size_t OrientationIndex::FindNearest(const double yaw,
+                                          const double pitch,
+                                          const std::size_t currentMeasurement,
+                                          const double hysteresis) const
+{
+    const std::size_t nearest = FindNearest( yaw, pitch );
+    
+    if( currentMeasurement < GetNumMeasurements()
+       && currentMeasurement != nearest
+       && GetAngularDistance( currentMeasurement, yaw, pitch ) <= GetAngularDistance( nearest, yaw, pitch ) + hysteresis )
+    {
+        return currentMeasurement;
+    }
+    
+    return nearest;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the (up to 4) measurements surrounding an orientation,
+ *                  with bilinear weights along yaw and pitch (summing to 1)
+ *
+ *  @details        Beyond the lowest or the highest row, the pitch is clamped
+ */
+/************************************************************************************/
+void OrientationIndex::FindBracketing(sofa::OrientationIndex::Neighbours &neighbours,
+                                      const double yaw,
+                                      const double pitch) const
+{
+    neighbours.numNeighbours = 0;
+    
+    if( rows.empty() == true )
+    {
+        return;
+    }
+    
+    std::size_t above = 0;
+    while( above < rows.size() && rows[ above ].pitch < pitch )
+    {
+        above++;
+    }
+    
+    std::size_t rowIndices[2];
+    double rowWeights[2];
+    
+    if( above == 0 || above == rows.size() )
+    {
+        rowIndices[0] = rowIndices[1] = ( above == 0 ) ? 0 : rows.size() - 1;
+        rowWeights[0] = 1.0;
+        rowWeights[1] = 0.0;
+    }
+    else
+    {
+        const double p0 = rows[ above - 1 ].pitch;
+        const double p1 = rows[ above ].pitch;
+        const double t  = ( pitch - p0 ) / ( p1 - p0 );
+        
+        rowIndices[0] = above - 1;
+        rowIndices[1] = above;
+        rowWeights[0] = 1.0 - t;
+        rowWeights[1] = t;
+    }
+    
+    for( std::size_t i = 0; i < 2; i++ )
+    {
+        const Row &row = rows[ rowIndices[i] ];
+        
+        std::size_t lower, upper;
+        double weight;
+        findInRow( lower, upper, weight, row, yaw );
+        
+        sofaLocal::AddNeighbour( neighbours, row.measurements[ lower ], rowWeights[i] * ( 1.0 - weight ) );
+        sofaLocal::AddNeighbour( neighbours, row.measurements[ upper ], rowWeights[i] * weight );
+    }
+}
+
+const sofa::ImpulseResponses & OrientationIndex::GetResponses() const
+{
+    return responses;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the response of a measurement, receiver and emitter
+ *                  (GetResponses().GetNumDataSamples() values)
+ *
+ *  @details        The responses must have been loaded
+ */
+/************************************************************************************/
+const double * OrientationIndex::GetResponse(const std::size_t measurement,
+                                             const std::size_t receiver,
+                                             const std::size_t emitter) const
+{
+    SOFA_ASSERT( responses.GetNumMeasurements() == GetNumMeasurements() );
+    
+    return responses.GetResponse( responses.GetResponseIndex( measurement, receiver, emitter ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the delay (in samples) of a measurement, receiver and emitter
+ *
+ */
+/************************************************************************************/
+double OrientationIndex::GetDelay(const std::size_t measurement,
+                                  const std::size_t receiver,
+                                  const std::size_t emitter) const
+{
+    SOFA_ASSERT( responses.GetNumMeasurements() == GetNumMeasurements() );
+    
+    return responses.GetDelay( responses.GetResponseIndex( measurement, receiver, emitter ) );
+}
@@ -0,0 +1,161 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAOrientationIndex.h
+ *   @brief      Lookup of measurements by head orientation
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_ORIENTATION_INDEX_H__
+#define _SOFA_ORIENTATION_INDEX_H__
+
+#include "../src/SOFAImpulseResponses.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          OrientationIndex
+     *  @brief          Maps a head orientation (yaw, pitch) to the measurements of a file
+     *                  whose ListenerView varies along M (e.g. MultiSpeakerBRIR)
+     *
+     *  @details        The measurements are grouped in rows of (nearly) equal pitch,
+     *                  each row being sorted by yaw, so that a lookup only costs
+     *                  a few binary searches, and does not allocate memory.
+     *                  Yaw is wrapped to [-180 180[ : 359 degrees and -1 degree are neighbours.
+     *                  The responses can be loaded with the index, in order to get
+     *                  the IR of each receiver and emitter for a given orientation.
+     *                  All angles are in degrees.
+     */
+    /************************************************************************************/
+    class SOFA_API OrientationIndex
+    {
+    public:
+        
+        /// the measurements surrounding an orientation, with bilinear (yaw, pitch) weights
+        struct Neighbours
+        {
+            enum { kMaxNeighbours = 4 };
+            
+            std::size_t measurements[ kMaxNeighbours ];
+            double weights[ kMaxNeighbours ];
+            std::size_t numNeighbours;
+        };
+        
+    public:
+        OrientationIndex();
+        ~OrientationIndex() {};
+        
+        //==============================================================================
+        void Build(const std::vector< double > &yaws,
+                   const std::vector< double > &pitches,
+                   const double pitchTolerance = 0.5);
+        
+        void Load(const sofa::File &file,
+                  const bool loadResponses = true,
+                  const double pitchTolerance = 0.5);
+        
+        //==============================================================================
+        std::size_t GetNumMeasurements() const;
+        double GetYaw(const std::size_t measurement) const;
+        double GetPitch(const std::size_t measurement) const;
+        
+        std::size_t FindNearest(const double yaw,
+                                const double pitch) const;
+        
+        std::size_t FindNearest(const double yaw,
+                                const double pitch,
+                                const std::size_t currentMeasurement,
+                                const double hysteresis) const;
+        
+        void FindBracketing(sofa::OrientationIndex::Neighbours &neighbours,
+                            const double yaw,
+                            const double pitch) const;
+        
+        double GetAngularDistance(const std::size_t measurement,
+                                  const double yaw,
+                                  const double pitch) const;
+        
+        //==============================================================================
+        const sofa::ImpulseResponses & GetResponses() const;
+        
+        const double * GetResponse(const std::size_t measurement,
+                                   const std::size_t receiver,
+                                   const std::size_t emitter) const;
+        
+        double GetDelay(const std::size_t measurement,
+                        const std::size_t receiver,
+                        const std::size_t emitter) const;
+        
+        static double WrapAngle(const double angle);
+        
+    protected:
+        //==============================================================================
+        /// measurements of (nearly) equal pitch, sorted by yaw
+        struct Row
+        {
+            double pitch;
+            std::vector< double > yaws;
+            std::vector< std::size_t > measurements;
+        };
+        
+        void findInRow(std::size_t &lower,
+                       std::size_t &upper,
+                       double &weight,
+                       const Row &row,
+                       const double yaw) const;
+        
+    protected:
+        std::vector< double > yaws;                 ///< [M]
+        std::vector< double > pitches;              ///< [M]
+        std::vector< double > directions;           ///< [M 3] unit vectors
+        std::vector< Row > rows;                    ///< sorted by pitch
+        double pitchTolerance;
+        
+        sofa::ImpulseResponses responses;
+    };
+    
+}
+
+#endif /* _SOFA_ORIENTATION_INDEX_H__ */
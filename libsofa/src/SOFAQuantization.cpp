@@ -0,0 +1,426 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAQuantization.cpp
+ *   @brief      Quantized storage of the impulse responses (libsofa extension)
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAQuantization.h"
+#include "../src/SOFAFile.h"
+#include "../src/SOFAWriter.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFANcUtils.h"
+#include "../src/SOFAUtils.h"
+#include <cmath>
+
+using namespace sofa;
+
+const std::string Quantization::AttributeName     = "Quantization";
+const std::string Quantization::GainVariableName  = "Data.IRGain";
+
+namespace sofaLocal
+{
+    /// approximate size (in bytes) of the blocks of measurements processed at once
+    static const std::size_t kBlockSize = 4 * 1024 * 1024;
+    
+    /// target size (in bytes) of the HDF5 chunks of the quantized Data.IR
+    static const std::size_t kChunkSize = 256 * 1024;
+    
+    static double getPeak(const double *src, const std::size_t size)
+    {
+        double peak = 0.0;
+        for( std::size_t i = 0; i < size; i++ )
+        {
+            peak = sofa::smax( peak, sofa::FAbs( src[i] ) );
+        }
+        return peak;
+    }
+    
+    template< typename IntType >
+    static double quantize(IntType *dst, const double *src, const std::size_t size, const double fullScale)
+    {
+        const double peak = getPeak( src, size );
+        
+        if( peak == 0.0 )
+        {
+            std::fill( dst, dst + size, static_cast< IntType >( 0 ) );
+            return 0.0;
+        }
+        
+        const double gain  = peak / fullScale;
+        const double scale = fullScale / peak;
+        
+        for( std::size_t i = 0; i < size; i++ )
+        {
+            const double x = sofa::smax( -fullScale, sofa::smin( fullScale, src[i] * scale ) );
+            dst[i] = static_cast< IntType >( x < 0.0 ? x - 0.5 : x + 0.5 );
+        }
+        
+        return gain;
+    }
+    
+    /// plain loops : the compilers turn them into packed int -> float conversions and multiplications
+    template< typename FloatType, typename IntType >
+    static void dequantize(FloatType *dst, const IntType *src, const FloatType gain, const std::size_t size)
+    {
+        for( std::size_t i = 0; i < size; i++ )
+        {
+            dst[i] = static_cast< FloatType >( src[i] ) * gain;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of a quantization, as stored in the 'Quantization' attribute
+ *
+ */
+/************************************************************************************/
+std::string Quantization::GetName(const sofa::Quantization::Type &type_)
+{
+    switch( type_ )
+    {
+        case sofa::Quantization::kNone              : return "none";
+        case sofa::Quantization::kInt16             : return "int16";
+        case sofa::Quantization::kInt24             : return "int24";
+            
+        default                                     : SOFA_ASSERT( false ); return "";
+        case sofa::Quantization::kNumQuantizations  : SOFA_ASSERT( false ); return "";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the quantization based on its name
+ *                  Returns 'sofa::Quantization::kNumQuantizations' in case the string does not
+ *                  correspond to a valid quantization
+ *
+ */
+/************************************************************************************/
+sofa::Quantization::Type Quantization::GetType(const std::string &name)
+{
+    for( unsigned int i = 0; i < sofa::Quantization::kNumQuantizations; i++ )
+    {
+        const sofa::Quantization::Type type_ = static_cast< sofa::Quantization::Type >( i );
+        
+        if( GetName( type_ ) == name )
+        {
+            return type_;
+        }
+    }
+    
+    return sofa::Quantization::kNumQuantizations;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the quantization of a Data.IR variable
+ *                  Returns 'sofa::Quantization::kNumQuantizations' if the variable
+ *                  is neither double nor a valid quantized variable
+ *
+ */
+/************************************************************************************/
+sofa::Quantization::Type Quantization::GetType(const netCDF::NcVar &varIR)
+{
+    if( sofa::NcUtils::IsDouble( varIR ) == true )
+    {
+        return sofa::Quantization::kNone;
+    }
+    
+    const netCDF::NcVarAtt attr = sofa::NcUtils::GetAttribute( varIR, AttributeName );
+    
+    if( sofa::NcUtils::IsChar( attr ) == false )
+    {
+        return sofa::Quantization::kNumQuantizations;
+    }
+    
+    const sofa::Quantization::Type type_ = GetType( sofa::NcUtils::GetAttributeValueAsString( attr ) );
+    
+    if( type_ == sofa::Quantization::kInt16 && sofa::NcUtils::IsShort( varIR ) == true )
+    {
+        return type_;
+    }
+    
+    if( type_ == sofa::Quantization::kInt24 && sofa::NcUtils::IsInt( varIR ) == true )
+    {
+        return type_;
+    }
+    
+    return sofa::Quantization::kNumQuantizations;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the largest integer value of a quantization
+ *
+ */
+/************************************************************************************/
+double Quantization::GetFullScale(const sofa::Quantization::Type &type_)
+{
+    switch( type_ )
+    {
+        case sofa::Quantization::kInt16             : return 32767.0;
+        case sofa::Quantization::kInt24             : return 8388607.0;
+            
+        default                                     : SOFA_ASSERT( false ); return 1.0;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Quantizes one response on 16 bits, using its full dynamic
+ *  @param[out]     dst : the quantized samples
+ *  @param[in]      src : the samples
+ *  @param[in]      size : number of samples
+ *  @return         the gain to apply to the quantized samples
+ *
+ */
+/************************************************************************************/
+double Quantization::QuantizeInt16(short *dst, const double *src, const std::size_t size)
+{
+    return sofaLocal::quantize( dst, src, size, GetFullScale( sofa::Quantization::kInt16 ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Quantizes one response on 24 bits, using its full dynamic
+ *  @param[out]     dst : the quantized samples
+ *  @param[in]      src : the samples
+ *  @param[in]      size : number of samples
+ *  @return         the gain to apply to the quantized samples
+ *
+ */
+/************************************************************************************/
+double Quantization::QuantizeInt24(int *dst, const double *src, const std::size_t size)
+{
+    return sofaLocal::quantize( dst, src, size, GetFullScale( sofa::Quantization::kInt24 ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Converts quantized samples back to floating point : dst = src * gain
+ *
+ */
+/************************************************************************************/
+void Quantization::Dequantize(double *dst, const short *src, const double gain, const std::size_t size)
+{
+    sofaLocal::dequantize( dst, src, gain, size );
+}
+
+void Quantization::Dequantize(float *dst, const short *src, const float gain, const std::size_t size)
+{
+    sofaLocal::dequantize( dst, src, gain, size );
+}
+
+void Quantization::Dequantize(double *dst, const int *src, const double gain, const std::size_t size)
+{
+    sofaLocal::dequantize( dst, src, gain, size );
+}
+
+void Quantization::Dequantize(float *dst, const int *src, const float gain, const std::size_t size)
+{
+    sofaLocal::dequantize( dst, src, gain, size );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a copy of a FIR or FIRE file with quantized impulse responses
+ *  @param[in]      source : the file to convert (possibly already quantized)
+ *  @param[in]      outputPath : path of the new file (replaced if it exists)
+ *  @param[in]      type_ : quantization of the new file;
+ *                  kNone restores the standard double layout
+ *  @param[in]      deflateLevel : compression of Data.IR, from 0 (none) to 9
+ *
+ *  @details        The responses are processed by blocks of measurements,
+ *                  so that the whole Data.IR never needs to fit in memory
+ */
+/************************************************************************************/
+void Quantization::Write(const sofa::File &source,
+                         const std::string &outputPath,
+                         const sofa::Quantization::Type &type_,
+                         const int deflateLevel)
+{
+    if( type_ != sofa::Quantization::kNone
+       && type_ != sofa::Quantization::kInt16
+       && type_ != sofa::Quantization::kInt24 )
+    {
+        SOFA_THROW( "invalid quantization" );
+    }
+    
+    if( source.HasVariable( "Data.IR" ) == false )
+    {
+        SOFA_THROW( "missing 'Data.IR' variable" );
+    }
+    
+    std::vector< std::size_t > dims;
+    source.GetVariableDimensions( dims, "Data.IR" );
+    
+    std::vector< std::string > dimNames;
+    source.GetVariableDimensionsNames( dimNames, "Data.IR" );
+    
+    if( dims.size() < 3 || dimNames[0] != "M" )
+    {
+        SOFA_THROW( "invalid dimensions for 'Data.IR'" );
+    }
+    
+    const std::size_t M = dims[0];
+    const std::size_t N = dims.back();
+    
+    std::size_t rowsPerMeasurement = 1;
+    for( std::size_t i = 1; i + 1 < dims.size(); i++ )
+    {
+        rowsPerMeasurement *= dims[i];
+    }
+    
+    const std::size_t measurementSize = rowsPerMeasurement * N;
+    
+    std::vector< std::string > gainDimNames( dimNames.begin(), dimNames.end() - 1 );
+    
+    //==============================================================================
+    /// copy everything but the impulse responses
+    sofa::Writer writer( outputPath );
+    
+    writer.CopyGlobalAttributes( source );
+    writer.UpdateModificationAttributes();
+    writer.CopyDimensions( source );
+    
+    std::vector< std::string > excluded;
+    excluded.push_back( "Data.IR" );
+    excluded.push_back( GainVariableName );
+    
+    writer.CopyVariables( source, excluded );
+    
+    //==============================================================================
+    const netCDF::NcType ncType = ( type_ == sofa::Quantization::kInt16 ) ? netCDF::NcType::nc_SHORT
+                                : ( type_ == sofa::Quantization::kInt24 ) ? netCDF::NcType::nc_INT
+                                : netCDF::NcType::nc_DOUBLE;
+    
+    writer.AddVariable( "Data.IR", dimNames, ncType );
+    
+    if( M > 0 && measurementSize > 0 )
+    {
+        std::vector< std::size_t > chunkSizes = dims;
+        chunkSizes[0] = sofa::smin( M, sofa::smax( (std::size_t) 1, sofaLocal::kChunkSize / ( measurementSize * ncType.getSize() ) ) );
+        writer.SetChunking( "Data.IR", chunkSizes );
+    }
+    
+    if( deflateLevel > 0 )
+    {
+        writer.SetCompression( "Data.IR", true, deflateLevel );
+    }
+    
+    if( type_ != sofa::Quantization::kNone )
+    {
+        writer.PutVariableAttribute( "Data.IR", AttributeName, GetName( type_ ) );
+        
+        writer.AddVariable( GainVariableName, gainDimNames );
+        writer.PutVariableAttribute( GainVariableName, "LongName", "scale of the quantized impulse responses" );
+    }
+    
+    //==============================================================================
+    /// process blocks of measurements
+    const std::size_t blockSize = sofa::smax( (std::size_t) 1,
+                                              sofaLocal::kBlockSize / sofa::smax( (std::size_t) 1, measurementSize * sizeof( double ) ) );
+    
+    std::vector< double > values( blockSize * measurementSize );
+    std::vector< double > gains( blockSize * rowsPerMeasurement );
+    std::vector< short > values16;
+    std::vector< int > values24;
+    
+    if( type_ == sofa::Quantization::kInt16 )
+    {
+        values16.resize( values.size() );
+    }
+    else if( type_ == sofa::Quantization::kInt24 )
+    {
+        values24.resize( values.size() );
+    }
+    
+    for( std::size_t first = 0; first < M; first += blockSize )
+    {
+        const std::size_t count = sofa::smin( blockSize, M - first );
+        
+        if( source.GetDataIRMeasurements( &values[0], first, count ) == false )
+        {
+            SOFA_THROW( "cannot read 'Data.IR'" );
+        }
+        
+        std::vector< std::size_t > start( dims.size(), 0 );
+        std::vector< std::size_t > counts = dims;
+        start[0]  = first;
+        counts[0] = count;
+        
+        if( type_ == sofa::Quantization::kNone )
+        {
+            writer.PutValues( "Data.IR", &values[0], start, counts );
+            continue;
+        }
+        
+        for( std::size_t row = 0; row < count * rowsPerMeasurement; row++ )
+        {
+            if( type_ == sofa::Quantization::kInt16 )
+            {
+                gains[row] = QuantizeInt16( &values16[row * N], &values[row * N], N );
+            }
+            else
+            {
+                gains[row] = QuantizeInt24( &values24[row * N], &values[row * N], N );
+            }
+        }
+        
+        if( type_ == sofa::Quantization::kInt16 )
+        {
+            writer.PutValues( "Data.IR", &values16[0], start, counts );
+        }
+        else
+        {
+            writer.PutValues( "Data.IR", &values24[0], start, counts );
+        }
+        
+        std::vector< std::size_t > gainStart( start.begin(), start.end() - 1 );
+        std::vector< std::size_t > gainCounts( counts.begin(), counts.end() - 1 );
+        
+        writer.PutValues( GainVariableName, &gains[0], gainStart, gainCounts );
+    }
+}
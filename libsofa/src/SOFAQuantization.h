@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAQuantization.h
+ *   @brief      Quantized storage of the impulse responses (libsofa extension)
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_QUANTIZATION_H__
+#define _SOFA_QUANTIZATION_H__
+
+#include "../src/SOFAPlatform.h"
+#include "netcdf.h"
+#include "ncFile.h"
+
+namespace sofa
+{
+    class File;
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Quantization
+     *  @brief          Static class to write and read quantized impulse responses
+     *
+     *  @details        This is an extension to AES69 : the standard requires Data.IR to be
+     *                  stored as double, which is 4 times larger than needed for most
+     *                  measured responses. The quantized layout is :
+     *                  - 'Data.IR' is stored as short (int16) or int (int24, i.e. 32 bits
+     *                    integers in the range [-2^23+1 2^23-1]), with the same dimensions
+     *                    as the double variable ([M R N] for FIR, [M R E N] for FIRE)
+     *                  - 'Data.IR:Quantization' attribute is "int16" or "int24"
+     *                  - 'Data.IRGain' is a double variable holding the scale of each
+     *                    response, i.e. [M R] for FIR and [M R E] for FIRE
+     *
+     *                  The value of a sample is Data.IR[m][r][n] * Data.IRGain[m][r].
+     *                  The int24 variables are written with the shuffle filter, so that
+     *                  their most significant byte compresses down to almost nothing.
+     *
+     *                  sofa::File accepts such files as valid, and reads them transparently
+     *                  (GetDataIR, GetDataIRMeasurements, GetDataIRSamples).
+     *                  Other AES69 readers expect a double Data.IR : they either reject the
+     *                  file, or read the raw integer values without applying Data.IRGain.
+     *                  Quantized files are therefore meant to be read with libsofa;
+     *                  Quantization::Write() with kNone converts them back to the standard layout.
+     */
+    /************************************************************************************/
+    class SOFA_API Quantization
+    {
+    public:
+        
+        enum Type
+        {
+            kNone               = 0,    ///< double samples (standard layout)
+            kInt16              = 1,    ///< 16 bits integer samples
+            kInt24              = 2,    ///< 24 bits integer samples, stored in 32 bits integers
+            kNumQuantizations   = 3
+        };
+        
+        static const std::string AttributeName;
+        static const std::string GainVariableName;
+        
+    public:
+        static std::string GetName(const sofa::Quantization::Type &type_);
+        static sofa::Quantization::Type GetType(const std::string &name);
+        
+        static sofa::Quantization::Type GetType(const netCDF::NcVar &varIR);
+        
+        static double GetFullScale(const sofa::Quantization::Type &type_);
+        
+        //==============================================================================
+        static double QuantizeInt16(short *dst, const double *src, const std::size_t size);
+        static double QuantizeInt24(int *dst, const double *src, const std::size_t size);
+        
+        static void Dequantize(double *dst, const short *src, const double gain, const std::size_t size);
+        static void Dequantize(float *dst, const short *src, const float gain, const std::size_t size);
+        static void Dequantize(double *dst, const int *src, const double gain, const std::size_t size);
+        static void Dequantize(float *dst, const int *src, const float gain, const std::size_t size);
+        
+        //==============================================================================
+        static void Write(const sofa::File &source,
+                          const std::string &outputPath,
+                          const sofa::Quantization::Type &type_,
+                          const int deflateLevel = 4);
+        
+    private:
+        Quantization() SOFA_DELETED_FUNCTION;
+    };
+    
+}
+
+#endif /* _SOFA_QUANTIZATION_H__ */
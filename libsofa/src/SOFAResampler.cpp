@@ -0,0 +1,331 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAResampler.cpp
+ *   @brief      Polyphase sampling rate conversion of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAResampler.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// Kaiser window parameter (about 90 dB of stopband attenuation)
+    const double kaiserBeta = 9.0;
+    
+    static std::size_t GetGreatestCommonDivisor(std::size_t a, std::size_t b)
+    {
+        while( b != 0 )
+        {
+            const std::size_t r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+    
+    /// modified Bessel function of the first kind, order 0
+    static double BesselI0(const double x)
+    {
+        double sum  = 1.0;
+        double term = 1.0;
+        
+        for( unsigned int k = 1; k < 64; k++ )
+        {
+            const double f = x / ( 2.0 * k );
+            term *= f * f;
+            sum += term;
+            
+            if( term < sum * 1e-17 )
+            {
+                break;
+            }
+        }
+        return sum;
+    }
+    
+    static std::size_t GetIntegerSamplingRate(const double samplingRate)
+    {
+        const double rounded = std::floor( samplingRate + 0.5 );
+        
+        if( samplingRate <= 0.0 || sofa::FAbs( samplingRate - rounded ) > 1e-6 )
+        {
+            SOFA_THROW( "sampling rates must be positive integer values" );
+        }
+        
+        return static_cast< std::size_t >( rounded );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Constructor
+ *  @param[in]      inputSamplingRate : in hertz
+ *  @param[in]      outputSamplingRate : in hertz
+ *  @param[in]      numZeroCrossings : number of zero-crossings of the sinc on each side,
+ *                  i.e. the half length of the filter in samples at the lowest rate
+ *  @param[in]      rolloff : cutoff of the filter, relative to the lowest Nyquist frequency
+ *
+ */
+/************************************************************************************/
+Resampler::Resampler(const double inputSamplingRate_,
+                     const double outputSamplingRate_,
+                     const std::size_t numZeroCrossings,
+                     const double rolloff)
+: inputSamplingRate( inputSamplingRate_ )
+, outputSamplingRate( outputSamplingRate_ )
+, interpolation( 1 )
+, decimation( 1 )
+, numTaps( 1 )
+, filterDelay( 0 )
+{
+    const std::size_t inputRate  = sofaLocal::GetIntegerSamplingRate( inputSamplingRate );
+    const std::size_t outputRate = sofaLocal::GetIntegerSamplingRate( outputSamplingRate );
+    
+    if( numZeroCrossings == 0 || rolloff <= 0.0 || rolloff > 1.0 )
+    {
+        SOFA_THROW( "invalid resampling filter parameters" );
+    }
+    
+    const std::size_t gcd = sofaLocal::GetGreatestCommonDivisor( inputRate, outputRate );
+    
+    interpolation   = outputRate / gcd;
+    decimation      = inputRate / gcd;
+    
+    if( interpolation == 1 && decimation == 1 )
+    {
+        coefficients.assign( 1, 1.0 );
+        return;
+    }
+    
+    const std::size_t L = interpolation;
+    
+    /// cutoff, in cycles per sample at the rate L * input rate
+    const double cutoff = 0.5 * rolloff / static_cast< double >( sofa::smax( interpolation, decimation ) );
+    
+    filterDelay = static_cast< std::size_t >( std::ceil( numZeroCrossings / ( 2.0 * cutoff ) ) );
+    numTaps     = ( 2 * filterDelay + 1 + L - 1 ) / L;
+    
+    coefficients.assign( L * numTaps, 0.0 );
+    
+    const double pi     = 3.14159265358979323846;
+    const double i0beta = sofaLocal::BesselI0( sofaLocal::kaiserBeta );
+    const double half   = static_cast< double >( filterDelay );
+    
+    for( std::size_t j = 0; j <= 2 * filterDelay; j++ )
+    {
+        const double t = static_cast< double >( j ) - half;
+        const double x = 2.0 * cutoff * t;
+        
+        const double sinc   = ( t == 0.0 ) ? 1.0 : std::sin( pi * x ) / ( pi * x );
+        const double r      = t / half;
+        const double window = sofaLocal::BesselI0( sofaLocal::kaiserBeta * std::sqrt( sofa::smax( 0.0, 1.0 - r * r ) ) ) / i0beta;
+        
+        /// gain L compensates for the zeros inserted by the upsampling
+        const double value = L * 2.0 * cutoff * sinc * window;
+        
+        /// tap i of phase p is h[ p + i * L ], stored in reverse order
+        const std::size_t phase = j % L;
+        const std::size_t tap   = j / L;
+        
+        coefficients[ phase * numTaps + ( numTaps - 1 - tap ) ] = value;
+    }
+}
+
+double Resampler::GetInputSamplingRate() const
+{
+    return inputSamplingRate;
+}
+
+double Resampler::GetOutputSamplingRate() const
+{
+    return outputSamplingRate;
+}
+
+std::size_t Resampler::GetInterpolationFactor() const
+{
+    return interpolation;
+}
+
+std::size_t Resampler::GetDecimationFactor() const
+{
+    return decimation;
+}
+
+std::size_t Resampler::GetNumTapsPerPhase() const
+{
+    return numTaps;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of output samples for a given number of input samples
+ *
+ */
+/************************************************************************************/
+std::size_t Resampler::GetOutputLength(const std::size_t inputLength) const
+{
+    return ( inputLength * interpolation + decimation - 1 ) / decimation;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Resamples one response
+ *  @param[out]     output : GetOutputLength( inputLength ) samples
+ *  @param[in]      input : inputLength samples (must not overlap the output)
+ *
+ *  @details        Output sample n is the dot product of the phase ( n M + D ) mod L
+ *                  with the input samples ending at ( n M + D ) / L; the input is
+ *                  considered null outside [0 inputLength[.
+ *                  The inner loop is a contiguous dot product, vectorized by the compiler.
+ */
+/************************************************************************************/
+void Resampler::Process(double *output,
+                        const double *input,
+                        const std::size_t inputLength) const
+{
+    const std::size_t outputLength = GetOutputLength( inputLength );
+    
+    if( interpolation == 1 && decimation == 1 )
+    {
+        std::copy( input, input + inputLength, output );
+        return;
+    }
+    
+    for( std::size_t n = 0; n < outputLength; n++ )
+    {
+        const std::size_t t     = n * decimation + filterDelay;
+        const std::size_t last  = t / interpolation;                       ///< last input sample
+        const double *phase     = &coefficients[ ( t % interpolation ) * numTaps ];
+        
+        /// coefficient j applies to input sample last + 1 - numTaps + j
+        const std::size_t first = last + 1;                                 ///< = index of j = numTaps
+        const std::size_t begin = ( first >= numTaps ) ? 0 : numTaps - first;
+        const std::size_t end   = ( first <= inputLength ) ? numTaps : numTaps - ( first - inputLength );
+        
+        double sum = 0.0;
+        
+        if( begin < end )
+        {
+            const double *x = input + ( first + begin - numTaps );
+            const double *h = phase + begin;
+            const std::size_t count = end - begin;
+            
+            for( std::size_t j = 0; j < count; j++ )
+            {
+                sum += h[j] * x[j];
+            }
+        }
+        
+        output[n] = sum;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Converts a set of responses to another sampling rate
+ *  @param[in]      responses : the set to process
+ *  @param[in]      outputSamplingRate : the new sampling rate, in hertz
+ *  @param[in]      numZeroCrossings : half length of the filter
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ *  @details        The number of samples N and the delays are scaled by the ratio of the
+ *                  sampling rates.
+ */
+/************************************************************************************/
+void Resampler::Process(sofa::ImpulseResponses &responses,
+                        const double outputSamplingRate,
+                        const std::size_t numZeroCrossings,
+                        const unsigned int numThreads)
+{
+    const double inputSamplingRate = responses.GetSamplingRate();
+    
+    const sofa::Resampler resampler( inputSamplingRate, outputSamplingRate, numZeroCrossings );
+    
+    const std::size_t N             = responses.GetNumDataSamples();
+    const std::size_t numResponses  = responses.GetNumResponses();
+    const std::size_t newLength     = sofa::smax( (std::size_t) 1, resampler.GetOutputLength( N ) );
+    
+    const std::vector< double > input = responses.GetValues();
+    
+    responses.SetNumDataSamples( newLength );
+    responses.SetSamplingRate( outputSamplingRate );
+    
+    const double ratio = outputSamplingRate / inputSamplingRate;
+    
+    sofa::Threads::ParallelFor( numResponses,
+                                [&]( const std::size_t i, const unsigned int )
+                                {
+                                    resampler.Process( responses.GetResponse( i ), &input[ i * N ], N );
+                                    
+                                    responses.SetDelay( i, responses.GetDelay( i ) * ratio );
+                                },
+                                numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a copy of a FIR or FIRE file at another sampling rate
+ *
+ */
+/************************************************************************************/
+void Resampler::Process(const sofa::File &source,
+                        const std::string &outputPath,
+                        const double outputSamplingRate,
+                        const std::size_t numZeroCrossings,
+                        const unsigned int numThreads)
+{
+    sofa::ImpulseResponses responses;
+    responses.Load( source );
+    
+    Process( responses, outputSamplingRate, numZeroCrossings, numThreads );
+    
+    responses.Write( source, outputPath );
+}
@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAResampler.h
+ *   @brief      Polyphase sampling rate conversion of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_RESAMPLER_H__
+#define _SOFA_RESAMPLER_H__
+
+#include "../src/SOFAImpulseResponses.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Resampler
+     *  @brief          Rational sampling rate conversion (L/M) with a polyphase
+     *                  Kaiser-windowed sinc filter
+     *
+     *  @details        The filter is zero-phase (its group delay is compensated), so that
+     *                  the delays of the responses are only scaled by the ratio of the
+     *                  sampling rates.
+     *                  The sampling rates must be integer values (in hertz).
+     *                  The polyphase bank is built once; Process() does not modify
+     *                  the object and can be called from several threads.
+     *                  The static Process() methods convert a whole set of responses
+     *                  (FIR and FIRE conventions : SimpleFreeFieldHRIR, SimpleHeadphoneIR,
+     *                  SingleRoomDRIR, MultiSpeakerBRIR, ...), spreading them over several threads.
+     */
+    /************************************************************************************/
+    class SOFA_API Resampler
+    {
+    public:
+        Resampler(const double inputSamplingRate,
+                  const double outputSamplingRate,
+                  const std::size_t numZeroCrossings = 32,
+                  const double rolloff = 0.95);
+        
+        ~Resampler() {};
+        
+        double GetInputSamplingRate() const;
+        double GetOutputSamplingRate() const;
+        
+        std::size_t GetInterpolationFactor() const;
+        std::size_t GetDecimationFactor() const;
+        std::size_t GetNumTapsPerPhase() const;
+        
+        std::size_t GetOutputLength(const std::size_t inputLength) const;
+        
+        void Process(double *output,
+                     const double *input,
+                     const std::size_t inputLength) const;
+        
+        //==============================================================================
+        static void Process(sofa::ImpulseResponses &responses,
+                            const double outputSamplingRate,
+                            const std::size_t numZeroCrossings = 32,
+                            const unsigned int numThreads = 0);
+        
+        static void Process(const sofa::File &source,
+                            const std::string &outputPath,
+                            const double outputSamplingRate,
+                            const std::size_t numZeroCrossings = 32,
+                            const unsigned int numThreads = 0);
+        
+    protected:
+        const double inputSamplingRate;
+        const double outputSamplingRate;
+        std::size_t interpolation;          ///< L
+        std::size_t decimation;             ///< M
+        std::size_t numTaps;                ///< number of taps of each phase
+        std::size_t filterDelay;            ///< group delay of the prototype filter, at the rate L * input rate
+        
+        std::vector< double > coefficients; ///< [L numTaps], each phase stored in reverse order
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( Resampler );
+    };
+    
+}
+
+#endif /* _SOFA_RESAMPLER_H__ */
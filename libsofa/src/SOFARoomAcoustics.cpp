@@ -0,0 +1,831 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFARoomAcoustics.cpp
+ *   @brief      Room acoustic parameters (ISO 3382) of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFARoomAcoustics.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// approximate size (in bytes) of the blocks of measurements read at once
+    static const std::size_t kBlockSize = 16 * 1024 * 1024;
+    
+    /// octave bands 63 Hz to 8 kHz, plus the broadband response
+    static const std::size_t kNumOctaveBands = 8;
+    
+    /// nominal center frequencies, for display
+    static const char * const kBandNames[kNumOctaveBands + 1] = { "63", "125", "250", "500", "1000", "2000", "4000", "8000", "broadband" };
+    
+    /// quality factors of the two sections of a 4th-order Butterworth filter
+    static const double kButterworthQ[2] = { 0.54119610014619690, 1.3065629648763766 };
+    
+    /// the noise floor is estimated on this fraction of the end of the response
+    static const double kNoiseFraction = 0.1;
+    
+    /// the integration is truncated where the 10 ms energy falls below noise + 5 dB
+    static const double kTruncationMarginDB = 5.0;
+    static const double kTruncationWindow   = 0.01;
+    
+    /// lowest level of the decay curve used by the regressions (T30)
+    static const double kLowestDecayDB = -35.0;
+    
+    /// onset of the direct sound, relative to the peak energy
+    static const double kOnsetThresholdDB = -20.0;
+    
+    /// coefficients of a second-order section (direct form II transposed)
+    struct Biquad
+    {
+        double b0, b1, b2, a1, a2;
+    };
+    
+    /// low-pass or high-pass section, designed with the bilinear transform (prewarped at frequency)
+    static Biquad makeBiquad(const double frequency,
+                             const double q,
+                             const double samplingRate,
+                             const bool highPass)
+    {
+        const double w      = 2.0 * 3.14159265358979323846 * frequency / samplingRate;
+        const double alpha  = std::sin( w ) / ( 2.0 * q );
+        const double c      = std::cos( w );
+        const double a0     = 1.0 + alpha;
+        
+        Biquad biquad;
+        
+        if( highPass == true )
+        {
+            biquad.b0 = 0.5 * ( 1.0 + c ) / a0;
+            biquad.b1 = -( 1.0 + c ) / a0;
+        }
+        else
+        {
+            biquad.b0 = 0.5 * ( 1.0 - c ) / a0;
+            biquad.b1 = ( 1.0 - c ) / a0;
+        }
+        
+        biquad.b2 = biquad.b0;
+        biquad.a1 = -2.0 * c / a0;
+        biquad.a2 = ( 1.0 - alpha ) / a0;
+        
+        return biquad;
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          The octave filters : two high-pass and two low-pass sections per band
+     *
+     *  @details        The recursions of the bands are independent : they are run together,
+     *                  sample by sample, with the bands in the inner loop (which the compiler
+     *                  can vectorize) rather than one band after the other, which is bound
+     *                  by the latency of each recursion
+     */
+    /************************************************************************************/
+    struct OctaveFilterBank
+    {
+        static const std::size_t kNumSections = 4;
+        
+        double b0[kNumSections][kNumOctaveBands];
+        double b1[kNumSections][kNumOctaveBands];
+        double b2[kNumSections][kNumOctaveBands];
+        double a1[kNumSections][kNumOctaveBands];
+        double a2[kNumSections][kNumOctaveBands];
+        
+        bool isValid[kNumOctaveBands];
+        
+        explicit OctaveFilterBank(const double samplingRate)
+        {
+            const double limit = 0.49 * samplingRate;
+            
+            for( std::size_t band = 0; band < kNumOctaveBands; band++ )
+            {
+                const double center = sofa::RoomAcoustics::GetBandCenterFrequency( band );
+                const double lower  = center / std::sqrt( 2.0 );
+                const double upper  = center * std::sqrt( 2.0 );
+                
+                isValid[band] = ( lower < limit );
+                
+                for( std::size_t section = 0; section < kNumSections; section++ )
+                {
+                    const bool highPass = ( section < 2 );
+                    
+                    /// pass-through sections for the missing filters
+                    Biquad biquad = { 1.0, 0.0, 0.0, 0.0, 0.0 };
+                    
+                    if( ( highPass == true && isValid[band] == true ) || ( highPass == false && upper < limit ) )
+                    {
+                        biquad = makeBiquad( highPass == true ? lower : upper, kButterworthQ[ section % 2 ], samplingRate, highPass );
+                    }
+                    
+                    b0[section][band] = biquad.b0;
+                    b1[section][band] = biquad.b1;
+                    b2[section][band] = biquad.b2;
+                    a1[section][band] = biquad.a1;
+                    a2[section][band] = biquad.a2;
+                }
+            }
+        }
+        
+        /// output : [kNumOctaveBands length]
+        void Process(double *output,
+                     const double *input,
+                     const std::size_t length) const
+        {
+            double s1[kNumSections][kNumOctaveBands] = { { 0.0 } };
+            double s2[kNumSections][kNumOctaveBands] = { { 0.0 } };
+            double x[kNumOctaveBands];
+            
+            for( std::size_t i = 0; i < length; i++ )
+            {
+                for( std::size_t band = 0; band < kNumOctaveBands; band++ )
+                {
+                    x[band] = input[i];
+                }
+                
+                for( std::size_t section = 0; section < kNumSections; section++ )
+                {
+                    for( std::size_t band = 0; band < kNumOctaveBands; band++ )
+                    {
+                        const double y = b0[section][band] * x[band] + s1[section][band];
+                        
+                        s1[section][band] = b1[section][band] * x[band] - a1[section][band] * y + s2[section][band];
+                        s2[section][band] = b2[section][band] * x[band] - a2[section][band] * y;
+                        
+                        x[band] = y;
+                    }
+                }
+                
+                for( std::size_t band = 0; band < kNumOctaveBands; band++ )
+                {
+                    output[ band * length + i ] = x[band];
+                }
+            }
+        }
+    };
+    
+    /// backward integration of ( y^2 - noise ) over [0 length[
+    static void integrate(double *decay,
+                          const double *y,
+                          const std::size_t length,
+                          const double noise)
+    {
+        double sum = 0.0;
+        for( std::size_t i = length; i > 0; i-- )
+        {
+            sum += y[i - 1] * y[i - 1] - noise;
+            decay[i - 1] = sum;
+        }
+    }
+    
+    /// converts a decay curve to dB, relative to its first value
+    static void toDecibels(double *decay,
+                           const std::size_t length)
+    {
+        const double total = decay[0];
+        const double floor = std::numeric_limits< double >::min();
+        
+        for( std::size_t i = 0; i < length; i++ )
+        {
+            decay[i] = 10.0 * std::log10( sofa::smax( decay[i], floor ) / total );
+        }
+    }
+    
+    /// decay time extrapolated to -60 dB, from the linear regression of the decay curve
+    /// between two levels (dB); NaN if the curve does not reach them
+    static double getDecayTime(const double *decay,
+                               const std::size_t length,
+                               const double startDB,
+                               const double endDB,
+                               const double samplingRate)
+    {
+        std::size_t first = 0;
+        while( first < length && decay[first] > startDB )
+        {
+            first++;
+        }
+        
+        std::size_t last = first;
+        while( last < length && decay[last] > endDB )
+        {
+            last++;
+        }
+        
+        if( last >= length || last < first + 2 )
+        {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+        
+        const double count  = static_cast< double >( last - first + 1 );
+        const double meanX  = 0.5 * static_cast< double >( first + last );
+        
+        double meanY = 0.0;
+        for( std::size_t i = first; i <= last; i++ )
+        {
+            meanY += decay[i];
+        }
+        meanY /= count;
+        
+        double sxy = 0.0;
+        double sxx = 0.0;
+        for( std::size_t i = first; i <= last; i++ )
+        {
+            const double dx = static_cast< double >( i ) - meanX;
+            sxy += dx * ( decay[i] - meanY );
+            sxx += dx * dx;
+        }
+        
+        const double slope = sxy / sxx;   ///< dB per sample
+        
+        if( slope >= 0.0 )
+        {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+        
+        return -60.0 / ( slope * samplingRate );
+    }
+    
+    /// parameters of one (filtered) response starting at the direct sound
+    static void computeParameters(double *parameters,
+                                  const double *y,
+                                  double *decay,
+                                  const std::size_t length,
+                                  const double samplingRate)
+    {
+        //==============================================================================
+        /// noise floor and truncation point
+        const std::size_t tailLength = sofa::smax( (std::size_t) 1, static_cast< std::size_t >( kNoiseFraction * length ) );
+        
+        double noise = 0.0;
+        for( std::size_t i = length - tailLength; i < length; i++ )
+        {
+            noise += y[i] * y[i];
+        }
+        noise /= static_cast< double >( tailLength );
+        
+        std::size_t end = length;
+        
+        if( noise > 0.0 )
+        {
+            const std::size_t window    = sofa::smax( (std::size_t) 1, static_cast< std::size_t >( kTruncationWindow * samplingRate ) );
+            const double threshold      = noise * std::pow( 10.0, kTruncationMarginDB / 10.0 );
+            
+            end = 0;
+            for( std::size_t blockEnd = length; blockEnd > 0; )
+            {
+                const std::size_t blockStart = ( blockEnd > window ) ? blockEnd - window : 0;
+                
+                double energy = 0.0;
+                for( std::size_t i = blockStart; i < blockEnd; i++ )
+                {
+                    energy += y[i] * y[i];
+                }
+                
+                if( energy > threshold * static_cast< double >( blockEnd - blockStart ) )
+                {
+                    end = blockEnd;
+                    break;
+                }
+                
+                blockEnd = blockStart;
+            }
+        }
+        
+        if( end < 2 )
+        {
+            return;
+        }
+        
+        integrate( decay, y, end, noise );
+        
+        const double total = decay[0];
+        
+        if( total <= 0.0 )
+        {
+            return;
+        }
+        
+        //==============================================================================
+        /// energy ratios
+        const std::size_t n50 = static_cast< std::size_t >( 0.05 * samplingRate + 0.5 );
+        const std::size_t n80 = static_cast< std::size_t >( 0.08 * samplingRate + 0.5 );
+        
+        if( n50 < end && decay[n50] > 0.0 )
+        {
+            const double early = total - decay[n50];
+            
+            parameters[ RoomAcoustics::kC50 ] = ( early > 0.0 ) ? 10.0 * std::log10( early / decay[n50] ) : std::numeric_limits< double >::quiet_NaN();
+            parameters[ RoomAcoustics::kD50 ] = early / total;
+        }
+        
+        if( n80 < end && decay[n80] > 0.0 )
+        {
+            const double early = total - decay[n80];
+            
+            parameters[ RoomAcoustics::kC80 ] = ( early > 0.0 ) ? 10.0 * std::log10( early / decay[n80] ) : std::numeric_limits< double >::quiet_NaN();
+        }
+        
+        //==============================================================================
+        /// decay times
+        /// only the part of the curve used by the regressions is converted to dB
+        const double lowest = total * std::pow( 10.0, kLowestDecayDB / 10.0 );
+        
+        std::size_t decayLength = 0;
+        while( decayLength < end && decay[decayLength] > lowest )
+        {
+            decayLength++;
+        }
+        decayLength = sofa::smin( end, decayLength + 1 );
+        
+        toDecibels( decay, decayLength );
+        
+        parameters[ RoomAcoustics::kEDT ] = getDecayTime( decay, decayLength, 0.0, -10.0, samplingRate );
+        parameters[ RoomAcoustics::kT20 ] = getDecayTime( decay, decayLength, -5.0, -25.0, samplingRate );
+        parameters[ RoomAcoustics::kT30 ] = getDecayTime( decay, decayLength, -5.0, kLowestDecayDB, samplingRate );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of a parameter
+ *
+ */
+/************************************************************************************/
+std::string RoomAcoustics::GetName(const sofa::RoomAcoustics::Parameter &parameter)
+{
+    switch( parameter )
+    {
+        case sofa::RoomAcoustics::kEDT              : return "EDT";
+        case sofa::RoomAcoustics::kT20              : return "T20";
+        case sofa::RoomAcoustics::kT30              : return "T30";
+        case sofa::RoomAcoustics::kC50              : return "C50";
+        case sofa::RoomAcoustics::kC80              : return "C80";
+        case sofa::RoomAcoustics::kD50              : return "D50";
+            
+        default                                     : SOFA_ASSERT( false ); return "";
+        case sofa::RoomAcoustics::kNumParameters    : SOFA_ASSERT( false ); return "";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of bands : the octave bands, then the broadband response
+ *
+ */
+/************************************************************************************/
+std::size_t RoomAcoustics::GetNumBands()
+{
+    return sofaLocal::kNumOctaveBands + 1;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the exact center frequency of an octave band (0 for the broadband)
+ *
+ */
+/************************************************************************************/
+double RoomAcoustics::GetBandCenterFrequency(const std::size_t band)
+{
+    SOFA_ASSERT( band < GetNumBands() );
+    
+    if( band >= sofaLocal::kNumOctaveBands )
+    {
+        return 0.0;
+    }
+    
+    return 1000.0 * std::pow( 2.0, static_cast< double >( band ) - 4.0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the nominal name of a band ("63" ... "8000", "broadband")
+ *
+ */
+/************************************************************************************/
+std::string RoomAcoustics::GetBandName(const std::size_t band)
+{
+    SOFA_ASSERT( band < GetNumBands() );
+    
+    return sofaLocal::kBandNames[ band ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+RoomAcoustics::RoomAcoustics()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numEmitters( 0 )
+, samplingRate( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the Schroeder energy decay curve of a response, in dB
+ *                  relative to the total energy (no noise compensation)
+ *  @param[out]     decay : resized to length
+ *
+ */
+/************************************************************************************/
+void RoomAcoustics::GetEnergyDecayCurve(std::vector< double > &decay,
+                                        const double *response,
+                                        const std::size_t length)
+{
+    decay.resize( length );
+    
+    if( length == 0 )
+    {
+        return;
+    }
+    
+    sofaLocal::integrate( &decay[0], response, length, 0.0 );
+    
+    if( decay[0] > 0.0 )
+    {
+        sofaLocal::toDecibels( &decay[0], length );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the parameters of one response, in all the bands
+ *  @param[out]     values : [GetNumBands() kNumParameters]
+ *  @param[in]      workspace : resized if needed; can be reused from one call to another
+ *  @param[in]      response : the impulse response
+ *  @param[in]      length : number of samples of the response
+ *  @param[in]      samplingRate : in hertz
+ *
+ */
+/************************************************************************************/
+void RoomAcoustics::AnalyzeResponse(double *values,
+                                    std::vector< double > &workspace,
+                                    const double *response,
+                                    const std::size_t length,
+                                    const double samplingRate_)
+{
+    const std::size_t numBands = GetNumBands();
+    
+    std::fill( values, values + numBands * kNumParameters, std::numeric_limits< double >::quiet_NaN() );
+    
+    //==============================================================================
+    /// onset of the direct sound, on the broadband response
+    double peak = 0.0;
+    for( std::size_t i = 0; i < length; i++ )
+    {
+        peak = sofa::smax( peak, response[i] * response[i] );
+    }
+    
+    if( peak <= 0.0 )
+    {
+        return;
+    }
+    
+    const double threshold = peak * std::pow( 10.0, sofaLocal::kOnsetThresholdDB / 10.0 );
+    
+    std::size_t onset = 0;
+    while( response[onset] * response[onset] < threshold )
+    {
+        onset++;
+    }
+    
+    const std::size_t remaining = length - onset;
+    
+    workspace.resize( length * ( sofaLocal::kNumOctaveBands + 1 ) + remaining );
+    
+    double *filtered    = &workspace[0];                                    ///< [numBands length]
+    double *decay       = &workspace[ length * ( sofaLocal::kNumOctaveBands + 1 ) ];
+    
+    const sofaLocal::OctaveFilterBank filterBank( samplingRate_ );
+    
+    filterBank.Process( filtered, response, length );
+    
+    std::copy( response, response + length, filtered + sofaLocal::kNumOctaveBands * length );
+    
+    //==============================================================================
+    for( std::size_t band = 0; band < numBands; band++ )
+    {
+        if( band < sofaLocal::kNumOctaveBands && filterBank.isValid[band] == false )
+        {
+            continue;
+        }
+        
+        sofaLocal::computeParameters( values + band * kNumParameters, filtered + band * length + onset, decay, remaining, samplingRate_ );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the parameters of all the responses of a FIR or FIRE file
+ *  @param[in]      file : e.g. SingleRoomDRIR, MultiSpeakerBRIR
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ *  @details        The file is read a block of measurements at a time
+ */
+/************************************************************************************/
+void RoomAcoustics::Analyze(const sofa::File &file,
+                            const unsigned int numThreads)
+{
+    if( file.IsFIRDataType() == false && file.IsFIREDataType() == false )
+    {
+        SOFA_THROW( "'DataType' shall be FIR or FIRE" );
+    }
+    
+    const std::size_t M = file.GetNumMeasurements();
+    const std::size_t R = file.GetNumReceivers();
+    const std::size_t E = ( file.IsFIREDataType() == true ) ? file.GetNumEmitters() : 1;
+    const std::size_t N = file.GetNumDataSamples();
+    
+    const std::size_t measurementSize   = sofa::smax( (std::size_t) 1, R * E * N );
+    const std::size_t blockSize         = sofa::smax( (std::size_t) 1, sofaLocal::kBlockSize / ( measurementSize * sizeof( double ) ) );
+    
+    numMeasurements = M;
+    numReceivers    = R;
+    numEmitters     = E;
+    samplingRate    = 0.0;
+    
+    values.assign( M * R * E * GetNumBands() * kNumParameters, std::numeric_limits< double >::quiet_NaN() );
+    
+    sofa::ImpulseResponses responses;
+    
+    for( std::size_t first = 0; first < M; first += blockSize )
+    {
+        responses.Load( file, first, sofa::smin( blockSize, M - first ) );
+        
+        samplingRate = responses.GetSamplingRate();
+        
+        analyze( responses, first, numThreads );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the parameters of a set of responses
+ *
+ */
+/************************************************************************************/
+void RoomAcoustics::Analyze(const sofa::ImpulseResponses &responses,
+                            const unsigned int numThreads)
+{
+    numMeasurements = responses.GetNumMeasurements();
+    numReceivers    = responses.GetNumReceivers();
+    numEmitters     = responses.GetNumEmitters();
+    samplingRate    = responses.GetSamplingRate();
+    
+    values.assign( responses.GetNumResponses() * GetNumBands() * kNumParameters, std::numeric_limits< double >::quiet_NaN() );
+    
+    analyze( responses, 0, numThreads );
+}
+
+void RoomAcoustics::analyze(const sofa::ImpulseResponses &responses,
+                            const std::size_t firstMeasurement,
+                            const unsigned int numThreads)
+{
+    const std::size_t N             = responses.GetNumDataSamples();
+    const std::size_t numResponses  = responses.GetNumResponses();
+    const std::size_t stride        = GetNumBands() * kNumParameters;
+    const std::size_t offset        = firstMeasurement * numReceivers * numEmitters;
+    const double fs                 = responses.GetSamplingRate();
+    
+    const unsigned int numWorkers = sofa::Threads::GetNumThreads( numThreads );
+    
+    /// one workspace per thread
+    std::vector< std::vector< double > > workspaces( numWorkers );
+    
+    sofa::Threads::ParallelFor( numResponses,
+                                [&]( const std::size_t i, const unsigned int threadIndex )
+                                {
+                                    AnalyzeResponse( &values[ ( offset + i ) * stride ],
+                                                     workspaces[ threadIndex ],
+                                                     responses.GetResponse( i ),
+                                                     N,
+                                                     fs );
+                                },
+                                numWorkers );
+}
+
+std::size_t RoomAcoustics::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+std::size_t RoomAcoustics::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t RoomAcoustics::GetNumEmitters() const
+{
+    return numEmitters;
+}
+
+double RoomAcoustics::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns one parameter of one response, in one band (NaN if not available)
+ *
+ */
+/************************************************************************************/
+double RoomAcoustics::GetValue(const std::size_t measurement,
+                               const std::size_t receiver,
+                               const std::size_t emitter,
+                               const std::size_t band,
+                               const sofa::RoomAcoustics::Parameter &parameter) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers && emitter < numEmitters );
+    SOFA_ASSERT( band < GetNumBands() && parameter < kNumParameters );
+    
+    const std::size_t response = ( measurement * numReceivers + receiver ) * numEmitters + emitter;
+    
+    return values[ ( response * GetNumBands() + band ) * kNumParameters + parameter ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns all the values, [M R E GetNumBands() kNumParameters]
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & RoomAcoustics::GetValues() const
+{
+    return values;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the values as CSV, one line per response and band
+ *
+ *  @details        Columns : measurement, receiver, emitter, band, then the parameters.
+ *                  Values which are not available are left empty
+ */
+/************************************************************************************/
+void RoomAcoustics::WriteCSV(std::ostream &output) const
+{
+    const std::size_t numBands = GetNumBands();
+    
+    output << "measurement,receiver,emitter,band";
+    for( std::size_t p = 0; p < kNumParameters; p++ )
+    {
+        output << "," << GetName( static_cast< Parameter >( p ) );
+    }
+    output << '\n';
+    
+    for( std::size_t m = 0; m < numMeasurements; m++ )
+    {
+        for( std::size_t r = 0; r < numReceivers; r++ )
+        {
+            for( std::size_t e = 0; e < numEmitters; e++ )
+            {
+                for( std::size_t b = 0; b < numBands; b++ )
+                {
+                    output << m << "," << r << "," << e << "," << GetBandName( b );
+                    
+                    for( std::size_t p = 0; p < kNumParameters; p++ )
+                    {
+                        output << ",";
+                        
+                        const double value = GetValue( m, r, e, b, static_cast< Parameter >( p ) );
+                        if( std::isnan( value ) == false )
+                        {
+                            output << value;
+                        }
+                    }
+                    
+                    output << '\n';
+                }
+            }
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the values as JSON
+ *
+ *  @details        { "SamplingRate", "Bands", "Parameters", "Responses" : [ { "Measurement",
+ *                  "Receiver", "Emitter", and for each parameter the array of its values
+ *                  in all the bands } ] }. Values which are not available are null
+ */
+/************************************************************************************/
+void RoomAcoustics::WriteJSON(std::ostream &output) const
+{
+    const std::size_t numBands = GetNumBands();
+    
+    output << "{" << '\n';
+    output << "  \"SamplingRate\": " << samplingRate << "," << '\n';
+    
+    output << "  \"Bands\": [";
+    for( std::size_t b = 0; b < numBands; b++ )
+    {
+        output << ( b > 0 ? ", " : "" ) << "\"" << GetBandName( b ) << "\"";
+    }
+    output << "]," << '\n';
+    
+    output << "  \"Parameters\": [";
+    for( std::size_t p = 0; p < kNumParameters; p++ )
+    {
+        output << ( p > 0 ? ", " : "" ) << "\"" << GetName( static_cast< Parameter >( p ) ) << "\"";
+    }
+    output << "]," << '\n';
+    
+    output << "  \"Responses\": [";
+    
+    bool firstResponse = true;
+    
+    for( std::size_t m = 0; m < numMeasurements; m++ )
+    {
+        for( std::size_t r = 0; r < numReceivers; r++ )
+        {
+            for( std::size_t e = 0; e < numEmitters; e++ )
+            {
+                output << ( firstResponse == true ? "" : "," ) << '\n';
+                firstResponse = false;
+                
+                output << "    { \"Measurement\": " << m << ", \"Receiver\": " << r << ", \"Emitter\": " << e;
+                
+                for( std::size_t p = 0; p < kNumParameters; p++ )
+                {
+                    output << ", \"" << GetName( static_cast< Parameter >( p ) ) << "\": [";
+                    
+                    for( std::size_t b = 0; b < numBands; b++ )
+                    {
+                        const double value = GetValue( m, r, e, b, static_cast< Parameter >( p ) );
+                        
+                        output << ( b > 0 ? ", " : "" );
+                        
+                        if( std::isnan( value ) == true )
+                        {
+                            output << "null";
+                        }
+                        else
+                        {
+                            output << value;
+                        }
+                    }
+                    
+                    output << "]";
+                }
+                
+                output << " }";
+            }
+        }
+    }
+    
+    output << '\n' << "  ]" << '\n';
+    output << "}" << '\n';
+}
@@ -0,0 +1,154 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFARoomAcoustics.h
+ *   @brief      Room acoustic parameters (ISO 3382) of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_ROOM_ACOUSTICS_H__
+#define _SOFA_ROOM_ACOUSTICS_H__
+
+#include "../src/SOFAImpulseResponses.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          RoomAcoustics
+     *  @brief          Computes the reverberation times and energy ratios (ISO 3382) of
+     *                  all the responses of a FIR or FIRE file (e.g. SingleRoomDRIR,
+     *                  MultiSpeakerBRIR), in octave bands
+     *
+     *  @details        Each response is filtered in the octave bands 63 Hz to 8 kHz
+     *                  (4th-order Butterworth high-pass and low-pass sections), and the
+     *                  parameters are derived from the Schroeder backward integration of
+     *                  the energy, from the onset of the direct sound (-20 dB below the peak).
+     *                  The noise floor is estimated on the last tenth of the response,
+     *                  subtracted from the energy, and the integration is truncated where
+     *                  the response reaches the noise floor.
+     *                  Parameters which cannot be computed (e.g. a decay range too short
+     *                  for T30, or a band above Nyquist) are NaN.
+     *                  Files are read a block of measurements at a time, and the responses
+     *                  of a block are analyzed in parallel.
+     */
+    /************************************************************************************/
+    class SOFA_API RoomAcoustics
+    {
+    public:
+        enum Parameter
+        {
+            kEDT            = 0,    ///< early decay time (s), from the 0 to -10 dB decay
+            kT20            = 1,    ///< reverberation time (s), from the -5 to -25 dB decay
+            kT30            = 2,    ///< reverberation time (s), from the -5 to -35 dB decay
+            kC50            = 3,    ///< clarity (dB), 50 ms
+            kC80            = 4,    ///< clarity (dB), 80 ms
+            kD50            = 5,    ///< definition, 50 ms (ratio in [0 1])
+            
+            kNumParameters  = 6
+        };
+        
+        static std::string GetName(const sofa::RoomAcoustics::Parameter &parameter);
+        
+        static std::size_t GetNumBands();
+        static double GetBandCenterFrequency(const std::size_t band);
+        static std::string GetBandName(const std::size_t band);
+        
+    public:
+        RoomAcoustics();
+        ~RoomAcoustics() {};
+        
+        //==============================================================================
+        void Analyze(const sofa::File &file,
+                     const unsigned int numThreads = 0);
+        
+        void Analyze(const sofa::ImpulseResponses &responses,
+                     const unsigned int numThreads = 0);
+        
+        static void AnalyzeResponse(double *values,
+                                    std::vector< double > &workspace,
+                                    const double *response,
+                                    const std::size_t length,
+                                    const double samplingRate);
+        
+        static void GetEnergyDecayCurve(std::vector< double > &decay,
+                                        const double *response,
+                                        const std::size_t length);
+        
+        //==============================================================================
+        std::size_t GetNumMeasurements() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetNumEmitters() const;
+        double GetSamplingRate() const;
+        
+        double GetValue(const std::size_t measurement,
+                        const std::size_t receiver,
+                        const std::size_t emitter,
+                        const std::size_t band,
+                        const sofa::RoomAcoustics::Parameter &parameter) const;
+        
+        const std::vector< double > & GetValues() const;
+        
+        //==============================================================================
+        void WriteCSV(std::ostream &output) const;
+        void WriteJSON(std::ostream &output) const;
+        
+    protected:
+        //==============================================================================
+        void analyze(const sofa::ImpulseResponses &responses,
+                     const std::size_t firstMeasurement,
+                     const unsigned int numThreads);
+        
+    protected:
+        std::size_t numMeasurements;
+        std::size_t numReceivers;
+        std::size_t numEmitters;
+        double samplingRate;
+        
+        std::vector< double > values;   ///< [M R E numBands kNumParameters]
+    };
+    
+}
+
+#endif /* _SOFA_ROOM_ACOUSTICS_H__ */
@@ -0,0 +1,667 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASpectralDistance.cpp
+ *   @brief      Log-spectral distances between the HRTF sets of several subjects
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASpectralDistance.h"
+#include "../src/SOFAFile.h"
+#include "../src/SOFAImpulseResponses.h"
+#include "../src/SOFAMeasurementOrder.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// identifies the cache files (and their layout)
+    static const char kCacheMagic[8] = { 'S', 'O', 'F', 'A', 'L', 'S', 'D', '2' };
+    
+    /// the rows of the aligned spectra are padded to a multiple of this number of bins
+    static const std::size_t kNumLanes = 8;
+    
+    static const unsigned long long kHashSeed = 14695981039346656037ULL;
+    
+    /// 64-bit FNV-1a hash, continuing from a previous hash
+    static unsigned long long Hash(const void *data,
+                                   const std::size_t size,
+                                   const unsigned long long seed = kHashSeed)
+    {
+        const unsigned char *bytes = static_cast< const unsigned char * >( data );
+        unsigned long long hash = seed;
+        
+        for( std::size_t i = 0; i < size; i++ )
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        
+        return hash;
+    }
+    
+    static unsigned long long Hash(const std::string &text)
+    {
+        return Hash( text.data(), text.size() );
+    }
+    
+    /// sum of the squared differences of two rows of kNumLanes * numBlocks values :
+    /// the independent partial sums let the compiler vectorize the reduction, and they
+    /// are accumulated in double precision since they sum many terms
+    static double SumOfSquaredDifferences(const float *a,
+                                          const float *b,
+                                          const std::size_t numBlocks)
+    {
+        double partial[ kNumLanes ] = { 0.0 };
+        
+        for( std::size_t n = 0; n < numBlocks; n++ )
+        {
+            const float *x = a + n * kNumLanes;
+            const float *y = b + n * kNumLanes;
+            
+            for( std::size_t j = 0; j < kNumLanes; j++ )
+            {
+                const double difference = static_cast< double >( x[j] - y[j] );
+                partial[j] += difference * difference;
+            }
+        }
+        
+        double sum = 0.0;
+        for( std::size_t j = 0; j < kNumLanes; j++ )
+        {
+            sum += partial[j];
+        }
+        return sum;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+SpectralDistance::SpectralDistance()
+: numSubjects( 0 )
+, numDirections( 0 )
+, numReceivers( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the distance matrix of a set of files
+ *  @param[in]      paths : FIR files with one emitter (e.g. SimpleFreeFieldHRIR), one per subject
+ *  @param[in]      cacheDirectory : existing directory for the cached spectra (empty for no cache)
+ *  @param[in]      numBins : number of frequencies, log-spaced in [lowFrequency highFrequency]
+ *  @param[in]      maxAngle : largest angle (degrees) between a reference direction
+ *                  and the measurement matched for each subject
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ */
+/************************************************************************************/
+void SpectralDistance::Compute(const std::vector< std::string > &paths,
+                               const std::string &cacheDirectory,
+                               const std::size_t numBins,
+                               const double lowFrequency,
+                               const double highFrequency,
+                               const double maxAngle,
+                               const unsigned int numThreads)
+{
+    if( paths.size() < 2 )
+    {
+        SOFA_THROW( "at least two files are required" );
+    }
+    
+    if( numBins < 2 || lowFrequency <= 0.0 || highFrequency <= lowFrequency )
+    {
+        SOFA_THROW( "invalid frequency grid" );
+    }
+    
+    frequencies.resize( numBins );
+    for( std::size_t k = 0; k < numBins; k++ )
+    {
+        const double alpha = static_cast< double >( k ) / static_cast< double >( numBins - 1 );
+        frequencies[k] = lowFrequency * std::pow( highFrequency / lowFrequency, alpha );
+    }
+    
+    //==============================================================================
+    /// spectra of each file, from the cache when possible
+    const std::size_t S = paths.size();
+    
+    std::vector< Subject > subjects( S );
+    
+    /// netCDF / HDF5 are not thread-safe : the files are read one after the other,
+    /// and the responses of each file are analyzed in parallel
+    for( std::size_t s = 0; s < S; s++ )
+    {
+        loadSubject( subjects[s], paths[s], cacheDirectory, numThreads );
+    }
+    
+    const std::size_t R = subjects[0].numReceivers;
+    
+    for( std::size_t s = 1; s < S; s++ )
+    {
+        if( subjects[s].numReceivers != R )
+        {
+            SOFA_THROW( paths[s] + " does not have the same number of receivers as " + paths[0] );
+        }
+    }
+    
+    //==============================================================================
+    /// nearest measurement of each subject, for each direction of the first subject
+    const Subject &reference    = subjects[0];
+    const std::size_t M0        = reference.numMeasurements;
+    const double minDot         = std::cos( sofa::DegreesToRadians( maxAngle ) );
+    
+    std::vector< std::size_t > matches( S * M0 );
+    std::vector< unsigned char > matched( S * M0, 0 );  ///< [S M0] within maxAngle
+    
+    sofa::Threads::ParallelFor( S,
+                                [&]( const std::size_t s, const unsigned int )
+                                {
+                                    const Subject &subject = subjects[s];
+                                    
+                                    for( std::size_t d = 0; d < M0; d++ )
+                                    {
+                                        double maxDot = -2.0;
+                                        
+                                        matches[ s * M0 + d ] = sofa::MeasurementOrder::FindNearestDirection( &reference.directions[ 3 * d ],
+                                                                                                               subject.directions,
+                                                                                                               &maxDot );
+                                        matched[ s * M0 + d ] = ( maxDot >= minDot ) ? 1 : 0;
+                                    }
+                                },
+                                numThreads );
+    
+    std::vector< std::size_t > directions;
+    for( std::size_t d = 0; d < M0; d++ )
+    {
+        bool shared = true;
+        for( std::size_t s = 0; s < S && shared == true; s++ )
+        {
+            shared = ( matched[ s * M0 + d ] != 0 );
+        }
+        
+        if( shared == true )
+        {
+            directions.push_back( d );
+        }
+    }
+    
+    if( directions.empty() == true )
+    {
+        SOFA_THROW( "the files do not have any direction in common" );
+    }
+    
+    //==============================================================================
+    /// aligned spectra [D R stride], in single precision, the padding being zero
+    const std::size_t D         = directions.size();
+    const std::size_t numBlocks = ( numBins + sofaLocal::kNumLanes - 1 ) / sofaLocal::kNumLanes;
+    const std::size_t stride    = numBlocks * sofaLocal::kNumLanes;
+    const std::size_t size      = D * R * stride;
+    
+    std::vector< float > aligned( S * size, 0.0f );
+    
+    sofa::Threads::ParallelFor( S,
+                                [&]( const std::size_t s, const unsigned int )
+                                {
+                                    const Subject &subject = subjects[s];
+                                    
+                                    for( std::size_t d = 0; d < D; d++ )
+                                    {
+                                        const std::size_t m = matches[ s * M0 + directions[d] ];
+                                        
+                                        for( std::size_t r = 0; r < R; r++ )
+                                        {
+                                            const double *source = &subject.spectra[ ( m * R + r ) * numBins ];
+                                            float *destination   = &aligned[ s * size + ( d * R + r ) * stride ];
+                                            
+                                            for( std::size_t k = 0; k < numBins; k++ )
+                                            {
+                                                destination[k] = static_cast< float >( source[k] );
+                                            }
+                                        }
+                                    }
+                                },
+                                numThreads );
+    
+    subjects.clear();
+    
+    //==============================================================================
+    /// upper triangle, one pair per task
+    numSubjects     = S;
+    numDirections   = D;
+    numReceivers    = R;
+    
+    distances.assign( S * S, 0.0 );
+    
+    const std::size_t numPairs = S * ( S - 1 ) / 2;
+    const double numValues     = static_cast< double >( D * R * numBins );
+    
+    sofa::Threads::ParallelFor( numPairs,
+                                [&]( const std::size_t pair, const unsigned int )
+                                {
+                                    /// pair -> ( i, j ), i < j
+                                    std::size_t i = 0;
+                                    std::size_t first = 0;
+                                    while( first + ( S - 1 - i ) <= pair )
+                                    {
+                                        first += S - 1 - i;
+                                        i++;
+                                    }
+                                    const std::size_t j = i + 1 + ( pair - first );
+                                    
+                                    const double sum = sofaLocal::SumOfSquaredDifferences( &aligned[ i * size ],
+                                                                                           &aligned[ j * size ],
+                                                                                           D * R * numBlocks );
+                                    
+                                    const double distance = std::sqrt( sum / numValues );
+                                    
+                                    distances[ i * S + j ] = distance;
+                                    distances[ j * S + i ] = distance;
+                                },
+                                numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads the spectra of one file, from the cache if possible
+ *
+ *  @details        The cache is only used if it was computed from the same responses,
+ *                  sampling rate and directions (compared through a hash of their values)
+ */
+/************************************************************************************/
+void SpectralDistance::loadSubject(sofa::SpectralDistance::Subject &subject,
+                                   const std::string &path,
+                                   const std::string &cacheDirectory,
+                                   const unsigned int numThreads) const
+{
+    const sofa::File theFile( path );
+    
+    if( theFile.IsValid() == false )
+    {
+        SOFA_THROW( path + " is not a valid SOFA file" );
+    }
+    
+    sofa::ImpulseResponses responses;
+    responses.Load( theFile );
+    
+    if( responses.GetNumEmitters() != 1 || responses.GetNumMeasurements() == 0 )
+    {
+        SOFA_THROW( path + " must have one emitter, and at least one measurement" );
+    }
+    
+    const std::size_t M         = responses.GetNumMeasurements();
+    const double samplingRate   = responses.GetSamplingRate();
+    
+    if( samplingRate <= 0.0 )
+    {
+        SOFA_THROW( path + " has an invalid sampling rate" );
+    }
+    
+    if( frequencies.back() >= 0.5 * samplingRate )
+    {
+        SOFA_THROW( "the upper frequency of the grid is not below the Nyquist frequency of " + path );
+    }
+    
+    subject.numMeasurements = M;
+    subject.numReceivers    = responses.GetNumReceivers();
+    
+    sofa::MeasurementOrder::GetUnitMeasurementDirections( theFile, subject.directions );
+    
+    if( cacheDirectory.empty() == true )
+    {
+        analyze( subject, responses, numThreads );
+        return;
+    }
+    
+    const std::vector< double > &values = responses.GetValues();
+    
+    unsigned long long contentHash = sofaLocal::Hash( &values[0], values.size() * sizeof( double ) );
+    contentHash = sofaLocal::Hash( &subject.directions[0], subject.directions.size() * sizeof( double ), contentHash );
+    contentHash = sofaLocal::Hash( &samplingRate, sizeof( double ), contentHash );
+    
+    const std::string cachePath = getCachePath( path, cacheDirectory );
+    
+    if( readCache( subject, cachePath, contentHash ) == true )
+    {
+        return;
+    }
+    
+    analyze( subject, responses, numThreads );
+    writeCache( subject, cachePath, contentHash );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the power spectra (dB) of all the responses of a file,
+ *                  on the frequency grid, the responses being spread over threads
+ *
+ */
+/************************************************************************************/
+void SpectralDistance::analyze(sofa::SpectralDistance::Subject &subject,
+                               const sofa::ImpulseResponses &responses,
+                               const unsigned int numThreads) const
+{
+    const std::size_t M         = responses.GetNumMeasurements();
+    const std::size_t R         = responses.GetNumReceivers();
+    const std::size_t N         = responses.GetNumDataSamples();
+    const std::size_t F         = frequencies.size();
+    const double samplingRate   = responses.GetSamplingRate();
+    
+    //==============================================================================
+    const std::size_t K = 2 * sofa::FFT::GetNextPowerOfTwo( sofa::smax( N, (std::size_t) 1 ) );
+    const sofa::FFT fft( K );
+    const std::size_t B = fft.GetNumBins();
+    
+    /// fractional FFT bin of each frequency of the grid
+    std::vector< std::size_t > bins( F );
+    std::vector< double > fractions( F );
+    
+    for( std::size_t k = 0; k < F; k++ )
+    {
+        const double position = sofa::smin( frequencies[k] * static_cast< double >( K ) / samplingRate, static_cast< double >( B - 1 ) );
+        
+        bins[k]      = sofa::smin( static_cast< std::size_t >( position ), B - 2 );
+        fractions[k] = position - static_cast< double >( bins[k] );
+    }
+    
+    /// one workspace per thread
+    const unsigned int numWorkers = sofa::Threads::GetNumThreads( numThreads );
+    
+    std::vector< std::vector< double > > buffers( numWorkers, std::vector< double >( K ) );
+    std::vector< std::vector< std::complex< double > > > spectrums( numWorkers, std::vector< std::complex< double > >( B ) );
+    std::vector< std::vector< double > > powers( numWorkers, std::vector< double >( B ) );
+    
+    subject.spectra.resize( M * R * F );
+    
+    sofa::Threads::ParallelFor( M * R,
+                                [&]( const std::size_t i, const unsigned int threadIndex )
+                                {
+                                    std::vector< double > &buffer = buffers[ threadIndex ];
+                                    std::vector< std::complex< double > > &spectrum = spectrums[ threadIndex ];
+                                    std::vector< double > &power = powers[ threadIndex ];
+                                    
+                                    const double *response = responses.GetResponse( i );
+                                    
+                                    std::copy( response, response + N, buffer.begin() );
+                                    std::fill( buffer.begin() + N, buffer.end(), 0.0 );
+                                    
+                                    fft.ForwardReal( &spectrum[0], &buffer[0] );
+                                    
+                                    for( std::size_t b = 0; b < B; b++ )
+                                    {
+                                        power[b] = std::norm( spectrum[b] );
+                                    }
+                                    
+                                    double *destination = &subject.spectra[ i * F ];
+                                    
+                                    for( std::size_t k = 0; k < F; k++ )
+                                    {
+                                        const double value = power[ bins[k] ] + fractions[k] * ( power[ bins[k] + 1 ] - power[ bins[k] ] );
+                                        
+                                        destination[k] = 10.0 * std::log10( sofa::smax( value, 1e-20 ) );
+                                    }
+                                },
+                                numWorkers );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the path of the cache file of a SOFA file, which depends on
+ *                  its path and the frequency grid
+ *
+ */
+/************************************************************************************/
+std::string SpectralDistance::getCachePath(const std::string &path,
+                                           const std::string &cacheDirectory) const
+{
+    std::ostringstream key;
+    key << path << "|" << frequencies.size();
+    key << "|" << std::setprecision( 17 ) << frequencies.front() << "|" << frequencies.back();
+    
+    std::ostringstream cachePath;
+    cachePath << cacheDirectory;
+    
+    const char last = cacheDirectory[ cacheDirectory.size() - 1 ];
+    if( last != '/' && last != '\\' )
+    {
+        cachePath << "/";
+    }
+    
+    cachePath << std::hex << std::setw( 16 ) << std::setfill( '0' ) << sofaLocal::Hash( key.str() ) << ".lsd";
+    
+    return cachePath.str();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads the spectra of a file from the cache
+ *  @param[in]      contentHash : hash of the responses, directions and sampling rate
+ *  @return         false if there is no valid cache file (missing, or computed from
+ *                  other values)
+ *
+ *  @details        The cache files are in the native byte order
+ */
+/************************************************************************************/
+bool SpectralDistance::readCache(sofa::SpectralDistance::Subject &subject,
+                                 const std::string &cachePath,
+                                 const unsigned long long contentHash) const
+{
+    std::ifstream stream( cachePath.c_str(), std::ios::binary );
+    
+    if( stream.is_open() == false )
+    {
+        return false;
+    }
+    
+    char magic[8];
+    unsigned long long header[4];
+    double grid[2];
+    
+    stream.read( magic, sizeof( magic ) );
+    stream.read( reinterpret_cast< char * >( header ), sizeof( header ) );
+    stream.read( reinterpret_cast< char * >( grid ), sizeof( grid ) );
+    
+    if( stream.good() == false
+       || std::memcmp( magic, sofaLocal::kCacheMagic, sizeof( magic ) ) != 0
+       || header[0] != contentHash
+       || header[1] != frequencies.size()
+       || grid[0] != frequencies.front()
+       || grid[1] != frequencies.back() )
+    {
+        return false;
+    }
+    
+    const std::size_t M = static_cast< std::size_t >( header[2] );
+    const std::size_t R = static_cast< std::size_t >( header[3] );
+    
+    subject.numMeasurements = M;
+    subject.numReceivers    = R;
+    subject.directions.resize( M * 3 );
+    subject.spectra.resize( M * R * frequencies.size() );
+    
+    stream.read( reinterpret_cast< char * >( &subject.directions[0] ), subject.directions.size() * sizeof( double ) );
+    stream.read( reinterpret_cast< char * >( &subject.spectra[0] ), subject.spectra.size() * sizeof( double ) );
+    
+    return stream.good();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the spectra of a file to the cache
+ *
+ *  @details        A cache that cannot be written is not an error : the spectra are
+ *                  computed again next time
+ */
+/************************************************************************************/
+void SpectralDistance::writeCache(const sofa::SpectralDistance::Subject &subject,
+                                  const std::string &cachePath,
+                                  const unsigned long long contentHash) const
+{
+    std::ofstream stream( cachePath.c_str(), std::ios::binary | std::ios::trunc );
+    
+    if( stream.is_open() == false )
+    {
+        return;
+    }
+    
+    const unsigned long long header[4] = { contentHash, frequencies.size(), subject.numMeasurements, subject.numReceivers };
+    const double grid[2] = { frequencies.front(), frequencies.back() };
+    
+    stream.write( sofaLocal::kCacheMagic, sizeof( sofaLocal::kCacheMagic ) );
+    stream.write( reinterpret_cast< const char * >( header ), sizeof( header ) );
+    stream.write( reinterpret_cast< const char * >( grid ), sizeof( grid ) );
+    stream.write( reinterpret_cast< const char * >( &subject.directions[0] ), subject.directions.size() * sizeof( double ) );
+    stream.write( reinterpret_cast< const char * >( &subject.spectra[0] ), subject.spectra.size() * sizeof( double ) );
+}
+
+std::size_t SpectralDistance::GetNumSubjects() const
+{
+    return numSubjects;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of directions shared by all the subjects
+ *
+ */
+/************************************************************************************/
+std::size_t SpectralDistance::GetNumDirections() const
+{
+    return numDirections;
+}
+
+std::size_t SpectralDistance::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t SpectralDistance::GetNumBins() const
+{
+    return frequencies.size();
+}
+
+double SpectralDistance::GetFrequency(const std::size_t bin) const
+{
+    SOFA_ASSERT( bin < frequencies.size() );
+    
+    return frequencies[ bin ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the log-spectral distance between two subjects, in dB
+ *
+ */
+/************************************************************************************/
+double SpectralDistance::GetDistance(const std::size_t subject1,
+                                     const std::size_t subject2) const
+{
+    SOFA_ASSERT( subject1 < numSubjects && subject2 < numSubjects );
+    
+    return distances[ subject1 * numSubjects + subject2 ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the distance matrix [numSubjects numSubjects], in dB
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & SpectralDistance::GetDistances() const
+{
+    return distances;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the other subject with the smallest distance to a subject
+ *
+ */
+/************************************************************************************/
+std::size_t SpectralDistance::GetNearestSubject(const std::size_t subject) const
+{
+    SOFA_ASSERT( subject < numSubjects && numSubjects > 1 );
+    
+    std::size_t nearest = ( subject == 0 ) ? 1 : 0;
+    
+    for( std::size_t s = 0; s < numSubjects; s++ )
+    {
+        if( s != subject && distances[ subject * numSubjects + s ] < distances[ subject * numSubjects + nearest ] )
+        {
+            nearest = s;
+        }
+    }
+    
+    return nearest;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Prints the distance matrix, one row per line (comma-separated)
+ *
+ */
+/************************************************************************************/
+void SpectralDistance::PrintDistances(std::ostream &output) const
+{
+    for( std::size_t i = 0; i < numSubjects; i++ )
+    {
+        for( std::size_t j = 0; j < numSubjects; j++ )
+        {
+            output << distances[ i * numSubjects + j ];
+            output << ( ( j + 1 < numSubjects ) ? ", " : "\n" );
+        }
+    }
+}
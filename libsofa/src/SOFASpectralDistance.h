@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASpectralDistance.h
+ *   @brief      Log-spectral distances between the HRTF sets of several subjects
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SPECTRAL_DISTANCE_H__
+#define _SOFA_SPECTRAL_DISTANCE_H__
+
+#include "../src/SOFAImpulseResponses.h"
+#include <iostream>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          SpectralDistance
+     *  @brief          Matrix of the log-spectral distances between the HRTF sets of
+     *                  several subjects (e.g. to select the best-matching set for a listener)
+     *
+     *  @details        The power spectra of each file are sampled on a common grid of
+     *                  logarithmically spaced frequencies, so that files with different
+     *                  sampling rates or lengths can be compared, and converted to dB; the
+     *                  upper frequency of the grid must be below the Nyquist frequency of
+     *                  every file.
+     *                  The directions of the first subject are the reference : each of them
+     *                  is matched to the nearest measurement of every subject, and only the
+     *                  directions matched within maxAngle for all the subjects are compared.
+     *                  The distance between two subjects is the root mean square of the
+     *                  differences (dB) over the shared directions, the receivers and the bins.
+     *                  The spectra of each file can be cached in a directory. The responses
+     *                  are still read and hashed, so that a modified file is detected : a
+     *                  cached file only saves the FFTs and the sampling of the spectra.
+     *                  The files are read one after the other (netCDF is not thread-safe);
+     *                  the responses of a file, the alignment and the pairs of subjects
+     *                  are spread over threads.
+     */
+    /************************************************************************************/
+    class SOFA_API SpectralDistance
+    {
+    public:
+        SpectralDistance();
+        ~SpectralDistance() {};
+        
+        //==============================================================================
+        void Compute(const std::vector< std::string > &paths,
+                     const std::string &cacheDirectory = "",
+                     const std::size_t numBins = 128,
+                     const double lowFrequency = 200.0,
+                     const double highFrequency = 16000.0,
+                     const double maxAngle = 5.0,
+                     const unsigned int numThreads = 0);
+        
+        //==============================================================================
+        std::size_t GetNumSubjects() const;
+        std::size_t GetNumDirections() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetNumBins() const;
+        
+        double GetFrequency(const std::size_t bin) const;
+        
+        double GetDistance(const std::size_t subject1,
+                           const std::size_t subject2) const;
+        
+        const std::vector< double > & GetDistances() const;
+        
+        std::size_t GetNearestSubject(const std::size_t subject) const;
+        
+        void PrintDistances(std::ostream &output = std::cout) const;
+        
+    protected:
+        //==============================================================================
+        /// the power spectra of one file, in dB, and its directions
+        struct Subject
+        {
+            std::vector< double > directions;   ///< [M 3] unit vectors
+            std::vector< double > spectra;      ///< [M R numBins]
+            std::size_t numMeasurements;
+            std::size_t numReceivers;
+        };
+        
+        void loadSubject(sofa::SpectralDistance::Subject &subject,
+                         const std::string &path,
+                         const std::string &cacheDirectory,
+                         const unsigned int numThreads) const;
+        
+        void analyze(sofa::SpectralDistance::Subject &subject,
+                     const sofa::ImpulseResponses &responses,
+                     const unsigned int numThreads) const;
+        
+        std::string getCachePath(const std::string &path,
+                                 const std::string &cacheDirectory) const;
+        
+        bool readCache(sofa::SpectralDistance::Subject &subject,
+                       const std::string &cachePath,
+                       const unsigned long long contentHash) const;
+        
+        void writeCache(const sofa::SpectralDistance::Subject &subject,
+                        const std::string &cachePath,
+                        const unsigned long long contentHash) const;
+        
+    protected:
+        std::size_t numSubjects;
+        std::size_t numDirections;
+        std::size_t numReceivers;
+        std::vector< double > frequencies;      ///< [numBins]
+        std::vector< double > distances;        ///< [numSubjects numSubjects]
+    };
+    
+}
+
+#endif /* _SOFA_SPECTRAL_DISTANCE_H__ */
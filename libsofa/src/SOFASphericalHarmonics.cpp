@@ -0,0 +1,212 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASphericalHarmonics.cpp
+ *   @brief      Real spherical harmonics
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASphericalHarmonics.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <cmath>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of a normalization
+ *
+ */
+/************************************************************************************/
+std::string SphericalHarmonics::GetName(const sofa::SphericalHarmonics::Normalization &normalization)
+{
+    switch( normalization )
+    {
+        case sofa::SphericalHarmonics::kN3D                 : return "N3D";
+        case sofa::SphericalHarmonics::kSN3D                : return "SN3D";
+            
+        default                                             : SOFA_ASSERT( false ); return "";
+        case sofa::SphericalHarmonics::kNumNormalizations   : SOFA_ASSERT( false ); return "";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of harmonics up to a given order, (order + 1)^2
+ *
+ */
+/************************************************************************************/
+std::size_t SphericalHarmonics::GetNumCoefficients(const unsigned int order)
+{
+    return static_cast< std::size_t >( order + 1 ) * static_cast< std::size_t >( order + 1 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the ACN index of the harmonic of degree n and index m
+ *
+ */
+/************************************************************************************/
+std::size_t SphericalHarmonics::GetIndex(const unsigned int degree, const int m)
+{
+    SOFA_ASSERT( m >= -static_cast< int >( degree ) && m <= static_cast< int >( degree ) );
+    
+    return static_cast< std::size_t >( static_cast< long >( degree ) * ( degree + 1 ) + m );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the degree n of the harmonic of a given ACN index
+ *
+ */
+/************************************************************************************/
+unsigned int SphericalHarmonics::GetDegree(const std::size_t index)
+{
+    unsigned int degree = static_cast< unsigned int >( std::sqrt( static_cast< double >( index ) ) );
+    
+    while( static_cast< std::size_t >( degree + 1 ) * ( degree + 1 ) <= index )
+    {
+        degree++;
+    }
+    while( static_cast< std::size_t >( degree ) * degree > index )
+    {
+        degree--;
+    }
+    
+    return degree;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Evaluates the harmonics up to a given order, for one direction
+ *  @param[out]     values : GetNumCoefficients( order ) values, in ACN order
+ *  @param[in]      azimuth : in degrees
+ *  @param[in]      elevation : in degrees
+ *
+ *  @details        The associated Legendre functions are computed with the usual
+ *                  recurrences on the degree
+ */
+/************************************************************************************/
+void SphericalHarmonics::Evaluate(double *values,
+                                  const unsigned int order,
+                                  const double azimuth,
+                                  const double elevation,
+                                  const sofa::SphericalHarmonics::Normalization &normalization)
+{
+    const double phi    = sofa::DegreesToRadians( azimuth );
+    const double x      = std::sin( sofa::DegreesToRadians( elevation ) );
+    const double c      = std::sqrt( sofa::smax( 0.0, 1.0 - x * x ) );
+    
+    const int L = static_cast< int >( order );
+    
+    double pmm = 1.0;       ///< P_m^m( x )
+    
+    for( int m = 0; m <= L; m++ )
+    {
+        if( m > 0 )
+        {
+            pmm *= ( 2.0 * m - 1.0 ) * c;
+        }
+        
+        const double cosine    = std::cos( m * phi );
+        const double sine      = std::sin( m * phi );
+        
+        double p2 = 0.0;    ///< P_{n-2}^m
+        double p1 = 0.0;    ///< P_{n-1}^m
+        
+        for( int n = m; n <= L; n++ )
+        {
+            const double p = ( n == m ) ? pmm : ( ( 2.0 * n - 1.0 ) * x * p1 - ( n + m - 1.0 ) * p2 ) / static_cast< double >( n - m );
+            
+            p2 = p1;
+            p1 = p;
+            
+            /// sqrt( ( 2 - delta_m ) ( n - m )! / ( n + m )! ), times sqrt( 2 n + 1 ) for N3D
+            double norm = std::exp( 0.5 * ( std::lgamma( n - m + 1.0 ) - std::lgamma( n + m + 1.0 ) ) );
+            
+            if( m > 0 )
+            {
+                norm *= std::sqrt( 2.0 );
+            }
+            if( normalization == kN3D )
+            {
+                norm *= std::sqrt( 2.0 * n + 1.0 );
+            }
+            
+            values[ GetIndex( n, m ) ] = norm * p * cosine;
+            
+            if( m > 0 )
+            {
+                values[ GetIndex( n, -m ) ] = norm * p * sine;
+            }
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the matrix of the harmonics for a set of directions
+ *  @param[out]     matrix : [D GetNumCoefficients( order )]
+ *  @param[in]      directions : [D 3] cartesian directions (not necessarily normalized)
+ *
+ */
+/************************************************************************************/
+void SphericalHarmonics::GetMatrix(std::vector< double > &matrix,
+                                   const std::vector< double > &directions,
+                                   const unsigned int order,
+                                   const sofa::SphericalHarmonics::Normalization &normalization)
+{
+    const std::size_t D = directions.size() / 3;
+    const std::size_t Q = GetNumCoefficients( order );
+    
+    matrix.resize( D * Q );
+    
+    for( std::size_t d = 0; d < D; d++ )
+    {
+        double aed[3];
+        sofa::CartesianToSpherical( aed, &directions[ 3 * d ] );
+        
+        Evaluate( &matrix[ d * Q ], order, aed[0], aed[1], normalization );
+    }
+}
@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASphericalHarmonics.h
+ *   @brief      Real spherical harmonics
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SPHERICAL_HARMONICS_H__
+#define _SOFA_SPHERICAL_HARMONICS_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          SphericalHarmonics
+     *  @brief          Static class to evaluate real spherical harmonics
+     *
+     *  @details        The harmonics are ordered by ACN (index n^2 + n + m, for
+     *                  degree n and -n <= m <= n), without the Condon-Shortley phase,
+     *                  as in Ambisonics. Azimuth (counterclockwise from the x axis)
+     *                  and elevation are in degrees, as in SOFA spherical coordinates.
+     */
+    /************************************************************************************/
+    class SOFA_API SphericalHarmonics
+    {
+    public:
+        
+        enum Normalization
+        {
+            kN3D                = 0,    ///< orthonormal (up to 4 pi)
+            kSN3D               = 1,    ///< Schmidt semi-normalized (AmbiX)
+            kNumNormalizations  = 2
+        };
+        
+    public:
+        static std::string GetName(const sofa::SphericalHarmonics::Normalization &normalization);
+        
+        static std::size_t GetNumCoefficients(const unsigned int order);
+        static std::size_t GetIndex(const unsigned int degree, const int m);
+        static unsigned int GetDegree(const std::size_t index);
+        
+        static void Evaluate(double *values,
+                             const unsigned int order,
+                             const double azimuth,
+                             const double elevation,
+                             const sofa::SphericalHarmonics::Normalization &normalization = kN3D);
+        
+        static void GetMatrix(std::vector< double > &matrix,
+                              const std::vector< double > &directions,
+                              const unsigned int order,
+                              const sofa::SphericalHarmonics::Normalization &normalization = kN3D);
+        
+    private:
+        SphericalHarmonics() SOFA_DELETED_FUNCTION;
+    };
+    
+}
+
+#endif /* _SOFA_SPHERICAL_HARMONICS_H__ */
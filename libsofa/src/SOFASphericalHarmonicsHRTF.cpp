@@ -0,0 +1,549 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASphericalHarmonicsHRTF.cpp
+ *   @brief      Spherical-harmonic representation of HRTF sets
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASphericalHarmonicsHRTF.h"
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAMeasurementOrder.h"
+#include "../src/SOFATransferFunctions.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// number of frequency bins fitted by one task
+    static const std::size_t kBinsPerTask = 16;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : an empty model
+ *
+ */
+/************************************************************************************/
+SphericalHarmonicsHRTF::SphericalHarmonicsHRTF()
+: order( 0 )
+, numReceivers( 0 )
+, numBins( 0 )
+, fftSize( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, regularization( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Fits the model on the responses of a FIR file (e.g. SimpleFreeFieldHRIR)
+ *  @param[in]      order : maximum order of the harmonics
+ *  @param[in]      regularization : Tikhonov parameter, relative to the energy of the harmonics
+ *  @param[in]      fftSize : power of 2, not smaller than N (0 for the default size)
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ *  @details        The directions are the SourcePosition relative to the ListenerPosition
+ */
+/************************************************************************************/
+void SphericalHarmonicsHRTF::Fit(const sofa::File &file,
+                                 const unsigned int order_,
+                                 const double regularization_,
+                                 const std::size_t fftSize_,
+                                 const unsigned int numThreads)
+{
+    sofa::ImpulseResponses responses;
+    responses.Load( file );
+    
+    std::vector< double > directions;
+    sofa::MeasurementOrder::GetMeasurementDirections( file, directions );
+    
+    Fit( responses, directions, order_, regularization_, fftSize_, numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Fits the model on the transfer functions of a GeneralTF file
+ *
+ *  @details        The frequency axis is the N variable of the file; the file must
+ *                  have one emitter
+ */
+/************************************************************************************/
+void SphericalHarmonicsHRTF::Fit(const sofa::GeneralTF &file,
+                                 const unsigned int order_,
+                                 const double regularization_,
+                                 const unsigned int numThreads)
+{
+    const std::size_t M = file.GetNumMeasurements();
+    
+    if( file.GetNumEmitters() != 1 )
+    {
+        SOFA_THROW( "the transfer functions must have one emitter" );
+    }
+    
+    std::vector< double > directions;
+    sofa::MeasurementOrder::GetMeasurementDirections( file, directions );
+    
+    if( file.GetFrequencies( frequencies ) == false )
+    {
+        SOFA_THROW( "cannot read the frequencies (N variable)" );
+    }
+    
+    order           = order_;
+    regularization  = regularization_;
+    numReceivers    = file.GetNumReceivers();
+    numBins         = file.GetNumDataSamples();
+    numDataSamples  = 0;
+    
+    if( file.IsFFTFrequencyAxis( fftSize, samplingRate ) == false )
+    {
+        fftSize         = 0;
+        samplingRate    = 0.0;
+    }
+    
+    std::vector< std::complex< double > > spectra( M * numReceivers * numBins );
+    
+    if( spectra.empty() == false && file.GetDataTF( &spectra[0], 0, M ) == false )
+    {
+        SOFA_THROW( "cannot read the transfer functions" );
+    }
+    
+    const std::size_t Q = GetNumCoefficients();
+    
+    std::vector< double > harmonics;
+    sofa::SphericalHarmonics::GetMatrix( harmonics, directions, order );
+    
+    std::vector< double > pseudoInverse;
+    sofa::LinearAlgebra::GetRegularizedPseudoInverse( pseudoInverse, harmonics, M, Q, regularization );
+    
+    fitSpectra( spectra.empty() == true ? NULL : &spectra[0], pseudoInverse, M, numThreads );
+    
+    delayCoefficients.clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Fits the model on a set of responses
+ *  @param[in]      responses : [M R N] responses (one emitter)
+ *  @param[in]      directions : [M 3] cartesian direction of each measurement
+ *
+ */
+/************************************************************************************/
+void SphericalHarmonicsHRTF::Fit(const sofa::ImpulseResponses &responses,
+                                 const std::vector< double > &directions,
+                                 const unsigned int order_,
+                                 const double regularization_,
+                                 const std::size_t fftSize_,
+                                 const unsigned int numThreads)
+{
+    const std::size_t M = responses.GetNumMeasurements();
+    const std::size_t N = responses.GetNumDataSamples();
+    const std::size_t K = ( fftSize_ == 0 ) ? sofa::TransferFunctions::GetDefaultFFTSize( N ) : fftSize_;
+    
+    if( responses.GetNumEmitters() != 1 )
+    {
+        SOFA_THROW( "the responses must have one emitter" );
+    }
+    
+    if( directions.size() != 3 * M )
+    {
+        SOFA_THROW( "one direction per measurement is required" );
+    }
+    
+    if( sofa::FFT::IsPowerOfTwo( K ) == false || K < N )
+    {
+        SOFA_THROW( "the FFT size must be a power of 2, not smaller than the responses" );
+    }
+    
+    order           = order_;
+    regularization  = regularization_;
+    numReceivers    = responses.GetNumReceivers();
+    fftSize         = K;
+    numBins         = K / 2 + 1;
+    numDataSamples  = N;
+    samplingRate    = responses.GetSamplingRate();
+    
+    frequencies.resize( numBins );
+    for( std::size_t k = 0; k < numBins; k++ )
+    {
+        frequencies[k] = static_cast< double >( k ) * samplingRate / static_cast< double >( K );
+    }
+    
+    //==============================================================================
+    /// spectra of the responses, without their delays
+    const std::size_t numResponses = responses.GetNumResponses();
+    
+    std::vector< std::complex< double > > spectra( numResponses * numBins );
+    
+    const sofa::FFT fft( K );
+    
+    const unsigned int numWorkers = sofa::Threads::GetNumThreads( numThreads );
+    std::vector< std::vector< double > > buffers( numWorkers, std::vector< double >( K, 0.0 ) );
+    
+    sofa::Threads::ParallelFor( numResponses,
+                                [&]( const std::size_t i, const unsigned int threadIndex )
+                                {
+                                    std::vector< double > &buffer = buffers[ threadIndex ];
+                                    
+                                    const double *response = responses.GetResponse( i );
+                                    std::copy( response, response + N, buffer.begin() );
+                                    std::fill( buffer.begin() + N, buffer.end(), 0.0 );
+                                    
+                                    fft.ForwardReal( &spectra[ i * numBins ], &buffer[0] );
+                                },
+                                numWorkers );
+    
+    //==============================================================================
+    const std::size_t Q = GetNumCoefficients();
+    
+    std::vector< double > harmonics;
+    sofa::SphericalHarmonics::GetMatrix( harmonics, directions, order );
+    
+    std::vector< double > pseudoInverse;
+    sofa::LinearAlgebra::GetRegularizedPseudoInverse( pseudoInverse, harmonics, M, Q, regularization );
+    
+    fitSpectra( spectra.empty() == true ? NULL : &spectra[0], pseudoInverse, M, numWorkers );
+    
+    //==============================================================================
+    /// the delays are fitted only if they vary across the measurements
+    const std::vector< double > &delays = responses.GetDelays();
+    
+    bool constantDelays = true;
+    for( std::size_t i = 0; i < delays.size() && constantDelays == true; i++ )
+    {
+        constantDelays = ( delays[i] == delays[ i % numReceivers ] );
+    }
+    
+    delayCoefficients.clear();
+    
+    if( constantDelays == false )
+    {
+        delayCoefficients.assign( numReceivers * Q, 0.0 );
+        
+        for( std::size_t r = 0; r < numReceivers; r++ )
+        {
+            for( std::size_t q = 0; q < Q; q++ )
+            {
+                double sum = 0.0;
+                for( std::size_t m = 0; m < M; m++ )
+                {
+                    sum += pseudoInverse[ q * M + m ] * delays[ m * numReceivers + r ];
+                }
+                delayCoefficients[ r * Q + q ] = sum;
+            }
+        }
+    }
+    else if( delays.empty() == false
+            && std::count( delays.begin(), delays.begin() + numReceivers, 0.0 ) != static_cast< long >( numReceivers ) )
+    {
+        /// a constant delay is the (scaled) coefficient of the omnidirectional harmonic
+        delayCoefficients.assign( numReceivers * Q, 0.0 );
+        
+        for( std::size_t r = 0; r < numReceivers; r++ )
+        {
+            delayCoefficients[ r * Q ] = delays[r];
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Fits the coefficients of the model on a set of spectra
+ *  @param[in]      spectra : [M R numBins]
+ *  @param[in]      pseudoInverse : [Q M]
+ *
+ */
+/************************************************************************************/
+void SphericalHarmonicsHRTF::fitSpectra(const std::complex< double > *spectra,
+                                        const std::vector< double > &pseudoInverse,
+                                        const std::size_t numMeasurements,
+                                        const unsigned int numThreads)
+{
+    coefficients.assign( numReceivers * GetNumCoefficients() * numBins, std::complex< double >( 0.0, 0.0 ) );
+    harmonicsBuffer.assign( GetNumCoefficients(), 0.0 );
+    
+    if( spectra == NULL || numBins == 0 )
+    {
+        return;
+    }
+    
+    FitSpectra( &coefficients[0], spectra, pseudoInverse, numMeasurements, numReceivers, numBins, numBins, numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Applies the pseudo-inverse of a harmonics matrix to a set of spectra,
+ *                  by blocks of bins spread over threads
+ *  @param[out]     coefficients : [R Q numBins] ; only the first numFittedBins bins
+ *                  are written
+ *  @param[in]      spectra : [M R numBins]
+ *  @param[in]      pseudoInverse : [Q M]
+ *  @param[in]      numFittedBins : number of bins fitted, from DC
+ *
+ */
+/************************************************************************************/
+void SphericalHarmonicsHRTF::FitSpectra(std::complex< double > *coefficients,
+                                        const std::complex< double > *spectra,
+                                        const std::vector< double > &pseudoInverse,
+                                        const std::size_t numMeasurements,
+                                        const std::size_t numReceivers_,
+                                        const std::size_t numBins_,
+                                        const std::size_t numFittedBins,
+                                        const unsigned int numThreads)
+{
+    const std::size_t M = numMeasurements;
+    const std::size_t R = numReceivers_;
+    const std::size_t Q = ( M == 0 ) ? 0 : pseudoInverse.size() / M;
+    const std::size_t B = numBins_;
+    const std::size_t F = sofa::smin( numFittedBins, B );
+    
+    if( F == 0 )
+    {
+        return;
+    }
+    
+    const std::size_t numTasks = ( F + sofaLocal::kBinsPerTask - 1 ) / sofaLocal::kBinsPerTask;
+    
+    sofa::Threads::ParallelFor( numTasks,
+                                [&]( const std::size_t task, const unsigned int )
+                                {
+                                    const std::size_t first     = task * sofaLocal::kBinsPerTask;
+                                    const std::size_t numInTask = sofa::smin( sofaLocal::kBinsPerTask, F - first );
+                                    const std::size_t count     = 2 * numInTask;     ///< in doubles
+                                    
+                                    for( std::size_t i = 0; i < R * Q; i++ )
+                                    {
+                                        std::fill( coefficients + i * B + first,
+                                                   coefficients + i * B + first + numInTask,
+                                                   std::complex< double >( 0.0, 0.0 ) );
+                                    }
+                                    
+                                    for( std::size_t m = 0; m < M; m++ )
+                                    {
+                                        for( std::size_t r = 0; r < R; r++ )
+                                        {
+                                            const double *h = reinterpret_cast< const double * >( spectra + ( m * R + r ) * B + first );
+                                            
+                                            for( std::size_t q = 0; q < Q; q++ )
+                                            {
+                                                const double p  = pseudoInverse[ q * M + m ];
+                                                double *c       = reinterpret_cast< double * >( coefficients + ( r * Q + q ) * B + first );
+                                                
+                                                for( std::size_t k = 0; k < count; k++ )
+                                                {
+                                                    c[k] += p * h[k];
+                                                }
+                                            }
+                                        }
+                                    }
+                                },
+                                numThreads );
+}
+
+unsigned int SphericalHarmonicsHRTF::GetOrder() const
+{
+    return order;
+}
+
+std::size_t SphericalHarmonicsHRTF::GetNumCoefficients() const
+{
+    return sofa::SphericalHarmonics::GetNumCoefficients( order );
+}
+
+std::size_t SphericalHarmonicsHRTF::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t SphericalHarmonicsHRTF::GetNumBins() const
+{
+    return numBins;
+}
+
+std::size_t SphericalHarmonicsHRTF::GetFFTSize() const
+{
+    return fftSize;
+}
+
+std::size_t SphericalHarmonicsHRTF::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+double SphericalHarmonicsHRTF::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+double SphericalHarmonicsHRTF::GetFrequency(const std::size_t bin) const
+{
+    return frequencies[ bin ];
+}
+
+bool SphericalHarmonicsHRTF::HasDelays() const
+{
+    return ( delayCoefficients.empty() == false );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the coefficients of a receiver, [Q numBins]
+ *
+ */
+/************************************************************************************/
+const std::complex< double > * SphericalHarmonicsHRTF::GetCoefficients(const std::size_t receiver) const
+{
+    return &coefficients[ receiver * GetNumCoefficients() * numBins ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reconstructs the transfer function of a direction
+ *  @param[out]     spectrum : numBins values
+ *  @param[in]      harmonics : the GetNumCoefficients() harmonics of the direction
+ *                  (see SphericalHarmonics::Evaluate, N3D)
+ *
+ *  @details        Does not allocate memory : suitable for real-time use
+ */
+/************************************************************************************/
+void SphericalHarmonicsHRTF::Evaluate(std::complex< double > *spectrum,
+                                      const std::size_t receiver,
+                                      const double *harmonics) const
+{
+    const std::size_t Q     = GetNumCoefficients();
+    const std::size_t count = 2 * numBins;     ///< in doubles
+    
+    double *dst = reinterpret_cast< double * >( spectrum );
+    std::fill( dst, dst + count, 0.0 );
+    
+    for( std::size_t q = 0; q < Q; q++ )
+    {
+        const double y      = harmonics[q];
+        const double *src   = reinterpret_cast< const double * >( &coefficients[ ( receiver * Q + q ) * numBins ] );
+        
+        for( std::size_t k = 0; k < count; k++ )
+        {
+            dst[k] += y * src[k];
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reconstructs the transfer function of a direction (in degrees)
+ *
+ *  @details        Does not allocate memory, but the harmonics are computed in a buffer
+ *                  of the model : concurrent calls on the same model must use the
+ *                  overload taking the harmonics
+ */
+/************************************************************************************/
+void SphericalHarmonicsHRTF::Evaluate(std::complex< double > *spectrum,
+                                      const std::size_t receiver,
+                                      const double azimuth,
+                                      const double elevation) const
+{
+    sofa::SphericalHarmonics::Evaluate( &harmonicsBuffer[0], order, azimuth, elevation );
+    
+    Evaluate( spectrum, receiver, &harmonicsBuffer[0] );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reconstructs the delay (in samples) of a direction,
+ *                  0 if the model has no delays
+ *
+ */
+/************************************************************************************/
+double SphericalHarmonicsHRTF::EvaluateDelay(const std::size_t receiver,
+                                             const double *harmonics) const
+{
+    if( delayCoefficients.empty() == true )
+    {
+        return 0.0;
+    }
+    
+    const std::size_t Q = GetNumCoefficients();
+    const double *c     = &delayCoefficients[ receiver * Q ];
+    
+    double delay = 0.0;
+    for( std::size_t q = 0; q < Q; q++ )
+    {
+        delay += c[q] * harmonics[q];
+    }
+    
+    return delay;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reconstructs the impulse response of a direction (in degrees)
+ *  @param[out]     response : GetNumDataSamples() values (without the delay)
+ *
+ *  @details        Only for models fitted on impulse responses
+ */
+/************************************************************************************/
+void SphericalHarmonicsHRTF::EvaluateResponse(double *response,
+                                              const std::size_t receiver,
+                                              const double azimuth,
+                                              const double elevation) const
+{
+    if( fftSize == 0 || numDataSamples == 0 )
+    {
+        SOFA_THROW( "the model was not fitted on impulse responses" );
+    }
+    
+    std::vector< std::complex< double > > spectrum( numBins );
+    Evaluate( &spectrum[0], receiver, azimuth, elevation );
+    
+    std::vector< double > buffer( fftSize );
+    
+    const sofa::FFT fft( fftSize );
+    fft.InverseReal( &buffer[0], &spectrum[0] );
+    
+    std::copy( buffer.begin(), buffer.begin() + numDataSamples, response );
+}
@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASphericalHarmonicsHRTF.h
+ *   @brief      Spherical-harmonic representation of HRTF sets
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SPHERICAL_HARMONICS_HRTF_H__
+#define _SOFA_SPHERICAL_HARMONICS_HRTF_H__
+
+#include "../src/SOFAImpulseResponses.h"
+#include "../src/SOFAGeneralTF.h"
+#include "../src/SOFASphericalHarmonics.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          SphericalHarmonicsHRTF
+     *  @brief          HRTF set represented, for each receiver and frequency bin,
+     *                  by spherical-harmonic coefficients (N3D, ACN)
+     *
+     *  @details        The coefficients are fitted on the measured directions by
+     *                  Tikhonov-regularized least squares : the pseudo-inverse of the
+     *                  harmonics matrix is computed once, and applied to all the
+     *                  frequency bins in parallel.
+     *                  For FIR files, Data.Delay (when it varies across the measurements)
+     *                  is fitted separately, so that the model can be used with
+     *                  minimum-phase sets.
+     *                  The evaluation of a direction is a weighted sum of the coefficient
+     *                  rows, i.e. a contiguous multiply-add over the bins
+     *                  that the compiler vectorizes.
+     */
+    /************************************************************************************/
+    class SOFA_API SphericalHarmonicsHRTF
+    {
+    public:
+        SphericalHarmonicsHRTF();
+        ~SphericalHarmonicsHRTF() {};
+        
+        //==============================================================================
+        void Fit(const sofa::File &file,
+                 const unsigned int order,
+                 const double regularization = 1e-3,
+                 const std::size_t fftSize = 0,
+                 const unsigned int numThreads = 0);
+        
+        void Fit(const sofa::GeneralTF &file,
+                 const unsigned int order,
+                 const double regularization = 1e-3,
+                 const unsigned int numThreads = 0);
+        
+        void Fit(const sofa::ImpulseResponses &responses,
+                 const std::vector< double > &directions,
+                 const unsigned int order,
+                 const double regularization = 1e-3,
+                 const std::size_t fftSize = 0,
+                 const unsigned int numThreads = 0);
+        
+        //==============================================================================
+        unsigned int GetOrder() const;
+        std::size_t GetNumCoefficients() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetNumBins() const;
+        std::size_t GetFFTSize() const;
+        std::size_t GetNumDataSamples() const;
+        double GetSamplingRate() const;
+        double GetFrequency(const std::size_t bin) const;
+        bool HasDelays() const;
+        
+        const std::complex< double > * GetCoefficients(const std::size_t receiver) const;
+        
+        //==============================================================================
+        void Evaluate(std::complex< double > *spectrum,
+                      const std::size_t receiver,
+                      const double *harmonics) const;
+        
+        void Evaluate(std::complex< double > *spectrum,
+                      const std::size_t receiver,
+                      const double azimuth,
+                      const double elevation) const;
+        
+        double EvaluateDelay(const std::size_t receiver,
+                             const double *harmonics) const;
+        
+        void EvaluateResponse(double *response,
+                              const std::size_t receiver,
+                              const double azimuth,
+                              const double elevation) const;
+        
+        //==============================================================================
+        static void FitSpectra(std::complex< double > *coefficients,
+                               const std::complex< double > *spectra,
+                               const std::vector< double > &pseudoInverse,
+                               const std::size_t numMeasurements,
+                               const std::size_t numReceivers,
+                               const std::size_t numBins,
+                               const std::size_t numFittedBins,
+                               const unsigned int numThreads = 0);
+        
+    protected:
+        //==============================================================================
+        void fitSpectra(const std::complex< double > *spectra,
+                        const std::vector< double > &pseudoInverse,
+                        const std::size_t numMeasurements,
+                        const unsigned int numThreads);
+        
+    protected:
+        unsigned int order;
+        std::size_t numReceivers;
+        std::size_t numBins;
+        std::size_t fftSize;                                ///< 0 when fitted on a GeneralTF file
+        std::size_t numDataSamples;                         ///< length of the fitted responses (FIR)
+        double samplingRate;
+        double regularization;
+        
+        std::vector< double > frequencies;                  ///< [numBins]
+        std::vector< std::complex< double > > coefficients; ///< [R Q numBins]
+        std::vector< double > delayCoefficients;            ///< [R Q], empty if the delays are not fitted
+        
+        mutable std::vector< double > harmonicsBuffer;      ///< [Q], used by Evaluate(azimuth, elevation)
+    };
+    
+}
+
+#endif /* _SOFA_SPHERICAL_HARMONICS_HRTF_H__ */
@@ -0,0 +1,370 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASweepDeconvolution.cpp
+ *   @brief      Impulse responses measured with sweeps, deconvolved into SOFA files
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASweepDeconvolution.h"
+#include "../src/SOFAWaveFile.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    static const double kPi = 3.14159265358979323846;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      excitation : the signal played during the measurements
+ *  @param[in]      excitationLength : its number of samples
+ *  @param[in]      samplingRate : sampling rate of the excitation, the recordings and
+ *                  the files written, in Hz
+ *  @param[in]      maxRecordingLength : maximum number of samples of a recording
+ *                  (the excitation, plus the decay of the longest response)
+ *  @param[in]      numChannels : number of recorded channels (i.e. of receivers)
+ *  @param[in]      irLength : number of samples of the windowed responses
+ *  @param[in]      regularizationDB : floor of the excitation power spectrum, in dB below
+ *                  its peak; limits the gain of the inverse outside of the swept band
+ *
+ */
+/************************************************************************************/
+SweepDeconvolution::SweepDeconvolution(const double *excitation,
+                                       const std::size_t excitationLength,
+                                       const double samplingRate_,
+                                       const std::size_t maxRecordingLength_,
+                                       const std::size_t numChannels_,
+                                       const std::size_t irLength_,
+                                       const double regularizationDB)
+: samplingRate( samplingRate_ )
+, numChannels( numChannels_ )
+, maxRecordingLength( maxRecordingLength_ )
+, irLength( irLength_ )
+, fft( sofa::FFT::GetNextPowerOfTwo( sofa::smax( (std::size_t) 2, sofa::smax( maxRecordingLength_ + excitationLength, irLength_ ) ) ) )
+, inverseSpectrum( fft.GetNumBins() )
+, startOffset( 0 )
+, window( irLength_, 1.0 )
+, spectra( numChannels_, std::vector< std::complex< double > >( fft.GetNumBins() ) )
+, buffers( numChannels_, std::vector< double >( fft.GetSize() ) )
+, responses( numChannels_ * irLength_, 0.0 )
+{
+    if( excitation == nullptr || excitationLength == 0 || samplingRate <= 0.0
+       || maxRecordingLength == 0 || numChannels == 0 || irLength == 0 )
+    {
+        SOFA_THROW( "invalid sweep deconvolution settings" );
+    }
+    
+    const std::size_t numBins = fft.GetNumBins();
+    
+    std::vector< double > buffer( fft.GetSize(), 0.0 );
+    std::copy( excitation, excitation + excitationLength, buffer.begin() );
+    
+    fft.ForwardReal( &inverseSpectrum[0], &buffer[0] );
+    
+    double peak = 0.0;
+    for( std::size_t k = 0; k < numBins; k++ )
+    {
+        peak = sofa::smax( peak, std::norm( inverseSpectrum[k] ) );
+    }
+    
+    if( peak == 0.0 )
+    {
+        SOFA_THROW( "the excitation is null" );
+    }
+    
+    const double floor_ = peak * std::pow( 10.0, regularizationDB / 10.0 );
+    
+    /// conj( X ) / ( |X|^2 + floor ) : 1 / X in the swept band, bounded outside
+    for( std::size_t k = 0; k < numBins; k++ )
+    {
+        inverseSpectrum[k] = std::conj( inverseSpectrum[k] ) / ( std::norm( inverseSpectrum[k] ) + floor_ );
+    }
+    
+    SetWindow( 0, 0, irLength / 8 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Generates an exponential (logarithmic) sine sweep
+ *  @param[out]     sweep : length samples
+ *  @param[in]      startFrequency, endFrequency : in Hz
+ *
+ */
+/************************************************************************************/
+void SweepDeconvolution::GenerateSweep(double *sweep,
+                                       const std::size_t length,
+                                       const double samplingRate,
+                                       const double startFrequency,
+                                       const double endFrequency)
+{
+    if( samplingRate <= 0.0 || startFrequency <= 0.0 || endFrequency <= startFrequency )
+    {
+        SOFA_THROW( "invalid sweep settings" );
+    }
+    
+    const double duration   = static_cast< double >( length ) / samplingRate;
+    const double rate       = std::log( endFrequency / startFrequency );
+    const double factor     = 2.0 * sofaLocal::kPi * startFrequency * duration / rate;
+    
+    for( std::size_t n = 0; n < length; n++ )
+    {
+        const double time = static_cast< double >( n ) / samplingRate;
+        
+        sweep[n] = std::sin( factor * ( std::exp( time * rate / duration ) - 1.0 ) );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the window applied to the deconvolved responses
+ *  @param[in]      startOffset : sample of the deconvolved response where the window
+ *                  starts (e.g. the latency of the measurement system, or a negative
+ *                  value to keep a few samples before it)
+ *  @param[in]      fadeInLength, fadeOutLength : lengths of the half-Hann fades
+ *
+ *  @details        By default, the window starts at 0, and fades out over the last
+ *                  eighth of the response
+ */
+/************************************************************************************/
+void SweepDeconvolution::SetWindow(const long startOffset_,
+                                   const std::size_t fadeInLength,
+                                   const std::size_t fadeOutLength)
+{
+    if( fadeInLength + fadeOutLength > irLength )
+    {
+        SOFA_THROW( "the fades are longer than the responses" );
+    }
+    
+    startOffset = startOffset_;
+    
+    std::fill( window.begin(), window.end(), 1.0 );
+    
+    for( std::size_t n = 0; n < fadeInLength; n++ )
+    {
+        window[n] = 0.5 - 0.5 * std::cos( sofaLocal::kPi * static_cast< double >( n ) / static_cast< double >( fadeInLength ) );
+    }
+    
+    for( std::size_t n = 0; n < fadeOutLength; n++ )
+    {
+        window[ irLength - 1 - n ] = 0.5 - 0.5 * std::cos( sofaLocal::kPi * static_cast< double >( n ) / static_cast< double >( fadeOutLength ) );
+    }
+}
+
+double SweepDeconvolution::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+std::size_t SweepDeconvolution::GetNumChannels() const
+{
+    return numChannels;
+}
+
+std::size_t SweepDeconvolution::GetMaxRecordingLength() const
+{
+    return maxRecordingLength;
+}
+
+std::size_t SweepDeconvolution::GetIRLength() const
+{
+    return irLength;
+}
+
+std::size_t SweepDeconvolution::GetFFTSize() const
+{
+    return fft.GetSize();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Deconvolves and windows the recording of one channel
+ *
+ */
+/************************************************************************************/
+void SweepDeconvolution::processChannel(double *ir,
+                                        const double *recording,
+                                        const std::size_t recordingLength,
+                                        const std::size_t channel)
+{
+    std::vector< std::complex< double > > &spectrum = spectra[ channel ];
+    std::vector< double > &buffer = buffers[ channel ];
+    
+    const std::size_t size      = fft.GetSize();
+    const std::size_t numBins   = fft.GetNumBins();
+    
+    std::copy( recording, recording + recordingLength, buffer.begin() );
+    std::fill( buffer.begin() + recordingLength, buffer.end(), 0.0 );
+    
+    fft.ForwardReal( &spectrum[0], &buffer[0] );
+    
+    for( std::size_t k = 0; k < numBins; k++ )
+    {
+        spectrum[k] *= inverseSpectrum[k];
+    }
+    
+    fft.InverseReal( &buffer[0], &spectrum[0] );
+    
+    /// negative times are at the end of the circular result
+    const long size_ = static_cast< long >( size );
+    std::size_t index = static_cast< std::size_t >( ( ( startOffset % size_ ) + size_ ) % size_ );
+    
+    for( std::size_t n = 0; n < irLength; n++ )
+    {
+        ir[n] = buffer[ index ] * window[n];
+        
+        index = ( index + 1 == size ) ? 0 : index + 1;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Deconvolves the recordings of one measurement
+ *  @param[out]     irs : the windowed responses [numChannels irLength]
+ *  @param[in]      recordings : numChannels buffers of recordingLength samples
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ */
+/************************************************************************************/
+void SweepDeconvolution::Process(double *irs,
+                                 const double * const *recordings,
+                                 const std::size_t recordingLength,
+                                 const unsigned int numThreads)
+{
+    if( recordingLength > maxRecordingLength )
+    {
+        SOFA_THROW( "the recording is longer than the maximum recording length" );
+    }
+    
+    sofa::Threads::ParallelFor( numChannels,
+                                [&]( const std::size_t c, const unsigned int )
+                                {
+                                    processChannel( irs + c * irLength, recordings[c], recordingLength, c );
+                                },
+                                numThreads );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Deconvolves the recordings of one measurement, and appends the
+ *                  responses to a file
+ *  @param[in]      writer : a file with R = numChannels, N = irLength and the sampling
+ *                  rate of the excitation (e.g. a SimpleFreeFieldHRIR or SingleRoomDRIR file)
+ *  @param[in]      sourcePosition : the SourcePosition of the measurement, or nullptr
+ *
+ */
+/************************************************************************************/
+void SweepDeconvolution::Process(sofa::MeasurementWriter &writer,
+                                 const double * const *recordings,
+                                 const std::size_t recordingLength,
+                                 const double *sourcePosition,
+                                 const unsigned int numThreads)
+{
+    if( writer.GetMeasurementSize( "Data.IR" ) != responses.size() )
+    {
+        SOFA_THROW( "the responses do not match the dimensions of " + writer.GetFilename() );
+    }
+    
+    if( writer.GetSamplingRate() != samplingRate )
+    {
+        SOFA_THROW( "the sampling rate of " + writer.GetFilename() + " does not match the excitation" );
+    }
+    
+    Process( &responses[0], recordings, recordingLength, numThreads );
+    
+    writer.AppendMeasurement( &responses[0], nullptr, sourcePosition );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Deconvolves a multichannel WAV recording, and appends the responses
+ *                  to a file
+ *
+ */
+/************************************************************************************/
+void SweepDeconvolution::Process(sofa::MeasurementWriter &writer,
+                                 const std::string &recordingPath,
+                                 const double *sourcePosition,
+                                 const unsigned int numThreads)
+{
+    sofa::WaveReader reader( recordingPath );
+    
+    if( reader.GetNumChannels() != numChannels )
+    {
+        SOFA_THROW( recordingPath + " does not have the expected number of channels" );
+    }
+    
+    if( reader.GetSamplingRate() != samplingRate )
+    {
+        SOFA_THROW( "the sampling rate of " + recordingPath + " does not match the excitation" );
+    }
+    
+    const std::size_t recordingLength = reader.GetNumFrames();
+    
+    if( recordingLength > maxRecordingLength )
+    {
+        SOFA_THROW( recordingPath + " is longer than the maximum recording length" );
+    }
+    
+    if( recordingBuffers.empty() == true )
+    {
+        recordingBuffers.assign( numChannels, std::vector< double >( maxRecordingLength ) );
+    }
+    
+    std::vector< double * > channels( numChannels );
+    for( std::size_t c = 0; c < numChannels; c++ )
+    {
+        channels[c] = &recordingBuffers[c][0];
+    }
+    
+    reader.Read( &channels[0], recordingLength );
+    
+    Process( writer, &channels[0], recordingLength, sourcePosition, numThreads );
+}
@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASweepDeconvolution.h
+ *   @brief      Impulse responses measured with sweeps, deconvolved into SOFA files
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SWEEP_DECONVOLUTION_H__
+#define _SOFA_SWEEP_DECONVOLUTION_H__
+
+#include "../src/SOFAMeasurementWriter.h"
+#include "../src/SOFAFFT.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          SweepDeconvolution
+     *  @brief          Deconvolves the multichannel recordings of a sweep (e.g. an
+     *                  exponential sine sweep, see GenerateSweep()) into windowed impulse
+     *                  responses, and appends them to a FIR file
+     *
+     *  @details        The regularized inverse spectrum of the excitation is computed once.
+     *                  Each recording is then deconvolved with one forward and one inverse
+     *                  FFT, the channels being processed in parallel.
+     *                  The FFT size holds the linear convolution of the longest recording
+     *                  with the excitation : the harmonic distortion products of an
+     *                  exponential sweep land before the linear response (i.e. at the end
+     *                  of the circular result), and are removed by the window.
+     *                  Each measurement is written as soon as it is deconvolved
+     *                  (see MeasurementWriter), so that the recordings do not need
+     *                  to be kept.
+     */
+    /************************************************************************************/
+    class SOFA_API SweepDeconvolution
+    {
+    public:
+        SweepDeconvolution(const double *excitation,
+                           const std::size_t excitationLength,
+                           const double samplingRate,
+                           const std::size_t maxRecordingLength,
+                           const std::size_t numChannels,
+                           const std::size_t irLength,
+                           const double regularizationDB = -60.0);
+        
+        ~SweepDeconvolution() {};
+        
+        static void GenerateSweep(double *sweep,
+                                  const std::size_t length,
+                                  const double samplingRate,
+                                  const double startFrequency = 20.0,
+                                  const double endFrequency = 20000.0);
+        
+        //==============================================================================
+        void SetWindow(const long startOffset,
+                       const std::size_t fadeInLength,
+                       const std::size_t fadeOutLength);
+        
+        double GetSamplingRate() const;
+        std::size_t GetNumChannels() const;
+        std::size_t GetMaxRecordingLength() const;
+        std::size_t GetIRLength() const;
+        std::size_t GetFFTSize() const;
+        
+        //==============================================================================
+        void Process(double *irs,
+                     const double * const *recordings,
+                     const std::size_t recordingLength,
+                     const unsigned int numThreads = 0);
+        
+        void Process(sofa::MeasurementWriter &writer,
+                     const double * const *recordings,
+                     const std::size_t recordingLength,
+                     const double *sourcePosition,
+                     const unsigned int numThreads = 0);
+        
+        void Process(sofa::MeasurementWriter &writer,
+                     const std::string &recordingPath,
+                     const double *sourcePosition,
+                     const unsigned int numThreads = 0);
+        
+    protected:
+        //==============================================================================
+        void processChannel(double *ir,
+                            const double *recording,
+                            const std::size_t recordingLength,
+                            const std::size_t channel);
+        
+    protected:
+        const double samplingRate;
+        const std::size_t numChannels;
+        const std::size_t maxRecordingLength;
+        const std::size_t irLength;
+        const sofa::FFT fft;
+        std::vector< std::complex< double > > inverseSpectrum;     ///< regularized 1 / excitation spectrum
+        
+        long startOffset;                                           ///< first sample kept (may be negative)
+        std::vector< double > window;                               ///< irLength gains
+        
+        std::vector< std::vector< std::complex< double > > > spectra;  ///< one per channel
+        std::vector< std::vector< double > > buffers;                  ///< one per channel
+        std::vector< double > responses;                               ///< [numChannels irLength]
+        std::vector< std::vector< double > > recordingBuffers;         ///< for the WAV recordings
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SweepDeconvolution );
+    };
+    
+}
+
+#endif /* _SOFA_SWEEP_DECONVOLUTION_H__ */
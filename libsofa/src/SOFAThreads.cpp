@@ -0,0 +1,439 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAThreads.cpp
+ *   @brief      Helpers for running batch processing on several threads
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAUtils.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of threads to use
+ *  @param[in]      requestedNumThreads : 0 for the number of hardware threads
+ *
+ */
+/************************************************************************************/
+unsigned int Threads::GetNumThreads(const unsigned int requestedNumThreads)
+{
+    if( requestedNumThreads > 0 )
+    {
+        return requestedNumThreads;
+    }
+    
+    const unsigned int numHardwareThreads = std::thread::hardware_concurrency();
+    
+    return ( numHardwareThreads > 0 ) ? numHardwareThreads : 1;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Runs task( i ) for i in [0 count[, on several threads
+ *  @param[in]      count : number of items
+ *  @param[in]      task : the function to run for each item
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ *  @details        The items are handed out one at a time, so that uneven tasks keep
+ *                  all the threads busy. The calling thread takes part in the work.
+ *                  If a task throws, the remaining items are skipped and the first
+ *                  exception is rethrown in the calling thread.
+ */
+/************************************************************************************/
+void Threads::ParallelFor(const std::size_t count,
+                          const sofa::Threads::Task &task,
+                          const unsigned int numThreads)
+{
+    const unsigned int numWorkers = static_cast< unsigned int >( sofa::smin( static_cast< std::size_t >( GetNumThreads( numThreads ) ), count ) );
+    
+    if( numWorkers <= 1 )
+    {
+        for( std::size_t i = 0; i < count; i++ )
+        {
+            task( i, 0 );
+        }
+        return;
+    }
+    
+    std::atomic< std::size_t > next( 0 );
+    std::atomic< bool > failed( false );
+    std::exception_ptr exception;
+    std::mutex exceptionLock;
+    
+    auto worker = [&]( const unsigned int threadIndex )
+    {
+        try
+        {
+            for( std::size_t i = next++; i < count && failed == false; i = next++ )
+            {
+                task( i, threadIndex );
+            }
+        }
+        catch( ... )
+        {
+            std::lock_guard< std::mutex > lock( exceptionLock );
+            
+            if( failed == false )
+            {
+                exception = std::current_exception();
+                failed    = true;
+            }
+        }
+    };
+    
+    std::vector< std::thread > threads;
+    threads.reserve( numWorkers - 1 );
+    
+    try
+    {
+        for( unsigned int t = 1; t < numWorkers; t++ )
+        {
+            threads.push_back( std::thread( worker, t ) );
+        }
+    }
+    catch( ... )
+    {
+        /// a thread could not be started : stop and join the ones already running
+        failed = true;
+        
+        for( std::size_t t = 0; t < threads.size(); t++ )
+        {
+            threads[t].join();
+        }
+        throw;
+    }
+    
+    worker( 0 );
+    
+    for( std::size_t t = 0; t < threads.size(); t++ )
+    {
+        threads[t].join();
+    }
+    
+    if( exception != nullptr )
+    {
+        std::rethrow_exception( exception );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : starts numThreads - 1 worker threads
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ */
+/************************************************************************************/
+ThreadPool::ThreadPool(const unsigned int numThreads_)
+: numThreads( Threads::GetNumThreads( numThreads_ ) )
+, task( nullptr )
+, generation( 0 )
+, quit( false )
+, remaining( 0 )
+, failed( false )
+{
+    ranges.resize( numThreads );
+    for( unsigned int t = 0; t < numThreads; t++ )
+    {
+        ranges[t].reset( new Range() );
+        ranges[t]->begin    = 0;
+        ranges[t]->end      = 0;
+    }
+    
+    threads.reserve( numThreads - 1 );
+    
+    try
+    {
+        for( unsigned int t = 1; t < numThreads; t++ )
+        {
+            threads.push_back( std::thread( &ThreadPool::workerLoop, this, t ) );
+        }
+    }
+    catch( ... )
+    {
+        /// a thread could not be started : stop and join the ones already running
+        /// (the destructor is not called when the constructor throws)
+        {
+            std::lock_guard< std::mutex > guard( lock );
+            quit = true;
+        }
+        wakeUp.notify_all();
+        
+        for( std::size_t t = 0; t < threads.size(); t++ )
+        {
+            threads[t].join();
+        }
+        throw;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor : stops the worker threads
+ *
+ */
+/************************************************************************************/
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard< std::mutex > guard( lock );
+        quit = true;
+    }
+    wakeUp.notify_all();
+    
+    for( std::size_t t = 0; t < threads.size(); t++ )
+    {
+        threads[t].join();
+    }
+}
+
+unsigned int ThreadPool::GetNumThreads() const
+{
+    return numThreads;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Runs task( i ) for i in [0 count[, and waits for all the items
+ *
+ *  @details        If a task throws, the remaining items are skipped and the first
+ *                  exception is rethrown in the calling thread.
+ */
+/************************************************************************************/
+void ThreadPool::Run(const std::size_t count,
+                     const sofa::Threads::Task &task_)
+{
+    if( count == 0 )
+    {
+        return;
+    }
+    
+    if( numThreads <= 1 || count == 1 )
+    {
+        for( std::size_t i = 0; i < count; i++ )
+        {
+            task_( i, 0 );
+        }
+        return;
+    }
+    
+    {
+        std::lock_guard< std::mutex > guard( lock );
+        
+        task        = &task_;
+        exception   = nullptr;
+        failed      = false;
+        remaining   = count;
+        
+        for( unsigned int t = 0; t < numThreads; t++ )
+        {
+            std::lock_guard< std::mutex > rangeGuard( ranges[t]->lock );
+            ranges[t]->begin    = ( count * t ) / numThreads;
+            ranges[t]->end      = ( count * ( t + 1 ) ) / numThreads;
+        }
+        
+        generation++;
+    }
+    wakeUp.notify_all();
+    
+    work( 0 );
+    
+    {
+        std::unique_lock< std::mutex > guard( lock );
+        done.wait( guard, [this]{ return remaining == 0; } );
+        task = nullptr;
+    }
+    
+    if( exception != nullptr )
+    {
+        std::rethrow_exception( exception );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Main function of a worker thread
+ *
+ */
+/************************************************************************************/
+void ThreadPool::workerLoop(const unsigned int threadIndex)
+{
+    unsigned long long lastGeneration = 0;
+    
+    for( ;; )
+    {
+        {
+            std::unique_lock< std::mutex > guard( lock );
+            wakeUp.wait( guard, [&]{ return quit == true || generation != lastGeneration; } );
+            
+            if( quit == true )
+            {
+                return;
+            }
+            
+            lastGeneration = generation;
+        }
+        
+        work( threadIndex );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Processes items until there is none left to take or to steal
+ *
+ */
+/************************************************************************************/
+void ThreadPool::work(const unsigned int threadIndex)
+{
+    std::size_t index = 0;
+    
+    while( takeItem( index, threadIndex ) == true )
+    {
+        if( failed == false )
+        {
+            try
+            {
+                ( *task )( index, threadIndex );
+            }
+            catch( ... )
+            {
+                std::lock_guard< std::mutex > guard( lock );
+                
+                if( failed == false )
+                {
+                    exception   = std::current_exception();
+                    failed      = true;
+                }
+            }
+        }
+        
+        if( --remaining == 0 )
+        {
+            std::lock_guard< std::mutex > guard( lock );
+            done.notify_all();
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Takes the next item of the range of a thread, or steals the back half
+ *                  of the largest range of the other threads
+ *  @return         false if there is no item left
+ *
+ */
+/************************************************************************************/
+bool ThreadPool::takeItem(std::size_t &index,
+                          const unsigned int threadIndex)
+{
+    Range &own = *ranges[ threadIndex ];
+    
+    for( ;; )
+    {
+        {
+            std::lock_guard< std::mutex > guard( own.lock );
+            
+            if( own.begin < own.end )
+            {
+                index = own.begin++;
+                return true;
+            }
+        }
+        
+        /// the victim is the thread with the most items left (its range may shrink before the steal)
+        unsigned int victim = threadIndex;
+        std::size_t largest = 0;
+        
+        for( unsigned int t = 0; t < numThreads; t++ )
+        {
+            if( t != threadIndex )
+            {
+                std::lock_guard< std::mutex > guard( ranges[t]->lock );
+                
+                const std::size_t size = ranges[t]->end - ranges[t]->begin;
+                if( size > largest )
+                {
+                    largest = size;
+                    victim  = t;
+                }
+            }
+        }
+        
+        if( largest == 0 )
+        {
+            return false;
+        }
+        
+        std::size_t first = 0;
+        std::size_t last = 0;
+        {
+            std::lock_guard< std::mutex > guard( ranges[ victim ]->lock );
+            
+            Range &other = *ranges[ victim ];
+            const std::size_t size = other.end - other.begin;
+            
+            if( size == 0 )
+            {
+                continue;
+            }
+            
+            last        = other.end;
+            first       = other.end - ( size + 1 ) / 2;
+            other.end   = first;
+        }
+        
+        {
+            std::lock_guard< std::mutex > guard( own.lock );
+            own.begin   = first;
+            own.end     = last;
+        }
+    }
+}
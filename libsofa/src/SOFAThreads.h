@@ -0,0 +1,158 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAThreads.h
+ *   @brief      Helpers for running batch processing on several threads
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_THREADS_H__
+#define _SOFA_THREADS_H__
+
+#include "../src/SOFAPlatform.h"
+#include <functional>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Threads
+     *  @brief          Static class to distribute independent tasks over several threads
+     *
+     */
+    /************************************************************************************/
+    class SOFA_API Threads
+    {
+    public:
+        /// a task receives the index of the item to process, and the index of the
+        /// thread running it (in [0 numThreads[), e.g. to select a per-thread workspace
+        typedef std::function< void (const std::size_t index, const unsigned int threadIndex) > Task;
+        
+    public:
+        static unsigned int GetNumThreads(const unsigned int requestedNumThreads);
+        
+        static void ParallelFor(const std::size_t count,
+                                const sofa::Threads::Task &task,
+                                const unsigned int numThreads = 0);
+        
+    private:
+        Threads() SOFA_DELETED_FUNCTION;
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          ThreadPool
+     *  @brief          Persistent worker threads, for tasks which are run repeatedly
+     *                  (e.g. every audio block), with work stealing
+     *
+     *  @details        Run() splits the items into one contiguous range per thread : a thread
+     *                  takes the items of its own range from the front, and when it is empty,
+     *                  steals the back half of the largest remaining range.
+     *                  With the same count, a thread thus mostly processes the same items
+     *                  from one call to the next, while uneven tasks are still balanced.
+     *                  The calling thread takes part in the work (as thread 0).
+     *                  Run() must not be called from several threads at once.
+     */
+    /************************************************************************************/
+    class SOFA_API ThreadPool
+    {
+    public:
+        ThreadPool(const unsigned int numThreads = 0);
+        ~ThreadPool();
+        
+        unsigned int GetNumThreads() const;
+        
+        void Run(const std::size_t count,
+                 const sofa::Threads::Task &task);
+        
+    protected:
+        //==============================================================================
+        /// the range of items of a thread
+        struct Range
+        {
+            std::mutex lock;
+            std::size_t begin;
+            std::size_t end;
+        };
+        
+        void workerLoop(const unsigned int threadIndex);
+        
+        void work(const unsigned int threadIndex);
+        
+        bool takeItem(std::size_t &index,
+                      const unsigned int threadIndex);
+        
+    protected:
+        const unsigned int numThreads;
+        
+        std::vector< std::thread > threads;
+        std::vector< std::unique_ptr< Range > > ranges;
+        
+        std::mutex lock;
+        std::condition_variable wakeUp;         ///< signals a new Run() (or the destruction)
+        std::condition_variable done;           ///< signals the completion of all the items
+        
+        const sofa::Threads::Task *task;
+        unsigned long long generation;          ///< incremented by each Run()
+        bool quit;
+        
+        std::atomic< std::size_t > remaining;   ///< items not completed yet
+        std::atomic< bool > failed;
+        std::exception_ptr exception;
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( ThreadPool );
+    };
+    
+}
+
+#endif /* _SOFA_THREADS_H__ */
@@ -0,0 +1,467 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFATransferFunctions.cpp
+ *   @brief      In-memory set of transfer functions, computed from impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFATransferFunctions.h"
+#include "../src/SOFAGeneralTF.h"
+#include "../src/SOFAThreads.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// target size (in bytes) of the HDF5 chunks of Data.Real and Data.Imag
+    static const std::size_t kChunkSize = 256 * 1024;
+    
+    /// target size (in bytes) of the blocks of Data.IR processed at once by Transform()
+    static const std::size_t kBlockSize = 4 * 1024 * 1024;
+    
+    /// number of samples the responses span once shifted by their Data.Delay :
+    /// the FFT must not be shorter, otherwise the linear phase wraps the tails around
+    static std::size_t GetDelayedLength(const std::size_t numDataSamples,
+                                        const std::vector< double > &delays)
+    {
+        double maxDelay = 0.0;
+        for( std::size_t i = 0; i < delays.size(); i++ )
+        {
+            maxDelay = std::max( maxDelay, std::fabs( delays[i] ) );
+        }
+        
+        return numDataSamples + static_cast< std::size_t >( std::ceil( maxDelay ) );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : an empty set
+ *
+ */
+/************************************************************************************/
+TransferFunctions::TransferFunctions()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numEmitters( 0 )
+, fftSize( 0 )
+, samplingRate( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the default FFT size for responses of a given length :
+ *                  twice the next power of 2, so that the spectra can be used for
+ *                  linear convolution by blocks of that power of 2
+ *
+ */
+/************************************************************************************/
+std::size_t TransferFunctions::GetDefaultFFTSize(const std::size_t numDataSamples)
+{
+    return 2 * sofa::FFT::GetNextPowerOfTwo( sofa::smax( numDataSamples, (std::size_t) 1 ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the spectra of a set of responses
+ *  @param[in]      responses : the impulse responses
+ *  @param[in]      fftSize : power of 2, not smaller than the responses plus their
+ *                  largest delay (0 for GetDefaultFFTSize() of that length)
+ *  @param[in]      numThreads : number of threads (0 for the number of hardware threads)
+ *
+ */
+/************************************************************************************/
+void TransferFunctions::Compute(const sofa::ImpulseResponses &responses,
+                                const std::size_t fftSize_,
+                                const unsigned int numThreads)
+{
+    const std::size_t N = responses.GetNumDataSamples();
+    const std::size_t L = sofaLocal::GetDelayedLength( N, responses.GetDelays() );
+    const std::size_t K = ( fftSize_ == 0 ) ? GetDefaultFFTSize( L ) : fftSize_;
+    
+    if( sofa::FFT::IsPowerOfTwo( K ) == false || K < L )
+    {
+        SOFA_THROW( "the FFT size must be a power of 2, not smaller than the responses plus their Data.Delay" );
+    }
+    
+    numMeasurements = responses.GetNumMeasurements();
+    numReceivers    = responses.GetNumReceivers();
+    numEmitters     = responses.GetNumEmitters();
+    fftSize         = K;
+    samplingRate    = responses.GetSamplingRate();
+    
+    const std::size_t numBins       = GetNumBins();
+    const std::size_t numResponses  = GetNumResponses();
+    
+    values.resize( numResponses * numBins );
+    
+    if( numResponses == 0 )
+    {
+        return;
+    }
+    
+    const sofa::FFT fft( K );
+    
+    const unsigned int numWorkers = sofa::Threads::GetNumThreads( numThreads );
+    
+    /// one zero-padded input buffer per thread
+    std::vector< std::vector< double > > buffers( numWorkers, std::vector< double >( K, 0.0 ) );
+    
+    const double pi = 3.14159265358979323846;
+    
+    sofa::Threads::ParallelFor( numResponses,
+                                [&]( const std::size_t i, const unsigned int threadIndex )
+                                {
+                                    std::vector< double > &buffer = buffers[ threadIndex ];
+                                    
+                                    const double *response = responses.GetResponse( i );
+                                    std::copy( response, response + N, buffer.begin() );
+                                    std::fill( buffer.begin() + N, buffer.end(), 0.0 );
+                                    
+                                    std::complex< double > *spectrum = &values[ i * numBins ];
+                                    fft.ForwardReal( spectrum, &buffer[0] );
+                                    
+                                    /// the delay becomes a linear phase
+                                    const double delay = responses.GetDelay( i );
+                                    
+                                    if( delay != 0.0 )
+                                    {
+                                        const double omega = -2.0 * pi * delay / static_cast< double >( K );
+                                        
+                                        for( std::size_t k = 0; k < numBins; k++ )
+                                        {
+                                            spectrum[k] *= std::polar( 1.0, omega * static_cast< double >( k ) );
+                                        }
+                                    }
+                                },
+                                numWorkers );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Defines a GeneralTF file : everything is copied from the source
+ *                  FIR file, except the variables depending on N and the Data variables
+ *
+ */
+/************************************************************************************/
+void TransferFunctions::createFile(sofa::Writer &writer,
+                                   const sofa::File &source,
+                                   const std::size_t fftSize_,
+                                   const double samplingRate_)
+{
+    std::vector< std::size_t > irDims;
+    source.GetVariableDimensions( irDims, "Data.IR" );
+    
+    if( irDims.size() == 4 && irDims[2] > 1 )
+    {
+        SOFA_THROW( "GeneralTF files have no emitter dimension" );
+    }
+    
+    const std::size_t numBins = fftSize_ / 2 + 1;
+    
+    writer.CopyGlobalAttributes( source );
+    writer.PutGlobalAttribute( "SOFAConventions", "GeneralTF" );
+    writer.PutGlobalAttribute( "SOFAConventionsVersion", sofa::GeneralTF::GetConventionVersion() );
+    writer.PutGlobalAttribute( "DataType", "TF" );
+    writer.UpdateModificationAttributes();
+    
+    writer.CopyDimensions( source, std::vector< std::string >( 1, "N" ) );
+    writer.AddDimension( "N", numBins );
+    
+    //==============================================================================
+    std::vector< std::string > excluded;
+    excluded.push_back( "Data.IR" );
+    excluded.push_back( "Data.Delay" );
+    excluded.push_back( "Data.SamplingRate" );
+    excluded.push_back( sofa::Quantization::GainVariableName );
+    
+    std::vector< std::string > variableNames;
+    source.GetAllVariablesNames( variableNames );
+    
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
+    {
+        std::vector< std::string > dimNames;
+        source.GetVariableDimensionsNames( dimNames, variableNames[i] );
+        
+        if( std::find( dimNames.begin(), dimNames.end(), "N" ) != dimNames.end() )
+        {
+            excluded.push_back( variableNames[i] );
+        }
+    }
+    
+    writer.CopyVariables( source, excluded );
+    
+    //==============================================================================
+    std::vector< double > frequencies( numBins );
+    for( std::size_t k = 0; k < numBins; k++ )
+    {
+        frequencies[k] = static_cast< double >( k ) * samplingRate_ / static_cast< double >( fftSize_ );
+    }
+    
+    writer.AddVariable( "N", std::vector< std::string >( 1, "N" ) );
+    writer.PutVariableAttribute( "N", "LongName", "frequency" );
+    writer.PutVariableAttribute( "N", "Units", "hertz" );
+    writer.PutValues( "N", &frequencies[0] );
+    
+    std::vector< std::string > dataDims;
+    dataDims.push_back( "M" );
+    dataDims.push_back( "R" );
+    dataDims.push_back( "N" );
+    
+    writer.AddVariable( "Data.Real", dataDims );
+    writer.AddVariable( "Data.Imag", dataDims );
+    
+    const std::size_t M = source.GetNumMeasurements();
+    const std::size_t R = source.GetNumReceivers();
+    
+    if( M > 0 && R > 0 )
+    {
+        std::vector< std::size_t > chunkSizes;
+        chunkSizes.push_back( sofa::smin( M, sofa::smax( (std::size_t) 1, sofaLocal::kChunkSize / ( R * numBins * sizeof( double ) ) ) ) );
+        chunkSizes.push_back( R );
+        chunkSizes.push_back( numBins );
+        
+        writer.SetChunking( "Data.Real", chunkSizes );
+        writer.SetChunking( "Data.Imag", chunkSizes );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the spectra in Data.Real and Data.Imag, from a given measurement
+ *
+ */
+/************************************************************************************/
+void TransferFunctions::putValues(sofa::Writer &writer,
+                                  const std::size_t firstMeasurement) const
+{
+    if( values.empty() == true )
+    {
+        return;
+    }
+    
+    std::vector< double > real( values.size() );
+    std::vector< double > imag( values.size() );
+    
+    for( std::size_t i = 0; i < values.size(); i++ )
+    {
+        real[i] = values[i].real();
+        imag[i] = values[i].imag();
+    }
+    
+    std::vector< std::size_t > start( 3, 0 );
+    start[0] = firstMeasurement;
+    
+    std::vector< std::size_t > count( 3 );
+    count[0] = numMeasurements;
+    count[1] = numReceivers * numEmitters;
+    count[2] = GetNumBins();
+    
+    writer.PutValues( "Data.Real", &real[0], start, count );
+    writer.PutValues( "Data.Imag", &imag[0], start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the spectra as a GeneralTF file
+ *  @param[in]      source : the FIR file the responses come from
+ *  @param[in]      outputPath : path of the file to create
+ *
+ */
+/************************************************************************************/
+void TransferFunctions::Write(const sofa::File &source,
+                              const std::string &outputPath) const
+{
+    if( static_cast< std::size_t >( source.GetNumMeasurements() ) != numMeasurements
+       || static_cast< std::size_t >( source.GetNumReceivers() ) != numReceivers )
+    {
+        SOFA_THROW( "the transfer functions do not match the dimensions of the source file" );
+    }
+    
+    sofa::Writer writer( outputPath );
+    
+    createFile( writer, source, fftSize, samplingRate );
+    
+    putValues( writer, 0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Converts a FIR file to a GeneralTF file, a block of measurements at a time
+ *  @param[in]      source : a FIR (or FIRE with one emitter) file
+ *  @param[in]      outputPath : path of the file to create
+ *  @param[in]      fftSize : power of 2, not smaller than N plus the largest Data.Delay
+ *                  (0 for GetDefaultFFTSize() of that length)
+ *  @param[in]      numThreads : number of threads used for each block
+ *
+ */
+/************************************************************************************/
+void TransferFunctions::Transform(const sofa::File &source,
+                                  const std::string &outputPath,
+                                  const std::size_t fftSize,
+                                  const unsigned int numThreads)
+{
+    if( source.IsFIRDataType() == false && source.IsFIREDataType() == false )
+    {
+        SOFA_THROW( "'DataType' shall be FIR or FIRE" );
+    }
+    
+    const std::size_t M = source.GetNumMeasurements();
+    const std::size_t N = source.GetNumDataSamples();
+    
+    /// all the blocks share the FFT size, which depends on the delays of the whole file
+    std::vector< double > delays;
+    if( source.HasVariable( "Data.Delay" ) == true && source.GetValues( delays, "Data.Delay" ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' variable" );
+    }
+    
+    const std::size_t L = sofaLocal::GetDelayedLength( N, delays );
+    const std::size_t K = ( fftSize == 0 ) ? GetDefaultFFTSize( L ) : fftSize;
+    
+    const std::size_t measurementSize   = sofa::smax( (std::size_t) 1, source.GetNumReceivers() * source.GetNumEmitters() * sofa::smax( N, K ) );
+    const std::size_t blockSize         = sofa::smax( (std::size_t) 1, sofaLocal::kBlockSize / ( measurementSize * sizeof( double ) ) );
+    
+    sofa::ImpulseResponses responses;
+    sofa::TransferFunctions spectra;
+    
+    responses.Load( source, 0, sofa::smin( blockSize, M ) );
+    spectra.Compute( responses, K, numThreads );
+    
+    sofa::Writer writer( outputPath );
+    
+    createFile( writer, source, K, responses.GetSamplingRate() );
+    
+    for( std::size_t first = 0; first < M; first += blockSize )
+    {
+        if( first > 0 )
+        {
+            responses.Load( source, first, sofa::smin( blockSize, M - first ) );
+            spectra.Compute( responses, K, numThreads );
+        }
+        
+        spectra.putValues( writer, first );
+    }
+}
+
+std::size_t TransferFunctions::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+std::size_t TransferFunctions::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t TransferFunctions::GetNumEmitters() const
+{
+    return numEmitters;
+}
+
+std::size_t TransferFunctions::GetNumBins() const
+{
+    return ( fftSize > 0 ) ? fftSize / 2 + 1 : 0;
+}
+
+std::size_t TransferFunctions::GetNumResponses() const
+{
+    return numMeasurements * numReceivers * numEmitters;
+}
+
+std::size_t TransferFunctions::GetFFTSize() const
+{
+    return fftSize;
+}
+
+double TransferFunctions::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the frequency of a bin, in hertz
+ *
+ */
+/************************************************************************************/
+double TransferFunctions::GetFrequency(const std::size_t bin) const
+{
+    return ( fftSize > 0 ) ? static_cast< double >( bin ) * samplingRate / static_cast< double >( fftSize ) : 0.0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Index of the spectrum of a given measurement, receiver and emitter
+ *
+ */
+/************************************************************************************/
+std::size_t TransferFunctions::GetResponseIndex(const std::size_t measurement,
+                                                const std::size_t receiver,
+                                                const std::size_t emitter) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers && emitter < numEmitters );
+    
+    return ( measurement * numReceivers + receiver ) * numEmitters + emitter;
+}
+
+std::complex< double > * TransferFunctions::GetSpectrum(const std::size_t responseIndex)
+{
+    return &values[ responseIndex * GetNumBins() ];
+}
+
+const std::complex< double > * TransferFunctions::GetSpectrum(const std::size_t responseIndex) const
+{
+    return &values[ responseIndex * GetNumBins() ];
+}
+
+const std::vector< std::complex< double > > & TransferFunctions::GetValues() const
+{
+    return values;
+}
@@ -0,0 +1,140 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFATransferFunctions.h
+ *   @brief      In-memory set of transfer functions, computed from impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_TRANSFER_FUNCTIONS_H__
+#define _SOFA_TRANSFER_FUNCTIONS_H__
+
+#include "../src/SOFAImpulseResponses.h"
+#include "../src/SOFAWriter.h"
+#include "../src/SOFAFFT.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          TransferFunctions
+     *  @brief          The spectra (real FFT) of a set of impulse responses
+     *
+     *  @details        The spectra are stored as [M R E numBins] complex values,
+     *                  numBins = fftSize / 2 + 1, for the frequencies k * samplingRate / fftSize.
+     *                  The Data.Delay of the responses is included in the phase of the spectra,
+     *                  since GeneralTF has no delay variable : the FFT size is at least the
+     *                  length of the responses plus their largest delay, so that the
+     *                  delayed responses do not wrap around.
+     *                  A set can be written as a GeneralTF file ([M R N] : the responses
+     *                  must not have more than one emitter), whose N axis is then
+     *                  a FFT grid usable by sofa::Convolver.
+     *                  Transform() converts a FIR file to a GeneralTF file block by block,
+     *                  so that the whole set is never held in memory.
+     */
+    /************************************************************************************/
+    class SOFA_API TransferFunctions
+    {
+    public:
+        TransferFunctions();
+        ~TransferFunctions() {};
+        
+        //==============================================================================
+        void Compute(const sofa::ImpulseResponses &responses,
+                     const std::size_t fftSize = 0,
+                     const unsigned int numThreads = 0);
+        
+        void Write(const sofa::File &source,
+                   const std::string &outputPath) const;
+        
+        static void Transform(const sofa::File &source,
+                              const std::string &outputPath,
+                              const std::size_t fftSize = 0,
+                              const unsigned int numThreads = 0);
+        
+        static std::size_t GetDefaultFFTSize(const std::size_t numDataSamples);
+        
+        //==============================================================================
+        std::size_t GetNumMeasurements() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetNumEmitters() const;
+        std::size_t GetNumBins() const;
+        std::size_t GetNumResponses() const;
+        std::size_t GetFFTSize() const;
+        
+        double GetSamplingRate() const;
+        double GetFrequency(const std::size_t bin) const;
+        
+        std::size_t GetResponseIndex(const std::size_t measurement,
+                                     const std::size_t receiver,
+                                     const std::size_t emitter = 0) const;
+        
+        std::complex< double > * GetSpectrum(const std::size_t responseIndex);
+        const std::complex< double > * GetSpectrum(const std::size_t responseIndex) const;
+        
+        const std::vector< std::complex< double > > & GetValues() const;
+        
+    protected:
+        //==============================================================================
+        static void createFile(sofa::Writer &writer,
+                               const sofa::File &source,
+                               const std::size_t fftSize,
+                               const double samplingRate);
+        
+        void putValues(sofa::Writer &writer,
+                       const std::size_t firstMeasurement) const;
+        
+    protected:
+        std::size_t numMeasurements;
+        std::size_t numReceivers;
+        std::size_t numEmitters;
+        std::size_t fftSize;
+        double samplingRate;
+        
+        std::vector< std::complex< double > > values;   ///< [M R E numBins]
+    };
+    
+}
+
+#endif /* _SOFA_TRANSFER_FUNCTIONS_H__ */
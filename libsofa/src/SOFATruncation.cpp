@@ -0,0 +1,234 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFATruncation.cpp
+ *   @brief      Energy-based truncation of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFATruncation.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the truncation point of a response
+ *  @param[in]      input : the response
+ *  @param[in]      length : number of samples
+ *  @param[in]      residualDB : maximum energy of the discarded tail, in dB relative
+ *                  to the total energy of the response
+ *  @return         the number of samples to keep (0 for a null response)
+ *
+ */
+/************************************************************************************/
+std::size_t Truncation::GetTruncationPoint(const double *input,
+                                           const std::size_t length,
+                                           const double residualDB)
+{
+    double total = 0.0;
+    for( std::size_t i = 0; i < length; i++ )
+    {
+        total += input[i] * input[i];
+    }
+    
+    if( total == 0.0 )
+    {
+        return 0;
+    }
+    
+    const double maxResidual = total * std::pow( 10.0, -sofa::FAbs( residualDB ) / 10.0 );
+    
+    /// walk back from the end, until the tail holds too much energy
+    double tail = 0.0;
+    std::size_t point = length;
+    
+    while( point > 0 )
+    {
+        const double sample = input[ point - 1 ];
+        
+        if( tail + sample * sample > maxResidual )
+        {
+            break;
+        }
+        
+        tail += sample * sample;
+        point--;
+    }
+    
+    return point;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the truncation point of every response of a set
+ *  @param[out]     truncationPoints : [M R E] number of samples to keep
+ *  @return         the longest truncation point
+ *
+ */
+/************************************************************************************/
+std::size_t Truncation::Analyze(std::vector< std::size_t > &truncationPoints,
+                                const sofa::ImpulseResponses &responses,
+                                const double residualDB)
+{
+    const std::size_t N             = responses.GetNumDataSamples();
+    const std::size_t numResponses  = responses.GetNumResponses();
+    
+    truncationPoints.resize( numResponses );
+    
+    std::size_t longest = 0;
+    
+    for( std::size_t i = 0; i < numResponses; i++ )
+    {
+        truncationPoints[i] = GetTruncationPoint( responses.GetResponse( i ), N, residualDB );
+        longest = sofa::smax( longest, truncationPoints[i] );
+    }
+    
+    return longest;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Fades out a response, and sets it to zero after the fade
+ *  @param[in]      fadeStart : first sample of the fade
+ *  @param[in]      fadeLength : length of the fade, in samples
+ *
+ */
+/************************************************************************************/
+void Truncation::ApplyFadeOut(double *response,
+                              const std::size_t length,
+                              const std::size_t fadeStart,
+                              const std::size_t fadeLength,
+                              const sofa::Truncation::Window &window)
+{
+    const double pi = 3.14159265358979323846;
+    
+    const std::size_t start = sofa::smin( fadeStart, length );
+    const std::size_t end   = ( window == kRectangular ) ? start : sofa::smin( start + fadeLength, length );
+    
+    for( std::size_t i = start; i < end; i++ )
+    {
+        /// 1 at the start of the fade, reaching 0 one sample after its end
+        const double x = static_cast< double >( i - start + 1 ) / static_cast< double >( fadeLength + 1 );
+        
+        const double gain = ( window == kLinear ) ? 1.0 - x : 0.5 * ( 1.0 + std::cos( pi * x ) );
+        
+        response[i] *= gain;
+    }
+    
+    std::fill( response + end, response + length, 0.0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Truncates a set of responses
+ *  @param[in]      responses : the set to process
+ *  @param[in]      residualDB : maximum energy of the discarded tails, in dB
+ *  @param[in]      fadeLength : the fade starts at the truncation point
+ *  @param[in]      window : shape of the fade
+ *  @param[in]      mode : one truncation point for the set, or per response
+ *  @param[in]      alignment : the new length is rounded up to a multiple of alignment
+ *                  (e.g. the block size of a partitioned convolution)
+ *  @return         the new number of samples N
+ *
+ *  @details        The responses are never made longer than they are
+ */
+/************************************************************************************/
+std::size_t Truncation::Process(sofa::ImpulseResponses &responses,
+                                const double residualDB,
+                                const std::size_t fadeLength,
+                                const sofa::Truncation::Window &window,
+                                const sofa::Truncation::Mode &mode,
+                                const std::size_t alignment)
+{
+    const std::size_t N             = responses.GetNumDataSamples();
+    const std::size_t numResponses  = responses.GetNumResponses();
+    const std::size_t fade          = ( window == kRectangular ) ? 0 : fadeLength;
+    
+    std::vector< std::size_t > truncationPoints;
+    const std::size_t longest = Analyze( truncationPoints, responses, residualDB );
+    
+    std::size_t newLength = sofa::smin( N, longest + fade );
+    
+    const std::size_t step = sofa::smax( (std::size_t) 1, alignment );
+    newLength = sofa::smin( N, ( ( newLength + step - 1 ) / step ) * step );
+    
+    for( std::size_t i = 0; i < numResponses; i++ )
+    {
+        const std::size_t fadeStart = ( mode == kPerResponse ) ? truncationPoints[i] : longest;
+        
+        ApplyFadeOut( responses.GetResponse( i ), N, fadeStart, fade, window );
+    }
+    
+    responses.SetNumDataSamples( sofa::smax( (std::size_t) 1, newLength ) );
+    
+    return responses.GetNumDataSamples();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a truncated copy of a FIR or FIRE file
+ *  @return         the new number of samples N
+ *
+ */
+/************************************************************************************/
+std::size_t Truncation::Process(const sofa::File &source,
+                                const std::string &outputPath,
+                                const double residualDB,
+                                const std::size_t fadeLength,
+                                const sofa::Truncation::Window &window,
+                                const sofa::Truncation::Mode &mode,
+                                const std::size_t alignment)
+{
+    sofa::ImpulseResponses responses;
+    responses.Load( source );
+    
+    const std::size_t newLength = Process( responses, residualDB, fadeLength, window, mode, alignment );
+    
+    responses.Write( source, outputPath );
+    
+    return newLength;
+}
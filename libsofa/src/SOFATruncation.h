@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFATruncation.h
+ *   @brief      Energy-based truncation of impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_TRUNCATION_H__
+#define _SOFA_TRUNCATION_H__
+
+#include "../src/SOFAImpulseResponses.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Truncation
+     *  @brief          Static class to shorten impulse responses to their meaningful part
+     *
+     *  @details        The truncation point of a response is the first sample after which
+     *                  the remaining energy is below a given level relative to the
+     *                  total energy of the response. The responses are then faded out
+     *                  over 'fadeLength' samples after that point, and cut.
+     *                  In kPerSet mode all the responses share the longest truncation point;
+     *                  in kPerResponse mode each response is faded out at its own point
+     *                  (the set is still cut to the longest one, since N is common to all).
+     */
+    /************************************************************************************/
+    class SOFA_API Truncation
+    {
+    public:
+        
+        enum Window
+        {
+            kRectangular        = 0,    ///< no fade
+            kLinear             = 1,    ///< linear ramp
+            kRaisedCosine       = 2,    ///< half Hann window
+            kNumWindows         = 3
+        };
+        
+        enum Mode
+        {
+            kPerSet             = 0,    ///< one truncation point for all the responses
+            kPerResponse        = 1,    ///< one truncation point per response
+            kNumModes           = 2
+        };
+        
+    public:
+        static std::size_t GetTruncationPoint(const double *input,
+                                              const std::size_t length,
+                                              const double residualDB = -60.0);
+        
+        static std::size_t Analyze(std::vector< std::size_t > &truncationPoints,
+                                   const sofa::ImpulseResponses &responses,
+                                   const double residualDB = -60.0);
+        
+        static void ApplyFadeOut(double *response,
+                                 const std::size_t length,
+                                 const std::size_t fadeStart,
+                                 const std::size_t fadeLength,
+                                 const sofa::Truncation::Window &window);
+        
+        //==============================================================================
+        static std::size_t Process(sofa::ImpulseResponses &responses,
+                                   const double residualDB = -60.0,
+                                   const std::size_t fadeLength = 32,
+                                   const sofa::Truncation::Window &window = kRaisedCosine,
+                                   const sofa::Truncation::Mode &mode = kPerSet,
+                                   const std::size_t alignment = 1);
+        
+        static std::size_t Process(const sofa::File &source,
+                                   const std::string &outputPath,
+                                   const double residualDB = -60.0,
+                                   const std::size_t fadeLength = 32,
+                                   const sofa::Truncation::Window &window = kRaisedCosine,
+                                   const sofa::Truncation::Mode &mode = kPerSet,
+                                   const std::size_t alignment = 1);
+        
+    private:
+        Truncation() SOFA_DELETED_FUNCTION;
+    };
+    
+}
+
+#endif /* _SOFA_TRUNCATION_H__ */
@@ -110,6 +110,74 @@ namespace sofa
         return ( a > b ) ? a : b;
     }
     
+    /************************************************************************************/
+    /*!
+     *  @brief          Conversion from degrees to radians
+     *
+     */
+    /************************************************************************************/
+    inline double DegreesToRadians(const double x) SOFA_NOEXCEPT
+    {
+        return x * ( 3.14159265358979323846 / 180.0 );
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Conversion from radians to degrees
+     *
+     */
+    /************************************************************************************/
+    inline double RadiansToDegrees(const double x) SOFA_NOEXCEPT
+    {
+        return x * ( 180.0 / 3.14159265358979323846 );
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Converts SOFA spherical coordinates to cartesian coordinates
+     *  @param[out]     xyz : cartesian coordinates
+     *  @param[in]      aed : azimuth (degree), elevation (degree), distance
+     *
+     *  @details        The azimuth is counterclockwise from the x axis (front),
+     *                  the elevation is positive upwards
+     */
+    /************************************************************************************/
+    inline void SphericalToCartesian(double xyz[3], const double aed[3]) SOFA_NOEXCEPT
+    {
+        const double azimuth    = DegreesToRadians( aed[0] );
+        const double elevation  = DegreesToRadians( aed[1] );
+        const double distance   = aed[2];
+        
+        xyz[0] = distance * cos( elevation ) * cos( azimuth );
+        xyz[1] = distance * cos( elevation ) * sin( azimuth );
+        xyz[2] = distance * sin( elevation );
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Converts cartesian coordinates to SOFA spherical coordinates
+     *  @param[out]     aed : azimuth (degree, in [0 360[), elevation (degree), distance
+     *  @param[in]      xyz : cartesian coordinates
+     *
+     */
+    /************************************************************************************/
+    inline void CartesianToSpherical(double aed[3], const double xyz[3]) SOFA_NOEXCEPT
+    {
+        const double distance = sqrt( xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2] );
+        
+        double azimuth = RadiansToDegrees( atan2( xyz[1], xyz[0] ) );
+        if( azimuth < 0.0 )
+        {
+            azimuth += 360.0;
+        }
+        
+        const double elevation = ( distance > 0.0 ) ? RadiansToDegrees( asin( smax( -1.0, smin( 1.0, xyz[2] / distance ) ) ) ) : 0.0;
+        
+        aed[0] = azimuth;
+        aed[1] = elevation;
+        aed[2] = distance;
+    }
+    
 }
 
 #endif /* _SOFA_UTILS_H__ */ 
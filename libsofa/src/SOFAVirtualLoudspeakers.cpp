@@ -0,0 +1,316 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAVirtualLoudspeakers.cpp
+ *   @brief      Binaural downmix of multichannel signals through per-emitter impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAVirtualLoudspeakers.h"
+#include "../src/SOFAConvolver.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// Data.Delay rounded to the sample
+    static std::size_t GetIntegerDelay(const double delay)
+    {
+        return ( delay > 0.0 ) ? static_cast< std::size_t >( delay + 0.5 ) : 0;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Constructor
+ *  @param[in]      numEmitters : number of input channels
+ *  @param[in]      numReceivers : number of outputs
+ *  @param[in]      blockSize : number of samples processed at once (power of 2)
+ *  @param[in]      maxFilterLength : maximum length of the filters, in samples
+ *
+ *  @details        All the filters are initially zero
+ */
+/************************************************************************************/
+VirtualLoudspeakers::VirtualLoudspeakers(const std::size_t numEmitters_,
+                                         const std::size_t numReceivers_,
+                                         const std::size_t blockSize_,
+                                         const std::size_t maxFilterLength)
+: numEmitters( numEmitters_ )
+, numReceivers( numReceivers_ )
+, blockSize( blockSize_ )
+, numPartitions( ( sofa::FFT::IsPowerOfTwo( blockSize_ ) == true ) ? ( std::max( maxFilterLength, (std::size_t) 1 ) + blockSize_ - 1 ) / blockSize_ : 1 )
+, fft( 2 * blockSize_ )
+, currentPartition( 0 )
+{
+    if( numEmitters == 0 || numReceivers == 0 )
+    {
+        SOFA_THROW( "invalid number of emitters or receivers" );
+    }
+    
+    const std::size_t numBins = fft.GetNumBins();
+    
+    filterSpectra.assign( numReceivers * numEmitters * numPartitions * numBins, std::complex< double >( 0.0, 0.0 ) );
+    delayLines.assign( numEmitters * numPartitions * numBins, std::complex< double >( 0.0, 0.0 ) );
+    accumulator.assign( numBins, std::complex< double >( 0.0, 0.0 ) );
+    inputBuffers.assign( numEmitters * 2 * blockSize, 0.0 );
+    outputBuffer.assign( 2 * blockSize, 0.0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Constructor, with the filters of one measurement
+ *  @param[in]      responses : FIR or FIRE responses
+ *  @param[in]      measurement : index of the measurement in responses
+ *  @param[in]      blockSize : number of samples processed at once (power of 2)
+ *
+ */
+/************************************************************************************/
+VirtualLoudspeakers::VirtualLoudspeakers(const sofa::ImpulseResponses &responses,
+                                         const std::size_t measurement,
+                                         const std::size_t blockSize_)
+: VirtualLoudspeakers( responses.GetNumEmitters(),
+                       responses.GetNumReceivers(),
+                       blockSize_,
+                       GetFilterLength( responses, measurement ) )
+{
+    SetFilters( responses, measurement );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the length of the longest response of a measurement,
+ *                  Data.Delay included
+ *
+ */
+/************************************************************************************/
+std::size_t VirtualLoudspeakers::GetFilterLength(const sofa::ImpulseResponses &responses,
+                                                 const std::size_t measurement)
+{
+    if( measurement >= responses.GetNumMeasurements() )
+    {
+        SOFA_THROW( "invalid measurement" );
+    }
+    
+    std::size_t maxDelay = 0;
+    
+    for( std::size_t r = 0; r < responses.GetNumReceivers(); r++ )
+    {
+        for( std::size_t e = 0; e < responses.GetNumEmitters(); e++ )
+        {
+            const double delay = responses.GetDelay( responses.GetResponseIndex( measurement, r, e ) );
+            maxDelay = std::max( maxDelay, sofaLocal::GetIntegerDelay( delay ) );
+        }
+    }
+    
+    return responses.GetNumDataSamples() + maxDelay;
+}
+
+std::size_t VirtualLoudspeakers::GetNumEmitters() const
+{
+    return numEmitters;
+}
+
+std::size_t VirtualLoudspeakers::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+std::size_t VirtualLoudspeakers::GetBlockSize() const
+{
+    return blockSize;
+}
+
+std::size_t VirtualLoudspeakers::GetNumPartitions() const
+{
+    return numPartitions;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the filter from one input channel to one output
+ *  @param[in]      filter : the impulse response
+ *  @param[in]      length : at most GetNumPartitions() * GetBlockSize() samples
+ *
+ */
+/************************************************************************************/
+void VirtualLoudspeakers::SetFilter(const std::size_t receiver,
+                                    const std::size_t emitter,
+                                    const double *filter,
+                                    const std::size_t length)
+{
+    if( receiver >= numReceivers || emitter >= numEmitters )
+    {
+        SOFA_THROW( "invalid receiver or emitter" );
+    }
+    
+    if( length > numPartitions * blockSize )
+    {
+        SOFA_THROW( "filter too long" );
+    }
+    
+    std::vector< std::complex< double > > spectrum;
+    sofa::Convolver::ComputeFilterSpectrum( spectrum, fft, filter, length );
+    
+    const std::size_t spectrumSize = numPartitions * fft.GetNumBins();
+    
+    std::complex< double > *destination = &filterSpectra[ ( receiver * numEmitters + emitter ) * spectrumSize ];
+    
+    std::copy( spectrum.begin(), spectrum.end(), destination );
+    std::fill( destination + spectrum.size(), destination + spectrumSize, std::complex< double >( 0.0, 0.0 ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets all the filters from one measurement, Data.Delay included
+ *  @param[in]      responses : [M GetNumReceivers() GetNumEmitters() N] responses
+ *  @param[in]      measurement : index of the measurement in responses
+ *
+ *  @details        Changing the filters while processing is not crossfaded
+ */
+/************************************************************************************/
+void VirtualLoudspeakers::SetFilters(const sofa::ImpulseResponses &responses,
+                                     const std::size_t measurement)
+{
+    if( responses.GetNumReceivers() != numReceivers || responses.GetNumEmitters() != numEmitters )
+    {
+        SOFA_THROW( "the responses do not match the number of emitters or receivers" );
+    }
+    
+    const std::size_t length = GetFilterLength( responses, measurement );
+    const std::size_t N      = responses.GetNumDataSamples();
+    
+    if( length > numPartitions * blockSize )
+    {
+        SOFA_THROW( "filter too long" );
+    }
+    
+    filterBuffer.resize( length );
+    
+    for( std::size_t r = 0; r < numReceivers; r++ )
+    {
+        for( std::size_t e = 0; e < numEmitters; e++ )
+        {
+            const std::size_t index = responses.GetResponseIndex( measurement, r, e );
+            const std::size_t delay = sofaLocal::GetIntegerDelay( responses.GetDelay( index ) );
+            const double *response  = responses.GetResponse( index );
+            
+            std::fill( filterBuffer.begin(), filterBuffer.end(), 0.0 );
+            std::copy( response, response + N, filterBuffer.begin() + delay );
+            
+            SetFilter( r, e, &filterBuffer[0], delay + N );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Processes one block
+ *  @param[out]     outputs : GetNumReceivers() buffers of GetBlockSize() samples
+ *  @param[in]      inputs : GetNumEmitters() buffers of GetBlockSize() samples
+ *
+ *  @details        Each input is transformed once; the inverse FFTs are computed
+ *                  once per output, whatever the number of inputs
+ */
+/************************************************************************************/
+void VirtualLoudspeakers::Process(double * const *outputs,
+                                  const double * const *inputs)
+{
+    const std::size_t numBins       = fft.GetNumBins();
+    const std::size_t spectrumSize  = numPartitions * numBins;
+    
+    currentPartition = ( currentPartition + numPartitions - 1 ) % numPartitions;
+    
+    /// the FFT frame of each input holds the previous block and the current one
+    for( std::size_t e = 0; e < numEmitters; e++ )
+    {
+        double *buffer = &inputBuffers[ e * 2 * blockSize ];
+        
+        std::copy( buffer + blockSize, buffer + 2 * blockSize, buffer );
+        std::copy( inputs[e], inputs[e] + blockSize, buffer + blockSize );
+        
+        fft.ForwardReal( &delayLines[ e * spectrumSize + currentPartition * numBins ], buffer );
+    }
+    
+    for( std::size_t r = 0; r < numReceivers; r++ )
+    {
+        std::fill( accumulator.begin(), accumulator.end(), std::complex< double >( 0.0, 0.0 ) );
+        
+        for( std::size_t e = 0; e < numEmitters; e++ )
+        {
+            const std::complex< double > *delayLine = &delayLines[ e * spectrumSize ];
+            const std::complex< double > *filter    = &filterSpectra[ ( r * numEmitters + e ) * spectrumSize ];
+            
+            /// partition p of the filter applies to the block received p blocks ago
+            for( std::size_t p = 0; p < numPartitions; p++ )
+            {
+                const std::size_t slot = ( currentPartition + p ) % numPartitions;
+                
+                sofa::Convolver::MultiplyAccumulate( &accumulator[0],
+                                                     &delayLine[ slot * numBins ],
+                                                     &filter[ p * numBins ],
+                                                     numBins );
+            }
+        }
+        
+        fft.InverseReal( &outputBuffer[0], &accumulator[0] );
+        
+        /// the first half is circularly aliased
+        std::copy( outputBuffer.begin() + blockSize, outputBuffer.end(), outputs[r] );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the past input (the filters are kept)
+ *
+ */
+/************************************************************************************/
+void VirtualLoudspeakers::Reset()
+{
+    std::fill( delayLines.begin(), delayLines.end(), std::complex< double >( 0.0, 0.0 ) );
+    std::fill( inputBuffers.begin(), inputBuffers.end(), 0.0 );
+    currentPartition = 0;
+}
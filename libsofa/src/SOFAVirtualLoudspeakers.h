@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAVirtualLoudspeakers.h
+ *   @brief      Binaural downmix of multichannel signals through per-emitter impulse responses
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_VIRTUAL_LOUDSPEAKERS_H__
+#define _SOFA_VIRTUAL_LOUDSPEAKERS_H__
+
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAFile.h"
+#include "../src/SOFAImpulseResponses.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          VirtualLoudspeakers
+     *  @brief          Maps E input channels to R outputs through the impulse responses
+     *                  of one measurement of a FIRE file (e.g. GeneralFIRE or MultiSpeakerBRIR,
+     *                  one emitter per loudspeaker of a 7.1.4 or 22.2 layout)
+     *
+     *  @details        Uniformly partitioned overlap-save convolution : each input block
+     *                  is transformed once, and the products of all the emitters and
+     *                  partitions are summed per output in the frequency domain, so that
+     *                  there is only one inverse FFT per output.
+     *                  Data.Delay is applied by shifting the responses (rounded to the sample).
+     *                  Only the measurement used needs to be loaded, with
+     *                  ImpulseResponses::Load( file, measurement, 1 ).
+     *                  An object processes one set of signals, and must not be shared
+     *                  between threads.
+     */
+    /************************************************************************************/
+    class SOFA_API VirtualLoudspeakers
+    {
+    public:
+        VirtualLoudspeakers(const std::size_t numEmitters,
+                            const std::size_t numReceivers,
+                            const std::size_t blockSize,
+                            const std::size_t maxFilterLength);
+        
+        VirtualLoudspeakers(const sofa::ImpulseResponses &responses,
+                            const std::size_t measurement = 0,
+                            const std::size_t blockSize = 256);
+        
+        ~VirtualLoudspeakers() {};
+        
+        static std::size_t GetFilterLength(const sofa::ImpulseResponses &responses,
+                                           const std::size_t measurement = 0);
+        
+        std::size_t GetNumEmitters() const;
+        std::size_t GetNumReceivers() const;
+        std::size_t GetBlockSize() const;
+        std::size_t GetNumPartitions() const;
+        
+        //==============================================================================
+        void SetFilter(const std::size_t receiver,
+                       const std::size_t emitter,
+                       const double *filter,
+                       const std::size_t length);
+        
+        void SetFilters(const sofa::ImpulseResponses &responses,
+                        const std::size_t measurement = 0);
+        
+        //==============================================================================
+        void Process(double * const *outputs,
+                     const double * const *inputs);
+        
+        void Reset();
+        
+    protected:
+        const std::size_t numEmitters;
+        const std::size_t numReceivers;
+        const std::size_t blockSize;
+        const std::size_t numPartitions;
+        const sofa::FFT fft;
+        
+        std::vector< std::complex< double > > filterSpectra;    ///< [R E numPartitions numBins]
+        std::vector< std::complex< double > > delayLines;       ///< [E numPartitions numBins] spectra of the past input blocks
+        std::vector< std::complex< double > > accumulator;      ///< numBins
+        std::vector< double > inputBuffers;                     ///< [E 2*blockSize] the last input samples
+        std::vector< double > outputBuffer;                     ///< 2 * blockSize
+        std::vector< double > filterBuffer;                     ///< workspace of SetFilters()
+        std::size_t currentPartition;                           ///< slot of the most recent block in the delay lines
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( VirtualLoudspeakers );
+    };
+    
+}
+
+#endif /* _SOFA_VIRTUAL_LOUDSPEAKERS_H__ */
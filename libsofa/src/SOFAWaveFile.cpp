@@ -0,0 +1,543 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAWaveFile.cpp
+ *   @brief      Streamed reading and writing of WAV audio files
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAWaveFile.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// the WAV format codes
+    static const unsigned int kFormatPCM            = 0x0001;
+    static const unsigned int kFormatFloat          = 0x0003;
+    static const unsigned int kFormatExtensible     = 0xFFFE;
+    
+    /// number of frames converted at once
+    static const std::size_t kFramesPerChunk = 4096;
+    
+    /// little-endian decoding / encoding (independent of the host)
+    static unsigned int readUInt16(const unsigned char *bytes)
+    {
+        return (unsigned int) bytes[0] | ( (unsigned int) bytes[1] << 8 );
+    }
+    
+    static unsigned long readUInt32(const unsigned char *bytes)
+    {
+        return (unsigned long) bytes[0] | ( (unsigned long) bytes[1] << 8 ) | ( (unsigned long) bytes[2] << 16 ) | ( (unsigned long) bytes[3] << 24 );
+    }
+    
+    static void writeUInt16(unsigned char *bytes, const unsigned int value)
+    {
+        bytes[0] = (unsigned char) ( value & 0xFF );
+        bytes[1] = (unsigned char) ( ( value >> 8 ) & 0xFF );
+    }
+    
+    static void writeUInt32(unsigned char *bytes, const unsigned long value)
+    {
+        bytes[0] = (unsigned char) ( value & 0xFF );
+        bytes[1] = (unsigned char) ( ( value >> 8 ) & 0xFF );
+        bytes[2] = (unsigned char) ( ( value >> 16 ) & 0xFF );
+        bytes[3] = (unsigned char) ( ( value >> 24 ) & 0xFF );
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Decodes one sample to [-1 1]
+     *
+     */
+    /************************************************************************************/
+    static double decodeSample(const unsigned char *bytes,
+                               const unsigned int bitsPerSample,
+                               const bool floatingPoint)
+    {
+        if( floatingPoint == true )
+        {
+            if( bitsPerSample == 32 )
+            {
+                const unsigned long bits = readUInt32( bytes );
+                const uint32_t value = static_cast< uint32_t >( bits );
+                float f;
+                std::memcpy( &f, &value, sizeof( float ) );
+                return static_cast< double >( f );
+            }
+            else
+            {
+                const uint64_t value = static_cast< uint64_t >( readUInt32( bytes ) ) | ( static_cast< uint64_t >( readUInt32( bytes + 4 ) ) << 32 );
+                double d;
+                std::memcpy( &d, &value, sizeof( double ) );
+                return d;
+            }
+        }
+        
+        switch( bitsPerSample )
+        {
+            case 8 :
+                /// 8-bit samples are unsigned
+                return ( static_cast< double >( bytes[0] ) - 128.0 ) / 128.0;
+                
+            case 16 :
+                return static_cast< double >( static_cast< int16_t >( readUInt16( bytes ) ) ) / 32768.0;
+                
+            case 24 :
+            {
+                int32_t value = static_cast< int32_t >( bytes[0] | ( bytes[1] << 8 ) | ( bytes[2] << 16 ) );
+                if( value & 0x800000 )
+                {
+                    value -= 0x1000000;
+                }
+                return static_cast< double >( value ) / 8388608.0;
+            }
+                
+            case 32 :
+            default :
+                return static_cast< double >( static_cast< int32_t >( readUInt32( bytes ) ) ) / 2147483648.0;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Opens a WAV file and parses its header
+ *
+ */
+/************************************************************************************/
+WaveReader::WaveReader(const std::string &path)
+: numChannels( 0 )
+, bitsPerSample( 0 )
+, floatingPoint( false )
+, samplingRate( 0.0 )
+, numFrames( 0 )
+, position( 0 )
+{
+    stream.open( path.c_str(), std::ios::in | std::ios::binary );
+    
+    if( stream.is_open() == false )
+    {
+        SOFA_THROW( "cannot open " + path );
+    }
+    
+    unsigned char header[12];
+    if( ! stream.read( reinterpret_cast< char * >( header ), 12 )
+       || std::memcmp( header, "RIFF", 4 ) != 0
+       || std::memcmp( header + 8, "WAVE", 4 ) != 0 )
+    {
+        SOFA_THROW( path + " is not a WAV file" );
+    }
+    
+    bool hasFormat = false;
+    
+    /// walks through the chunks until the data chunk
+    for( ;; )
+    {
+        unsigned char chunk[8];
+        if( ! stream.read( reinterpret_cast< char * >( chunk ), 8 ) )
+        {
+            SOFA_THROW( path + " has no data chunk" );
+        }
+        
+        const unsigned long chunkSize = sofaLocal::readUInt32( chunk + 4 );
+        
+        if( std::memcmp( chunk, "fmt ", 4 ) == 0 )
+        {
+            std::vector< unsigned char > format( sofa::smax( chunkSize, (unsigned long) 16 ), 0 );
+            stream.read( reinterpret_cast< char * >( &format[0] ), chunkSize );
+            
+            unsigned int formatCode = sofaLocal::readUInt16( &format[0] );
+            numChannels             = sofaLocal::readUInt16( &format[2] );
+            samplingRate            = static_cast< double >( sofaLocal::readUInt32( &format[4] ) );
+            bitsPerSample           = sofaLocal::readUInt16( &format[14] );
+            
+            /// the sub-format of WAVE_FORMAT_EXTENSIBLE starts with the format code
+            if( formatCode == sofaLocal::kFormatExtensible && chunkSize >= 26 )
+            {
+                formatCode = sofaLocal::readUInt16( &format[24] );
+            }
+            
+            floatingPoint = ( formatCode == sofaLocal::kFormatFloat );
+            
+            const bool validPCM     = ( formatCode == sofaLocal::kFormatPCM ) && ( bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32 );
+            const bool validFloat   = ( floatingPoint == true ) && ( bitsPerSample == 32 || bitsPerSample == 64 );
+            
+            if( ( validPCM == false && validFloat == false ) || numChannels == 0 )
+            {
+                SOFA_THROW( path + " : unsupported WAV format" );
+            }
+            
+            hasFormat = true;
+        }
+        else if( std::memcmp( chunk, "data", 4 ) == 0 )
+        {
+            if( hasFormat == false )
+            {
+                SOFA_THROW( path + " : the data chunk precedes the format chunk" );
+            }
+            
+            numFrames = chunkSize / ( numChannels * ( bitsPerSample / 8 ) );
+            break;
+        }
+        else
+        {
+            /// chunks are padded to an even size
+            stream.seekg( chunkSize + ( chunkSize & 1 ), std::ios::cur );
+        }
+    }
+}
+
+unsigned int WaveReader::GetNumChannels() const
+{
+    return numChannels;
+}
+
+std::size_t WaveReader::GetNumFrames() const
+{
+    return numFrames;
+}
+
+double WaveReader::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+unsigned int WaveReader::GetBitsPerSample() const
+{
+    return bitsPerSample;
+}
+
+bool WaveReader::IsFloatingPoint() const
+{
+    return floatingPoint;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads the next frames
+ *  @param[out]     channels : GetNumChannels() buffers of numFrames values
+ *  @return         the number of frames read (smaller than numFrames at the end of the file;
+ *                  the remaining values are then set to 0)
+ *
+ */
+/************************************************************************************/
+std::size_t WaveReader::Read(double * const *channels,
+                             const std::size_t numFrames_)
+{
+    const std::size_t bytesPerSample    = bitsPerSample / 8;
+    const std::size_t bytesPerFrame     = bytesPerSample * numChannels;
+    
+    const std::size_t count = sofa::smin( numFrames_, numFrames - position );
+    
+    std::size_t done = 0;
+    while( done < count )
+    {
+        const std::size_t chunk = sofa::smin( sofaLocal::kFramesPerChunk, count - done );
+        
+        buffer.resize( chunk * bytesPerFrame );
+        
+        if( ! stream.read( reinterpret_cast< char * >( &buffer[0] ), chunk * bytesPerFrame ) )
+        {
+            SOFA_THROW( "cannot read the samples of the WAV file" );
+        }
+        
+        for( std::size_t i = 0; i < chunk; i++ )
+        {
+            for( unsigned int c = 0; c < numChannels; c++ )
+            {
+                channels[c][ done + i ] = sofaLocal::decodeSample( &buffer[ i * bytesPerFrame + c * bytesPerSample ], bitsPerSample, floatingPoint );
+            }
+        }
+        
+        done += chunk;
+    }
+    
+    for( unsigned int c = 0; c < numChannels; c++ )
+    {
+        std::fill( channels[c] + count, channels[c] + numFrames_, 0.0 );
+    }
+    
+    position += count;
+    
+    return count;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads all the remaining frames
+ *  @param[out]     values : [GetNumChannels() numFrames]
+ *  @return         the number of frames read
+ *
+ */
+/************************************************************************************/
+std::size_t WaveReader::Read(std::vector< double > &values)
+{
+    const std::size_t count = numFrames - position;
+    
+    values.resize( numChannels * count );
+    
+    std::vector< double * > channels( numChannels );
+    for( unsigned int c = 0; c < numChannels; c++ )
+    {
+        channels[c] = values.empty() == true ? nullptr : &values[ c * count ];
+    }
+    
+    if( count == 0 )
+    {
+        return 0;
+    }
+    
+    return Read( &channels[0], count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Creates a WAV file (an existing file is overwritten)
+ *
+ */
+/************************************************************************************/
+WaveWriter::WaveWriter(const std::string &path,
+                       const unsigned int numChannels_,
+                       const double samplingRate_,
+                       const sofa::WaveWriter::Format &format_)
+: numChannels( numChannels_ )
+, samplingRate( samplingRate_ )
+, format( format_ )
+, numFrames( 0 )
+{
+    if( numChannels == 0 || samplingRate <= 0.0 )
+    {
+        SOFA_THROW( "invalid number of channels or sampling rate" );
+    }
+    
+    if( format != kPCM16 && format != kPCM24 && format != kFloat32 )
+    {
+        SOFA_THROW( "invalid WAV format" );
+    }
+    
+    stream.open( path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    
+    if( stream.is_open() == false )
+    {
+        SOFA_THROW( "cannot create " + path );
+    }
+    
+    writeHeader();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor : closes the file (errors are ignored)
+ *
+ */
+/************************************************************************************/
+WaveWriter::~WaveWriter()
+{
+    try
+    {
+        Close();
+    }
+    catch( ... )
+    {
+    }
+}
+
+unsigned int WaveWriter::GetNumChannels() const
+{
+    return numChannels;
+}
+
+std::size_t WaveWriter::GetNumFrames() const
+{
+    return numFrames;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes (or rewrites) the header, for the current number of frames
+ *
+ *  @details        PCM files have the canonical 44-byte header. Floating-point files
+ *                  have an 18-byte format chunk (cbSize = 0) followed by a 'fact' chunk
+ *                  holding the number of frames, as required for non-PCM formats
+ */
+/************************************************************************************/
+void WaveWriter::writeHeader()
+{
+    const bool isFloat                  = ( format == kFloat32 );
+    const unsigned int bytesPerSample   = ( format == kPCM16 ) ? 2 : ( format == kPCM24 ? 3 : 4 );
+    const unsigned long dataSize        = static_cast< unsigned long >( numFrames * numChannels * bytesPerSample );
+    const unsigned long formatSize      = isFloat == true ? 18 : 16;
+    const std::size_t headerSize        = isFloat == true ? 58 : 44;
+    
+    unsigned char header[58];
+    std::memset( header, 0, sizeof( header ) );
+    
+    std::memcpy( header, "RIFF", 4 );
+    sofaLocal::writeUInt32( header + 4, static_cast< unsigned long >( headerSize - 8 ) + dataSize + ( dataSize & 1 ) );
+    std::memcpy( header + 8, "WAVEfmt ", 8 );
+    sofaLocal::writeUInt32( header + 16, formatSize );
+    sofaLocal::writeUInt16( header + 20, isFloat == true ? sofaLocal::kFormatFloat : sofaLocal::kFormatPCM );
+    sofaLocal::writeUInt16( header + 22, numChannels );
+    sofaLocal::writeUInt32( header + 24, static_cast< unsigned long >( samplingRate + 0.5 ) );
+    sofaLocal::writeUInt32( header + 28, static_cast< unsigned long >( samplingRate + 0.5 ) * numChannels * bytesPerSample );
+    sofaLocal::writeUInt16( header + 32, numChannels * bytesPerSample );
+    sofaLocal::writeUInt16( header + 34, 8 * bytesPerSample );
+    
+    unsigned char *data = header + 36;
+    
+    if( isFloat == true )
+    {
+        /// cbSize ( 0 ), then the fact chunk
+        sofaLocal::writeUInt16( header + 36, 0 );
+        std::memcpy( header + 38, "fact", 4 );
+        sofaLocal::writeUInt32( header + 42, 4 );
+        sofaLocal::writeUInt32( header + 46, static_cast< unsigned long >( numFrames ) );
+        
+        data = header + 50;
+    }
+    
+    std::memcpy( data, "data", 4 );
+    sofaLocal::writeUInt32( data + 4, dataSize );
+    
+    stream.write( reinterpret_cast< const char * >( header ), headerSize );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Appends frames to the file
+ *  @param[in]      channels : GetNumChannels() buffers of numFrames values
+ *
+ */
+/************************************************************************************/
+void WaveWriter::Write(const double * const *channels,
+                       const std::size_t numFrames_)
+{
+    if( stream.is_open() == false )
+    {
+        SOFA_THROW( "the WAV file is closed" );
+    }
+    
+    const std::size_t bytesPerSample    = ( format == kPCM16 ) ? 2 : ( format == kPCM24 ? 3 : 4 );
+    const std::size_t bytesPerFrame     = bytesPerSample * numChannels;
+    
+    std::size_t done = 0;
+    while( done < numFrames_ )
+    {
+        const std::size_t chunk = sofa::smin( sofaLocal::kFramesPerChunk, numFrames_ - done );
+        
+        buffer.resize( chunk * bytesPerFrame );
+        
+        for( std::size_t i = 0; i < chunk; i++ )
+        {
+            for( unsigned int c = 0; c < numChannels; c++ )
+            {
+                unsigned char *bytes = &buffer[ i * bytesPerFrame + c * bytesPerSample ];
+                const double value = channels[c][ done + i ];
+                
+                if( format == kFloat32 )
+                {
+                    const float f = static_cast< float >( value );
+                    uint32_t bits;
+                    std::memcpy( &bits, &f, sizeof( float ) );
+                    sofaLocal::writeUInt32( bytes, bits );
+                }
+                else if( format == kPCM16 )
+                {
+                    const double scaled = std::floor( sofa::smax( -1.0, sofa::smin( 1.0, value ) ) * 32767.0 + 0.5 );
+                    sofaLocal::writeUInt16( bytes, static_cast< unsigned int >( static_cast< int >( scaled ) ) & 0xFFFF );
+                }
+                else
+                {
+                    const double scaled = std::floor( sofa::smax( -1.0, sofa::smin( 1.0, value ) ) * 8388607.0 + 0.5 );
+                    const unsigned long bits = static_cast< unsigned long >( static_cast< long >( scaled ) ) & 0xFFFFFF;
+                    bytes[0] = (unsigned char) ( bits & 0xFF );
+                    bytes[1] = (unsigned char) ( ( bits >> 8 ) & 0xFF );
+                    bytes[2] = (unsigned char) ( ( bits >> 16 ) & 0xFF );
+                }
+            }
+        }
+        
+        stream.write( reinterpret_cast< const char * >( &buffer[0] ), chunk * bytesPerFrame );
+        
+        done += chunk;
+    }
+    
+    if( ! stream )
+    {
+        SOFA_THROW( "cannot write the WAV file" );
+    }
+    
+    numFrames += numFrames_;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Updates the header and closes the file
+ *
+ */
+/************************************************************************************/
+void WaveWriter::Close()
+{
+    if( stream.is_open() == false )
+    {
+        return;
+    }
+    
+    const std::size_t bytesPerSample = ( format == kPCM16 ) ? 2 : ( format == kPCM24 ? 3 : 4 );
+    
+    /// the data chunk is padded to an even size
+    if( ( numFrames * numChannels * bytesPerSample ) % 2 != 0 )
+    {
+        stream.put( 0 );
+    }
+    
+    stream.seekp( 0, std::ios::beg );
+    writeHeader();
+    stream.close();
+}
+
@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAWaveFile.h
+ *   @brief      Streamed reading and writing of WAV audio files
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_WAVE_FILE_H__
+#define _SOFA_WAVE_FILE_H__
+
+#include "../src/SOFAPlatform.h"
+#include <fstream>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          WaveReader
+     *  @brief          Reads the samples of a WAV file, block by block
+     *
+     *  @details        Integer PCM (8, 16, 24 or 32 bits) and floating-point (32 or 64 bits)
+     *                  files are supported, including WAVE_FORMAT_EXTENSIBLE headers.
+     *                  The samples are returned as doubles in [-1 1], one buffer per channel.
+     */
+    /************************************************************************************/
+    class SOFA_API WaveReader
+    {
+    public:
+        WaveReader(const std::string &path);
+        ~WaveReader() {};
+        
+        unsigned int GetNumChannels() const;
+        std::size_t GetNumFrames() const;
+        double GetSamplingRate() const;
+        unsigned int GetBitsPerSample() const;
+        bool IsFloatingPoint() const;
+        
+        std::size_t Read(double * const *channels,
+                         const std::size_t numFrames);
+        
+        std::size_t Read(std::vector< double > &values);
+        
+    protected:
+        std::ifstream stream;
+        unsigned int numChannels;
+        unsigned int bitsPerSample;
+        bool floatingPoint;
+        double samplingRate;
+        std::size_t numFrames;
+        std::size_t position;                   ///< index of the next frame to read
+        std::vector< unsigned char > buffer;    ///< raw interleaved samples
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( WaveReader );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          WaveWriter
+     *  @brief          Writes a WAV file, block by block
+     *
+     *  @details        The sizes in the header are updated by Close() (or by the destructor)
+     */
+    /************************************************************************************/
+    class SOFA_API WaveWriter
+    {
+    public:
+        enum Format
+        {
+            kPCM16              = 0,    ///< 16-bit integer, with clipping
+            kPCM24              = 1,    ///< 24-bit integer, with clipping
+            kFloat32            = 2,    ///< 32-bit floating point
+            
+            kNumFormats         = 3
+        };
+        
+    public:
+        WaveWriter(const std::string &path,
+                   const unsigned int numChannels,
+                   const double samplingRate,
+                   const sofa::WaveWriter::Format &format = kFloat32);
+        
+        ~WaveWriter();
+        
+        unsigned int GetNumChannels() const;
+        std::size_t GetNumFrames() const;
+        
+        void Write(const double * const *channels,
+                   const std::size_t numFrames);
+        
+        void Close();
+        
+    protected:
+        //==============================================================================
+        void writeHeader();
+        
+    protected:
+        std::ofstream stream;
+        const unsigned int numChannels;
+        const double samplingRate;
+        const sofa::WaveWriter::Format format;
+        std::size_t numFrames;
+        std::vector< unsigned char > buffer;    ///< raw interleaved samples
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( WaveWriter );
+    };
+    
+}
+
+#endif /* _SOFA_WAVE_FILE_H__ */
+
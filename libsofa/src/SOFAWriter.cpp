@@ -0,0 +1,725 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAWriter.cpp
+ *   @brief      Class for writing SOFA files
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAWriter.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFANcUtils.h"
+#include "../src/SOFAAttributes.h"
+#include "../src/SOFADate.h"
+#include "../src/SOFAAPI.h"
+#include <algorithm>
+
+using namespace sofa;
+
+namespace sofaLocal
+{
+    /// above this size (in bytes), permuted variables are copied measurement by measurement
+    static const std::size_t kMaxInMemoryCopySize = 64 * 1024 * 1024;
+    
+    static std::size_t getNumElements(const std::vector< std::size_t > &dims)
+    {
+        std::size_t size = 1;
+        for( std::size_t i = 0; i < dims.size(); i++ )
+        {
+            size *= dims[i];
+        }
+        return size;
+    }
+    
+    static bool isExcluded(const std::string &name, const std::vector< std::string > &excluded)
+    {
+        return std::find( excluded.begin(), excluded.end(), name ) != excluded.end();
+    }
+    
+    /// raw values of a variable or an attribute.
+    /// variable-length strings are read as char * allocated by netCDF, which are released here
+    class RawValues
+    {
+    public:
+        RawValues(const netCDF::NcType &type_,
+                  const std::size_t numElements_)
+        : isString( type_ == netCDF::NcType::nc_STRING )
+        , numElements( numElements_ )
+        , buffer( numElements_ * type_.getSize() + 1, 0 )
+        {
+        }
+        
+        ~RawValues()
+        {
+            Release();
+        }
+        
+        void * Get()
+        {
+            return static_cast< void * >( &buffer[0] );
+        }
+        
+        const char * Begin() const
+        {
+            return &buffer[0];
+        }
+        
+        /// to be called after each write, before the buffer is read again
+        void Release()
+        {
+            if( isString == true && numElements > 0 )
+            {
+                nc_free_string( numElements, reinterpret_cast< char ** >( &buffer[0] ) );
+                std::fill( buffer.begin(), buffer.end(), 0 );
+            }
+        }
+        
+    private:
+        SOFA_AVOID_COPY_CONSTRUCTOR( RawValues );
+        
+        const bool isString;
+        const std::size_t numElements;
+        std::vector< char > buffer;
+    };
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      path : the file path
+ *  @param[in]      mode : opening mode (by default, the file is created or replaced)
+ *
+ *  @details        The file is always written with the netCDF-4 / HDF5 format
+ */
+/************************************************************************************/
+Writer::Writer(const std::string &path,
+               const netCDF::NcFile::FileMode &mode)
+: file( path, mode, netCDF::NcFile::nc4 )
+, filename( path )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the filename
+ *
+ */
+/************************************************************************************/
+const std::string & Writer::GetFilename() const
+{
+    return filename;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Flushes the pending writes to disk
+ *
+ */
+/************************************************************************************/
+void Writer::Sync()
+{
+    file.sync();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds (or replaces) a global attribute
+ *
+ */
+/************************************************************************************/
+void Writer::PutGlobalAttribute(const std::string &attributeName, const std::string &attributeValue)
+{
+    file.putAtt( attributeName, attributeValue );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies all the global attributes of a source file
+ *
+ *  @details        In SOFA, the global attributes are always strings
+ */
+/************************************************************************************/
+void Writer::CopyGlobalAttributes(const sofa::NetCDFFile &source)
+{
+    std::vector< std::string > attributeNames;
+    std::vector< std::string > attributeValues;
+    source.GetAllCharAttributes( attributeNames, attributeValues );
+    
+    SOFA_ASSERT( attributeNames.size() == attributeValues.size() );
+    
+    for( std::size_t i = 0; i < attributeNames.size(); i++ )
+    {
+        file.putAtt( attributeNames[i], attributeValues[i] );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Updates the 'DateModified', 'APIName' and 'APIVersion' global attributes
+ *
+ */
+/************************************************************************************/
+void Writer::UpdateModificationAttributes()
+{
+    const std::string now = sofa::Date::GetCurrentDate().ToISO8601();
+    
+    PutGlobalAttribute( sofa::Attributes::GetName( sofa::Attributes::kDateModified ), now );
+    PutGlobalAttribute( sofa::Attributes::GetName( sofa::Attributes::kAPIName ), sofa::ApiInfos::GetAPIName() );
+    PutGlobalAttribute( sofa::Attributes::GetName( sofa::Attributes::kAPIVersion ), sofa::ApiInfos::GetAPIVersion() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a fixed-size dimension
+ *
+ */
+/************************************************************************************/
+void Writer::AddDimension(const std::string &dimensionName, const std::size_t size)
+{
+    if( size == 0 )
+    {
+        SOFA_THROW( "invalid size for dimension '" + dimensionName + "'" );
+    }
+    
+    file.addDim( dimensionName, size );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds an unlimited (record) dimension
+ *
+ */
+/************************************************************************************/
+void Writer::AddUnlimitedDimension(const std::string &dimensionName)
+{
+    file.addDim( dimensionName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the file has the given dimension
+ *
+ */
+/************************************************************************************/
+bool Writer::HasDimension(const std::string &dimensionName) const
+{
+    const netCDF::NcDim dim = file.getDim( dimensionName );
+    
+    return sofa::NcUtils::IsValid( dim );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the current size of a dimension (0 if it does not exist)
+ *
+ */
+/************************************************************************************/
+std::size_t Writer::GetDimension(const std::string &dimensionName) const
+{
+    const netCDF::NcDim dim = file.getDim( dimensionName );
+    
+    if( sofa::NcUtils::IsValid( dim ) == true )
+    {
+        return dim.getSize();
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies all the dimensions of a source file, except the excluded ones
+ *
+ *  @details        Unlimited dimensions are kept unlimited
+ */
+/************************************************************************************/
+void Writer::CopyDimensions(const sofa::NetCDFFile &source,
+                            const std::vector< std::string > &excludedDimensions)
+{
+    const std::multimap< std::string, netCDF::NcDim > dims = source.file.getDims();
+    
+    for( std::multimap< std::string, netCDF::NcDim >::const_iterator it = dims.begin();
+        it != dims.end();
+        ++it )
+    {
+        const std::string dimName = (*it).first;
+        const netCDF::NcDim dim   = (*it).second;
+        
+        if( sofaLocal::isExcluded( dimName, excludedDimensions ) == true
+           || HasDimension( dimName ) == true )
+        {
+            continue;
+        }
+        
+        if( dim.isUnlimited() == true )
+        {
+            AddUnlimitedDimension( dimName );
+        }
+        else
+        {
+            AddDimension( dimName, dim.getSize() );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a variable given its name. Throws an exception if the variable
+ *                  does not exist.
+ *
+ */
+/************************************************************************************/
+netCDF::NcVar Writer::getVariable(const std::string &variableName) const
+{
+    const netCDF::NcVar var = file.getVar( variableName );
+    
+    if( sofa::NcUtils::IsValid( var ) == false )
+    {
+        SOFA_THROW( "missing '" + variableName + "' variable" );
+    }
+    
+    return var;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a variable of a source file (for derived writers, which
+ *                  read values of the source file directly). Throws an exception if
+ *                  the variable does not exist.
+ *
+ */
+/************************************************************************************/
+netCDF::NcVar Writer::getSourceVariable(const sofa::NetCDFFile &source,
+                                        const std::string &variableName)
+{
+    const netCDF::NcVar var = source.getVariable( variableName );
+    
+    if( sofa::NcUtils::IsValid( var ) == false )
+    {
+        SOFA_THROW( "missing '" + variableName + "' variable" );
+    }
+    
+    return var;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the file has the given variable
+ *
+ */
+/************************************************************************************/
+bool Writer::HasVariable(const std::string &variableName) const
+{
+    const netCDF::NcVar var = file.getVar( variableName );
+    
+    return sofa::NcUtils::IsValid( var );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a variable
+ *  @param[in]      variableName : name of the variable
+ *  @param[in]      dimensionNames : names of the dimensions (they must exist in the file)
+ *  @param[in]      type_ : type of the variable (by default, double)
+ *
+ */
+/************************************************************************************/
+void Writer::AddVariable(const std::string &variableName,
+                         const std::vector< std::string > &dimensionNames,
+                         const netCDF::NcType &type_)
+{
+    std::vector< netCDF::NcDim > dims( dimensionNames.size() );
+    
+    for( std::size_t i = 0; i < dimensionNames.size(); i++ )
+    {
+        dims[i] = file.getDim( dimensionNames[i] );
+        
+        if( sofa::NcUtils::IsValid( dims[i] ) == false )
+        {
+            SOFA_THROW( "missing dimension '" + dimensionNames[i] + "' for variable '" + variableName + "'" );
+        }
+    }
+    
+    file.addVar( variableName, type_, dims );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds (or replaces) a string attribute of a variable
+ *
+ */
+/************************************************************************************/
+void Writer::PutVariableAttribute(const std::string &variableName,
+                                  const std::string &attributeName,
+                                  const std::string &attributeValue)
+{
+    const netCDF::NcVar var = getVariable( variableName );
+    
+    var.putAtt( attributeName, attributeValue );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the HDF5 chunk shape of a variable.
+ *                  This must be called before any value is written into the variable.
+ *
+ */
+/************************************************************************************/
+void Writer::SetChunking(const std::string &variableName,
+                         const std::vector< std::size_t > &chunkSizes)
+{
+    const netCDF::NcVar var = getVariable( variableName );
+    
+    if( chunkSizes.size() != static_cast< std::size_t >( var.getDimCount() ) )
+    {
+        SOFA_THROW( "invalid chunk dimensionality for '" + variableName + "'" );
+    }
+    
+    std::vector< std::size_t > sizes = chunkSizes;
+    var.setChunking( netCDF::NcVar::nc_CHUNKED, sizes );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Enables the HDF5 shuffle and deflate filters for a variable.
+ *                  This must be called before any value is written into the variable.
+ *  @param[in]      shuffle : enables the byte shuffle filter
+ *  @param[in]      deflateLevel : from 1 to 9, or 0 to disable the deflate filter
+ *
+ */
+/************************************************************************************/
+void Writer::SetCompression(const std::string &variableName,
+                            const bool shuffle,
+                            const int deflateLevel)
+{
+    const netCDF::NcVar var = getVariable( variableName );
+    
+    var.setCompression( shuffle, deflateLevel > 0, deflateLevel );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes all the values of a double variable
+ *
+ */
+/************************************************************************************/
+void Writer::PutValues(const std::string &variableName,
+                       const double *values)
+{
+    const netCDF::NcVar var = getVariable( variableName );
+    
+    var.putVar( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a hyperslab of a double variable
+ *  @param[in]      start : index of the first element, for each dimension
+ *  @param[in]      count : number of elements, for each dimension
+ *
+ *  @details        Writing past the end of an unlimited dimension extends it
+ */
+/************************************************************************************/
+void Writer::PutValues(const std::string &variableName,
+                       const double *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count)
+{
+    const netCDF::NcVar var = getVariable( variableName );
+    
+    var.putVar( start, count, values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a hyperslab of an integer variable
+ *
+ */
+/************************************************************************************/
+void Writer::PutValues(const std::string &variableName,
+                       const short *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count)
+{
+    const netCDF::NcVar var = getVariable( variableName );
+    
+    var.putVar( start, count, values );
+}
+
+void Writer::PutValues(const std::string &variableName,
+                       const int *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count)
+{
+    const netCDF::NcVar var = getVariable( variableName );
+    
+    var.putVar( start, count, values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Defines a variable with the same type, dimensions and attributes
+ *                  as in the source file. The dimensions must exist in this file.
+ *
+ */
+/************************************************************************************/
+void Writer::CopyVariableDefinition(const sofa::NetCDFFile &source,
+                                    const std::string &variableName)
+{
+    const netCDF::NcVar srcVar = getSourceVariable( source, variableName );
+    
+    std::vector< std::string > dimNames;
+    sofa::NcUtils::GetDimensionsNames( dimNames, srcVar );
+    
+    CopyVariableDefinition( source, variableName, dimNames );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Defines a variable with the same type and attributes as in the source
+ *                  file, but other dimensions (e.g. [M R] instead of [I R])
+ *
+ */
+/************************************************************************************/
+void Writer::CopyVariableDefinition(const sofa::NetCDFFile &source,
+                                    const std::string &variableName,
+                                    const std::vector< std::string > &dimensionNames)
+{
+    const netCDF::NcVar srcVar = getSourceVariable( source, variableName );
+    
+    AddVariable( variableName, dimensionNames, srcVar.getType() );
+    
+    const netCDF::NcVar dstVar = getVariable( variableName );
+    
+    const std::map< std::string, netCDF::NcVarAtt > attributes = srcVar.getAtts();
+    
+    for( std::map< std::string, netCDF::NcVarAtt >::const_iterator it = attributes.begin();
+        it != attributes.end();
+        ++it )
+    {
+        const netCDF::NcVarAtt att  = (*it).second;
+        const netCDF::NcType type_  = att.getType();
+        
+        const std::size_t length = att.getAttLength();
+        
+        sofaLocal::RawValues values( type_, length );
+        att.getValues( values.Get() );
+        
+        dstVar.putAtt( (*it).first, type_, length, values.Get() );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies all the values of a variable from the source file.
+ *                  The variable must have been defined beforehand, with the same dimensions.
+ *
+ */
+/************************************************************************************/
+void Writer::CopyVariableValues(const sofa::NetCDFFile &source,
+                                const std::string &variableName)
+{
+    const netCDF::NcVar srcVar = source.getVariable( variableName );
+    const netCDF::NcVar dstVar = getVariable( variableName );
+    
+    if( sofa::NcUtils::IsValid( srcVar ) == false )
+    {
+        SOFA_THROW( "missing '" + variableName + "' variable" );
+    }
+    
+    const netCDF::NcType type_ = srcVar.getType();
+    
+    std::vector< std::size_t > dims;
+    sofa::NcUtils::GetDimensions( dims, srcVar );
+    
+    const std::size_t numElements = sofaLocal::getNumElements( dims );
+    
+    if( numElements == 0 )
+    {
+        return;
+    }
+    
+    const std::vector< std::size_t > start( dims.size(), 0 );
+    
+    sofaLocal::RawValues values( type_, numElements );
+    srcVar.getVar( start, dims, values.Get() );
+    dstVar.putVar( start, dims, values.Get() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies the values of a variable whose first dimension is M,
+ *                  with a permutation or a selection of the measurements
+ *  @param[in]      measurementsOrder : the i-th measurement of this file is the
+ *                  measurementsOrder[i]-th measurement of the source file; its size is
+ *                  the M dimension of this file (at most the one of the source)
+ *
+ */
+/************************************************************************************/
+void Writer::CopyVariableValues(const sofa::NetCDFFile &source,
+                                const std::string &variableName,
+                                const std::vector< std::size_t > &measurementsOrder)
+{
+    const netCDF::NcVar srcVar = source.getVariable( variableName );
+    const netCDF::NcVar dstVar = getVariable( variableName );
+    
+    if( sofa::NcUtils::IsValid( srcVar ) == false )
+    {
+        SOFA_THROW( "missing '" + variableName + "' variable" );
+    }
+    
+    std::vector< std::string > dimNames;
+    sofa::NcUtils::GetDimensionsNames( dimNames, srcVar );
+    
+    if( dimNames.empty() == true || dimNames[0] != "M" )
+    {
+        SOFA_THROW( "'" + variableName + "' is not a per-measurement variable" );
+    }
+    
+    const netCDF::NcType type_ = srcVar.getType();
+    
+    std::vector< std::size_t > dims;
+    sofa::NcUtils::GetDimensions( dims, srcVar );
+    
+    const std::size_t M         = dims[0];
+    const std::size_t numOutput = measurementsOrder.size();
+    
+    if( numOutput > M )
+    {
+        SOFA_THROW( "invalid permutation size for '" + variableName + "'" );
+    }
+    
+    for( std::size_t i = 0; i < numOutput; i++ )
+    {
+        if( measurementsOrder[i] >= M )
+        {
+            SOFA_THROW( "invalid measurement index for '" + variableName + "'" );
+        }
+    }
+    
+    std::vector< std::size_t > slabDims = dims;
+    slabDims[0] = 1;
+    
+    std::vector< std::size_t > outputDims = dims;
+    outputDims[0] = numOutput;
+    
+    const std::size_t slabElements = sofaLocal::getNumElements( slabDims );
+    const std::size_t slabSize     = slabElements * type_.getSize();
+    
+    if( slabSize == 0 || numOutput == 0 )
+    {
+        return;
+    }
+    
+    const std::vector< std::size_t > origin( dims.size(), 0 );
+    
+    if( slabSize * M <= sofaLocal::kMaxInMemoryCopySize )
+    {
+        /// small variable : one read, permutation in memory, one write
+        /// (strings are permuted as pointers, which remain owned by 'input')
+        sofaLocal::RawValues input( type_, slabElements * M );
+        std::vector< char > output( slabSize * numOutput );
+        
+        srcVar.getVar( origin, dims, input.Get() );
+        
+        for( std::size_t i = 0; i < numOutput; i++ )
+        {
+            const std::size_t j = measurementsOrder[i];
+            
+            std::copy( input.Begin() + j * slabSize,
+                       input.Begin() + ( j + 1 ) * slabSize,
+                       output.begin() + i * slabSize );
+        }
+        
+        dstVar.putVar( origin, outputDims, static_cast< void * >( &output[0] ) );
+    }
+    else
+    {
+        /// large variable (e.g. Data.IR) : stream one measurement at a time
+        sofaLocal::RawValues buffer( type_, slabElements );
+        
+        std::vector< std::size_t > srcStart = origin;
+        std::vector< std::size_t > dstStart = origin;
+        
+        for( std::size_t i = 0; i < numOutput; i++ )
+        {
+            srcStart[0] = measurementsOrder[i];
+            dstStart[0] = i;
+            
+            srcVar.getVar( srcStart, slabDims, buffer.Get() );
+            dstVar.putVar( dstStart, slabDims, buffer.Get() );
+            buffer.Release();
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies the definitions and values of all the variables of the source file,
+ *                  except the excluded ones.
+ *                  The dimensions must have been created beforehand.
+ *
+ */
+/************************************************************************************/
+void Writer::CopyVariables(const sofa::NetCDFFile &source,
+                           const std::vector< std::string > &excludedVariables)
+{
+    std::vector< std::string > variableNames;
+    source.GetAllVariablesNames( variableNames );
+    
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
+    {
+        const std::string name = variableNames[i];
+        
+        if( sofaLocal::isExcluded( name, excludedVariables ) == true )
+        {
+            continue;
+        }
+        
+        CopyVariableDefinition( source, name );
+        CopyVariableValues( source, name );
+    }
+}
+
@@ -0,0 +1,174 @@
+/*
+Copyright (c) 2026, libsofa contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAWriter.h
+ *   @brief      Class for writing SOFA files
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_WRITER_H__
+#define _SOFA_WRITER_H__
+
+#include "../src/SOFANcFile.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Writer
+     *  @brief          Creates a netCDF-4 file and fills it with SOFA attributes, dimensions and variables
+     *
+     *  @details        The writer can copy the definitions and values from an existing file,
+     *                  so that processing stages can produce a new SOFA file which only differs
+     *                  from the source by a few variables.
+     *                  Variables whose first dimension is M can be copied with a permutation
+     *                  of the measurements.
+     */
+    /************************************************************************************/
+    class SOFA_API Writer
+    {
+    public:
+        Writer(const std::string &path,
+               const netCDF::NcFile::FileMode &mode = netCDF::NcFile::replace);
+        
+        virtual ~Writer() {};
+        
+        const std::string & GetFilename() const;
+        
+        void Sync();
+        
+        //==============================================================================
+        // Attributes
+        //==============================================================================
+        void PutGlobalAttribute(const std::string &attributeName, const std::string &attributeValue);
+        void CopyGlobalAttributes(const sofa::NetCDFFile &source);
+        void UpdateModificationAttributes();
+        
+        //==============================================================================
+        // Dimensions
+        //==============================================================================
+        void AddDimension(const std::string &dimensionName, const std::size_t size);
+        void AddUnlimitedDimension(const std::string &dimensionName);
+        bool HasDimension(const std::string &dimensionName) const;
+        std::size_t GetDimension(const std::string &dimensionName) const;
+        
+        void CopyDimensions(const sofa::NetCDFFile &source,
+                            const std::vector< std::string > &excludedDimensions = std::vector< std::string >());
+        
+        //==============================================================================
+        // Variables
+        //==============================================================================
+        void AddVariable(const std::string &variableName,
+                         const std::vector< std::string > &dimensionNames,
+                         const netCDF::NcType &type_ = netCDF::NcType::nc_DOUBLE);
+        
+        bool HasVariable(const std::string &variableName) const;
+        
+        void PutVariableAttribute(const std::string &variableName,
+                                  const std::string &attributeName,
+                                  const std::string &attributeValue);
+        
+        void SetChunking(const std::string &variableName,
+                         const std::vector< std::size_t > &chunkSizes);
+        
+        void SetCompression(const std::string &variableName,
+                            const bool shuffle,
+                            const int deflateLevel);
+        
+        void PutValues(const std::string &variableName,
+                       const double *values);
+        
+        void PutValues(const std::string &variableName,
+                       const double *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count);
+        
+        void PutValues(const std::string &variableName,
+                       const short *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count);
+        
+        void PutValues(const std::string &variableName,
+                       const int *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count);
+        
+        void CopyVariableDefinition(const sofa::NetCDFFile &source,
+                                    const std::string &variableName);
+        
+        void CopyVariableDefinition(const sofa::NetCDFFile &source,
+                                    const std::string &variableName,
+                                    const std::vector< std::string > &dimensionNames);
+        
+        void CopyVariableValues(const sofa::NetCDFFile &source,
+                                const std::string &variableName);
+        
+        void CopyVariableValues(const sofa::NetCDFFile &source,
+                                const std::string &variableName,
+                                const std::vector< std::size_t > &measurementsOrder);
+        
+        void CopyVariables(const sofa::NetCDFFile &source,
+                           const std::vector< std::string > &excludedVariables = std::vector< std::string >());
+        
+    protected:
+        //==============================================================================
+        netCDF::NcVar getVariable(const std::string &variableName) const;
+        
+        static netCDF::NcVar getSourceVariable(const sofa::NetCDFFile &source,
+                                               const std::string &variableName);
+        
+    protected:
+        netCDF::NcFile file;
+        const std::string filename;
+        
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( Writer );
+    };
+    
+}
+
+#endif /* _SOFA_WRITER_H__ */
+
@@ -0,0 +1,236 @@
+/************************************************************************************/
+/*!
+ *   @file       sofa2wav.cpp
+ *   @brief      Exports the impulse responses of a SOFA file to WAV files
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFA.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+
+/// number of measurements loaded (and written) at once
+static const std::size_t kBatchSize = 64;
+
+/************************************************************************************/
+/*!
+ *  @brief          Displays the syntax
+ *
+ */
+/************************************************************************************/
+static void DisplayHelp(std::ostream & output = std::cout)
+{
+    output << "sofa2wav exports the impulse responses (Data.IR) of a SOFA file to 32-bit float WAV files" << std::endl;
+    output << "    syntax : ./sofa2wav [input.sofa] [output prefix] [mode (optional) : measurements | whole] [numthreads (optional, 0 = all)]" << std::endl;
+    output << "    measurements (default) : one file per measurement, 'prefix_0000.wav', with R x E channels" << std::endl;
+    output << "    whole : a single file 'prefix.wav' with R x E channels, the measurements one after the other" << std::endl;
+    output << "    the source positions (spherical) and delays (in samples) are written to 'prefix_positions.csv'," << std::endl;
+    output << "    which wav2sofa reads back as a manifest" << std::endl;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of the WAV file of a measurement
+ *
+ */
+/************************************************************************************/
+static std::string GetMeasurementPath(const std::string &prefix,
+                                      const std::size_t measurement)
+{
+    char index[32];
+    std::snprintf( index, sizeof( index ), "_%04lu.wav", static_cast< unsigned long >( measurement ) );
+    
+    return prefix + index;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of a file without its directory : the paths of the
+ *                  positions file are relative to it (as in the manifests of wav2sofa)
+ *
+ */
+/************************************************************************************/
+static std::string GetFileName(const std::string &path)
+{
+    const std::size_t separator = path.find_last_of( "/\\" );
+    
+    return ( separator == std::string::npos ) ? path : path.substr( separator + 1 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Main entry point
+ *
+ */
+/************************************************************************************/
+int main(int argc, char *argv[])
+{
+    std::ostream & output = std::cout;
+    
+    //==============================================================================
+    // Parsing arguments
+    //==============================================================================
+    if( argc < 3 || argc > 5 )
+    {
+        DisplayHelp( output );
+        return 0;
+    }
+    
+    const std::string inputPath     = argv[1];
+    const std::string prefix        = argv[2];
+    const std::string mode          = ( argc >= 4 ) ? argv[3] : "measurements";
+    const unsigned int numThreads   = ( argc == 5 ) ? (unsigned int) std::atoi( argv[4] ) : 0;
+    
+    if( mode != "measurements" && mode != "whole" )
+    {
+        DisplayHelp( output );
+        return 1;
+    }
+    
+    const bool wholeFile = ( mode == "whole" );
+    
+    try
+    {
+        const sofa::File theFile( inputPath );
+        
+        if( theFile.IsValid() == false )
+        {
+            std::cerr << inputPath << " is not a valid SOFA file" << std::endl;
+            return 1;
+        }
+        
+        std::vector< double > positions;
+        if( theFile.GetSourcePositionAsCartesian( positions ) == false )
+        {
+            SOFA_THROW( "invalid 'SourcePosition' variable" );
+        }
+        
+        const std::size_t M = static_cast< std::size_t >( theFile.GetNumMeasurements() );
+        
+        const std::string csvPath = prefix + "_positions.csv";
+        std::ofstream csv( csvPath.c_str() );
+        
+        if( csv.is_open() == false )
+        {
+            SOFA_THROW( "cannot create " + csvPath );
+        }
+        
+        csv.precision( 10 );
+        
+        std::shared_ptr< sofa::WaveWriter > wholeWriter;
+        
+        sofa::ImpulseResponses responses;
+        
+        /// the measurements are loaded batch by batch; the files of a batch are written in parallel
+        for( std::size_t first = 0; first < M; first += kBatchSize )
+        {
+            const std::size_t count = sofa::smin( kBatchSize, M - first );
+            
+            responses.Load( theFile, first, count );
+            
+            const std::size_t R = responses.GetNumReceivers();
+            const std::size_t E = responses.GetNumEmitters();
+            const std::size_t N = responses.GetNumDataSamples();
+            const std::size_t numChannels = R * E;
+            
+            if( first == 0 )
+            {
+                csv << "measurement,file,azimuth,elevation,distance";
+                for( std::size_t r = 0; r < R; r++ )
+                {
+                    for( std::size_t e = 0; e < E; e++ )
+                    {
+                        csv << ",delay_r" << r;
+                        if( E > 1 )
+                        {
+                            csv << "_e" << e;
+                        }
+                    }
+                }
+                csv << '\n';
+                
+                if( wholeFile == true )
+                {
+                    wholeWriter = std::make_shared< sofa::WaveWriter >( prefix + ".wav", (unsigned int) numChannels, responses.GetSamplingRate() );
+                }
+            }
+            
+            /// channel pointers of each measurement of the batch
+            std::vector< const double * > channels( count * numChannels );
+            for( std::size_t i = 0; i < count; i++ )
+            {
+                for( std::size_t r = 0; r < R; r++ )
+                {
+                    for( std::size_t e = 0; e < E; e++ )
+                    {
+                        channels[ i * numChannels + r * E + e ] = responses.GetResponse( responses.GetResponseIndex( i, r, e ) );
+                    }
+                }
+            }
+            
+            if( wholeFile == true )
+            {
+                for( std::size_t i = 0; i < count; i++ )
+                {
+                    wholeWriter->Write( &channels[ i * numChannels ], N );
+                }
+            }
+            else
+            {
+                const double samplingRate = responses.GetSamplingRate();
+                
+                sofa::Threads::ParallelFor( count,
+                                            [&]( const std::size_t i, const unsigned int )
+                                            {
+                                                sofa::WaveWriter writer( GetMeasurementPath( prefix, first + i ), (unsigned int) numChannels, samplingRate );
+                                                writer.Write( &channels[ i * numChannels ], N );
+                                                writer.Close();
+                                            },
+                                            numThreads );
+            }
+            
+            for( std::size_t i = 0; i < count; i++ )
+            {
+                const std::size_t m = first + i;
+                
+                double aed[3];
+                sofa::CartesianToSpherical( aed, &positions[ m * 3 ] );
+                
+                csv << m << "," << GetFileName( wholeFile == true ? prefix + ".wav" : GetMeasurementPath( prefix, m ) );
+                csv << "," << aed[0] << "," << aed[1] << "," << aed[2];
+                
+                for( std::size_t j = 0; j < numChannels; j++ )
+                {
+                    csv << "," << responses.GetDelay( i * numChannels + j );
+                }
+                csv << '\n';
+            }
+        }
+        
+        if( wholeWriter != nullptr )
+        {
+            wholeWriter->Close();
+        }
+        
+        output << inputPath << " -> " << ( wholeFile == true ? prefix + ".wav" : prefix + "_*.wav" );
+        output << " (" << M << " measurement(s)), " << csvPath << std::endl;
+    }
+    catch( std::exception &e )
+    {
+        std::cerr << "exception occured : " << e.what() << std::endl;
+        exit(1);
+    }
+    catch( ... )
+    {
+        std::cerr << "unknown exception occured" << std::endl;
+        exit(1);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,431 @@
+/************************************************************************************/
+/*!
+ *   @file       sofarender.cpp
+ *   @brief      Renders mono WAV files to binaural, with the HRTFs of a SOFA file
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFA.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+
+/// number of samples rendered per block
+static const std::size_t kBlockSize = 1024;
+
+/************************************************************************************/
+/*!
+ *  @brief          One point of a source trajectory
+ *
+ */
+/************************************************************************************/
+struct TrajectoryPoint
+{
+    double time;        ///< in seconds
+    double azimuth;     ///< in degrees
+    double elevation;   ///< in degrees
+};
+
+/************************************************************************************/
+/*!
+ *  @brief          One file to render
+ *
+ */
+/************************************************************************************/
+struct Job
+{
+    std::string inputPath;
+    std::string outputPath;
+    std::vector< TrajectoryPoint > trajectory;  ///< a single point for a static source
+    std::string error;
+};
+
+/************************************************************************************/
+/*!
+ *  @brief          Displays the syntax
+ *
+ */
+/************************************************************************************/
+static void DisplayHelp(std::ostream & output = std::cout)
+{
+    output << "sofarender renders mono WAV files to binaural, with the HRTFs of a SOFA file" << std::endl;
+    output << "    syntax : ./sofarender [hrtf.sofa] [input.wav] [output.wav] [azimuth] [elevation]" << std::endl;
+    output << "             ./sofarender [hrtf.sofa] [input.wav] [output.wav] [trajectory.csv]" << std::endl;
+    output << "             ./sofarender [hrtf.sofa] --jobs [joblist.txt] [numthreads (optional, 0 = all)]" << std::endl;
+    output << "    each line of a job list is 'input.wav output.wav azimuth elevation' or 'input.wav output.wav trajectory.csv'" << std::endl;
+    output << "    each line of a trajectory is 'time(s) azimuth elevation' (comma or space separated)" << std::endl;
+    output << "    the outputs are aligned with the inputs (the rendering latency is removed), and include the tail of the HRTFs" << std::endl;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a trajectory file, sorted by time
+ *
+ */
+/************************************************************************************/
+static void LoadTrajectory(std::vector< TrajectoryPoint > &trajectory,
+                           const std::string &path)
+{
+    std::ifstream stream( path.c_str() );
+    
+    if( stream.is_open() == false )
+    {
+        SOFA_THROW( "cannot open " + path );
+    }
+    
+    trajectory.clear();
+    
+    std::string line;
+    while( std::getline( stream, line ) )
+    {
+        std::replace( line.begin(), line.end(), ',', ' ' );
+        std::replace( line.begin(), line.end(), ';', ' ' );
+        
+        std::istringstream fields( line );
+        TrajectoryPoint point;
+        
+        if( fields >> point.time >> point.azimuth >> point.elevation )
+        {
+            trajectory.push_back( point );
+        }
+    }
+    
+    if( trajectory.empty() == true )
+    {
+        SOFA_THROW( path + " does not contain any position" );
+    }
+    
+    std::stable_sort( trajectory.begin(), trajectory.end(),
+                      []( const TrajectoryPoint &a, const TrajectoryPoint &b ) { return a.time < b.time; } );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a job list (lines starting with '#' are ignored)
+ *
+ */
+/************************************************************************************/
+static void LoadJobs(std::vector< Job > &jobs,
+                     const std::string &path)
+{
+    std::ifstream stream( path.c_str() );
+    
+    if( stream.is_open() == false )
+    {
+        SOFA_THROW( "cannot open " + path );
+    }
+    
+    std::string line;
+    while( std::getline( stream, line ) )
+    {
+        std::istringstream fields( line );
+        std::vector< std::string > tokens;
+        std::string token;
+        
+        while( fields >> token )
+        {
+            tokens.push_back( token );
+        }
+        
+        if( tokens.empty() == true || tokens[0][0] == '#' )
+        {
+            continue;
+        }
+        
+        Job job;
+        job.inputPath   = tokens[0];
+        job.outputPath  = ( tokens.size() > 1 ) ? tokens[1] : "";
+        
+        if( tokens.size() == 4 )
+        {
+            const TrajectoryPoint point = { 0.0, std::atof( tokens[2].c_str() ), std::atof( tokens[3].c_str() ) };
+            job.trajectory.push_back( point );
+        }
+        else if( tokens.size() == 3 )
+        {
+            LoadTrajectory( job.trajectory, tokens[2] );
+        }
+        else
+        {
+            SOFA_THROW( "invalid job : " + line );
+        }
+        
+        jobs.push_back( job );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the position of a trajectory at a given time, linearly
+ *                  interpolated (the azimuth along the shortest path)
+ *
+ */
+/************************************************************************************/
+static void GetPosition(double &azimuth,
+                        double &elevation,
+                        const std::vector< TrajectoryPoint > &trajectory,
+                        const double time)
+{
+    if( time <= trajectory.front().time || trajectory.size() == 1 )
+    {
+        azimuth     = trajectory.front().azimuth;
+        elevation   = trajectory.front().elevation;
+        return;
+    }
+    
+    if( time >= trajectory.back().time )
+    {
+        azimuth     = trajectory.back().azimuth;
+        elevation   = trajectory.back().elevation;
+        return;
+    }
+    
+    std::size_t i = 1;
+    while( trajectory[i].time <= time )
+    {
+        i++;
+    }
+    
+    const TrajectoryPoint &a = trajectory[ i - 1 ];
+    const TrajectoryPoint &b = trajectory[i];
+    
+    const double alpha = ( time - a.time ) / ( b.time - a.time );
+    
+    double deltaAzimuth = std::fmod( b.azimuth - a.azimuth, 360.0 );
+    if( deltaAzimuth > 180.0 )
+    {
+        deltaAzimuth -= 360.0;
+    }
+    else if( deltaAzimuth < -180.0 )
+    {
+        deltaAzimuth += 360.0;
+    }
+    
+    azimuth     = a.azimuth + alpha * deltaAzimuth;
+    elevation   = a.elevation + alpha * ( b.elevation - a.elevation );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Renders one file, block by block
+ *
+ *  @details        Only one block of the input and of the output is in memory.
+ *                  The latency of the renderer is removed : the first GetLatency()
+ *                  rendered frames are not written, so that the output is aligned
+ *                  with the input
+ */
+/************************************************************************************/
+static void Render(const Job &job,
+                   const std::shared_ptr< const sofa::BinauralFilters > &filters)
+{
+    sofa::WaveReader reader( job.inputPath );
+    
+    if( reader.GetNumChannels() != 1 )
+    {
+        SOFA_THROW( job.inputPath + " is not a mono file" );
+    }
+    
+    if( reader.GetSamplingRate() != filters->GetSamplingRate() )
+    {
+        SOFA_THROW( job.inputPath + " and the HRTFs do not have the same sampling rate" );
+    }
+    
+    sofa::BinauralRenderer renderer;
+    renderer.Setup( filters, 1, sofa::BinauralRenderer::kInverseDistance, 1 );
+    
+    const std::size_t numReceivers  = renderer.GetNumReceivers();
+    const std::size_t blockSize     = renderer.GetBlockSize();
+    const std::size_t numFrames     = reader.GetNumFrames() + renderer.GetTailLength();
+    const std::size_t latency       = renderer.GetLatency();
+    const double samplingRate       = filters->GetSamplingRate();
+    
+    sofa::WaveWriter writer( job.outputPath, (unsigned int) numReceivers, samplingRate );
+    
+    std::vector< double > input( blockSize, 0.0 );
+    std::vector< double > output( numReceivers * blockSize, 0.0 );
+    
+    double *inputs[1] = { &input[0] };
+    std::vector< double * > outputs( numReceivers );
+    std::vector< const double * > written( numReceivers );
+    for( std::size_t r = 0; r < numReceivers; r++ )
+    {
+        outputs[r] = &output[ r * blockSize ];
+    }
+    
+    for( std::size_t frame = 0; frame < numFrames; frame += blockSize )
+    {
+        double azimuth, elevation;
+        GetPosition( azimuth, elevation, job.trajectory, static_cast< double >( frame ) / samplingRate );
+        
+        if( frame == 0 || job.trajectory.size() > 1 )
+        {
+            renderer.SetSourcePosition( 0, azimuth, elevation );
+        }
+        
+        reader.Read( inputs, blockSize );
+        
+        renderer.Process( &outputs[0], inputs );
+        
+        /// rendered frames [begin end[ of this block, after the latency
+        const std::size_t begin = sofa::smax( frame, latency );
+        const std::size_t end   = sofa::smin( frame + blockSize, numFrames );
+        
+        if( begin < end )
+        {
+            for( std::size_t r = 0; r < numReceivers; r++ )
+            {
+                written[r] = outputs[r] + ( begin - frame );
+            }
+            
+            writer.Write( &written[0], end - begin );
+        }
+    }
+    
+    writer.Close();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Main entry point
+ *
+ */
+/************************************************************************************/
+int main(int argc, char *argv[])
+{
+    std::ostream & output = std::cout;
+    
+    //==============================================================================
+    // Parsing arguments
+    //==============================================================================
+    if( argc < 4 || argc > 6 )
+    {
+        DisplayHelp( output );
+        return 0;
+    }
+    
+    const std::string hrtfPath = argv[1];
+    
+    /// the job list mode is explicit, so that a missing argument is not taken for a job list
+    const bool jobListMode = ( std::string( argv[2] ) == "--jobs" );
+    
+    if( ( jobListMode == true && argc > 5 ) || ( jobListMode == false && argc == 4 ) )
+    {
+        DisplayHelp( output );
+        return 1;
+    }
+    
+    try
+    {
+        std::vector< Job > jobs;
+        unsigned int numThreads = 0;
+        
+        if( jobListMode == true )
+        {
+            LoadJobs( jobs, argv[3] );
+            
+            numThreads = ( argc == 5 ) ? (unsigned int) std::atoi( argv[4] ) : 0;
+        }
+        else if( argc == 6 )
+        {
+            Job job;
+            job.inputPath   = argv[2];
+            job.outputPath  = argv[3];
+            
+            const TrajectoryPoint point = { 0.0, std::atof( argv[4] ), std::atof( argv[5] ) };
+            job.trajectory.push_back( point );
+            
+            jobs.push_back( job );
+        }
+        else
+        {
+            Job job;
+            job.inputPath   = argv[2];
+            job.outputPath  = argv[3];
+            
+            LoadTrajectory( job.trajectory, argv[4] );
+            
+            jobs.push_back( job );
+        }
+        
+        const sofa::File theFile( hrtfPath );
+        
+        if( theFile.IsValid() == false )
+        {
+            std::cerr << hrtfPath << " is not a valid SOFA file" << std::endl;
+            return 1;
+        }
+        
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        
+        /// the filters are transformed once, and shared by all the renderers
+        std::shared_ptr< sofa::BinauralFilters > filters = std::make_shared< sofa::BinauralFilters >();
+        filters->Compute( theFile, kBlockSize, numThreads );
+        
+        const std::chrono::steady_clock::time_point prepared = std::chrono::steady_clock::now();
+        
+        /// one renderer per file, the files being rendered in parallel
+        sofa::Threads::ParallelFor( jobs.size(),
+                                    [&]( const std::size_t i, const unsigned int )
+                                    {
+                                        try
+                                        {
+                                            Render( jobs[i], filters );
+                                        }
+                                        catch( std::exception &e )
+                                        {
+                                            jobs[i].error = e.what();
+                                        }
+                                    },
+                                    numThreads );
+        
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        
+        std::size_t numFailed = 0;
+        for( std::size_t i = 0; i < jobs.size(); i++ )
+        {
+            if( jobs[i].error.empty() == true )
+            {
+                output << jobs[i].inputPath << " -> " << jobs[i].outputPath << std::endl;
+            }
+            else
+            {
+                std::cerr << jobs[i].inputPath << " : " << jobs[i].error << std::endl;
+                numFailed++;
+            }
+        }
+        
+        const double prepareTime   = std::chrono::duration< double >( prepared - start ).count();
+        const double renderTime    = std::chrono::duration< double >( end - prepared ).count();
+        
+        output << jobs.size() - numFailed << " file(s) rendered in " << renderTime << " s";
+        if( renderTime > 0.0 )
+        {
+            output << " (" << static_cast< double >( jobs.size() - numFailed ) / renderTime << " files/s)";
+        }
+        output << ", filters prepared in " << prepareTime << " s" << std::endl;
+        
+        if( numFailed > 0 )
+        {
+            return 1;
+        }
+    }
+    catch( std::exception &e )
+    {
+        std::cerr << "exception occured : " << e.what() << std::endl;
+        exit(1);
+    }
+    catch( ... )
+    {
+        std::cerr << "unknown exception occured" << std::endl;
+        exit(1);
+    }
+    
+    return 0;
+}
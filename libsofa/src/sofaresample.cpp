@@ -0,0 +1,84 @@
+/************************************************************************************/
+/*!
+ *   @file       sofaresample.cpp
+ *   @brief      Converts the Data.IR of a FIR / FIRE SOFA file to another sampling rate
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFA.h"
+#include <cstdlib>
+
+/************************************************************************************/
+/*!
+ *  @brief          Displays the syntax
+ *
+ */
+/************************************************************************************/
+static void DisplayHelp(std::ostream & output = std::cout)
+{
+    output << "sofaresample converts the impulse responses of a SOFA file to another sampling rate" << std::endl;
+    output << "    syntax : ./sofaresample [input] [output] [samplingrate] [numthreads (optional, 0 = all)]" << std::endl;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Main entry point
+ *
+ */
+/************************************************************************************/
+int main(int argc, char *argv[])
+{
+    std::ostream & output = std::cout;
+    
+    //==============================================================================
+    // Parsing arguments
+    //==============================================================================
+    if( argc != 4 && argc != 5 )
+    {
+        DisplayHelp( output );
+        return 0;
+    }
+    
+    const std::string inputPath     = argv[1];
+    const std::string outputPath    = argv[2];
+    const double samplingRate       = std::atof( argv[3] );
+    const unsigned int numThreads   = ( argc == 5 ) ? (unsigned int) std::atoi( argv[4] ) : 0;
+    
+    try
+    {
+        const sofa::File theFile( inputPath );
+        
+        if( theFile.IsValid() == false )
+        {
+            std::cerr << inputPath << " is not a valid SOFA file" << std::endl;
+            return 1;
+        }
+        
+        sofa::ImpulseResponses responses;
+        responses.Load( theFile );
+        
+        const double inputSamplingRate = responses.GetSamplingRate();
+        
+        sofa::Resampler::Process( responses, samplingRate, 32, numThreads );
+        
+        responses.Write( theFile, outputPath );
+        
+        output << inputPath << " (" << inputSamplingRate << " Hz) -> ";
+        output << outputPath << " (" << samplingRate << " Hz, N = " << responses.GetNumDataSamples() << ")" << std::endl;
+    }
+    catch( std::exception &e )
+    {
+        std::cerr << "exception occured : " << e.what() << std::endl;
+        exit(1);
+    }
+    catch( ... )
+    {
+        std::cerr << "unknown exception occured" << std::endl;
+        exit(1);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,322 @@
+/************************************************************************************/
+/*!
+ *   @file       wav2sofa.cpp
+ *   @brief      Packs WAV impulse responses into a SOFA file
+ *   @author     libsofa contributors
+ *
+ *   @date       19/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFA.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+/// number of WAV files read (in parallel) before being appended
+static const std::size_t kBatchSize = 64;
+
+/************************************************************************************/
+/*!
+ *  @brief          One measurement of the manifest
+ *
+ */
+/************************************************************************************/
+struct Entry
+{
+    std::string path;
+    double position[3];             ///< azimuth, elevation (in degrees), distance (in meters)
+    std::vector< double > delays;   ///< Data.Delay of each receiver, in samples (empty for none)
+    std::size_t numFrames;
+};
+
+/************************************************************************************/
+/*!
+ *  @brief          Displays the syntax
+ *
+ */
+/************************************************************************************/
+static void DisplayHelp(std::ostream & output = std::cout)
+{
+    output << "wav2sofa packs WAV impulse responses (one file per measurement) into a SOFA file" << std::endl;
+    output << "    syntax : ./wav2sofa [manifest.csv] [output.sofa] [convention (optional) : hrir | drir] [numthreads (optional, 0 = all)]" << std::endl;
+    output << "    each line of the manifest is 'file.wav azimuth elevation distance' (comma or space separated, distance optional)" << std::endl;
+    output << "    the positions file written by sofa2wav ('measurement,file,azimuth,elevation,distance,delay_r0,...') is also accepted," << std::endl;
+    output << "    including the delays and the single file of its 'whole' mode" << std::endl;
+    output << "    the paths are relative to the manifest; lines starting with '#' are ignored" << std::endl;
+    output << "    hrir (default) : SimpleFreeFieldHRIR, stereo files; drir : SingleRoomDRIR, one channel per receiver" << std::endl;
+    output << "    N is the length of the longest file (the shorter ones are padded with zeros)" << std::endl;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads the manifest
+ *
+ *  @details        A first line starting with 'measurement' is the header of a sofa2wav
+ *                  positions file : the lines are then
+ *                  'measurement,file,azimuth,elevation,distance,delay_r0,...'
+ */
+/************************************************************************************/
+static void LoadManifest(std::vector< Entry > &entries,
+                         const std::string &path)
+{
+    std::ifstream stream( path.c_str() );
+    
+    if( stream.is_open() == false )
+    {
+        SOFA_THROW( "cannot open " + path );
+    }
+    
+    const std::size_t separator = path.find_last_of( "/\\" );
+    const std::string directory = ( separator == std::string::npos ) ? "" : path.substr( 0, separator + 1 );
+    
+    bool positionsFile = false;
+    
+    std::string line;
+    while( std::getline( stream, line ) )
+    {
+        std::replace( line.begin(), line.end(), ',', ' ' );
+        std::replace( line.begin(), line.end(), ';', ' ' );
+        
+        std::istringstream fields( line );
+        Entry entry;
+        
+        fields >> entry.path;
+        
+        if( fields.fail() == true || entry.path[0] == '#' )
+        {
+            continue;
+        }
+        
+        if( entries.empty() == true && positionsFile == false && entry.path == "measurement" )
+        {
+            positionsFile = true;
+            continue;
+        }
+        
+        if( positionsFile == true )
+        {
+            /// the first column is the index of the measurement
+            fields >> entry.path;
+        }
+        
+        fields >> entry.position[0] >> entry.position[1];
+        
+        if( fields.fail() == true )
+        {
+            SOFA_THROW( "invalid manifest line : " + line );
+        }
+        
+        fields >> entry.position[2];
+        
+        if( fields.fail() == true )
+        {
+            if( positionsFile == true )
+            {
+                SOFA_THROW( "invalid manifest line : " + line );
+            }
+            
+            entry.position[2] = 1.0;
+        }
+        
+        double delay;
+        while( positionsFile == true && ( fields >> delay ).fail() == false )
+        {
+            entry.delays.push_back( delay );
+        }
+        
+        if( entry.path[0] != '/' )
+        {
+            entry.path = directory + entry.path;
+        }
+        
+        entry.numFrames = 0;
+        
+        entries.push_back( entry );
+    }
+    
+    if( entries.empty() == true )
+    {
+        SOFA_THROW( path + " does not contain any measurement" );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Main entry point
+ *
+ */
+/************************************************************************************/
+int main(int argc, char *argv[])
+{
+    std::ostream & output = std::cout;
+    
+    //==============================================================================
+    // Parsing arguments
+    //==============================================================================
+    if( argc < 3 || argc > 5 )
+    {
+        DisplayHelp( output );
+        return 0;
+    }
+    
+    const std::string manifestPath  = argv[1];
+    const std::string outputPath    = argv[2];
+    const std::string convention    = ( argc >= 4 ) ? argv[3] : "hrir";
+    const unsigned int numThreads   = ( argc == 5 ) ? (unsigned int) std::atoi( argv[4] ) : 0;
+    
+    if( convention != "hrir" && convention != "drir" )
+    {
+        DisplayHelp( output );
+        return 1;
+    }
+    
+    try
+    {
+        std::vector< Entry > entries;
+        LoadManifest( entries, manifestPath );
+        
+        //==============================================================================
+        /// the headers give R, N and the sampling rate
+        unsigned int numChannels = 0;
+        double samplingRate = 0.0;
+        
+        {
+            const sofa::WaveReader reader( entries[0].path );
+            numChannels     = reader.GetNumChannels();
+            samplingRate    = reader.GetSamplingRate();
+        }
+        
+        std::vector< std::string > errors( entries.size() );
+        
+        sofa::Threads::ParallelFor( entries.size(),
+                                    [&]( const std::size_t i, const unsigned int )
+                                    {
+                                        try
+                                        {
+                                            const sofa::WaveReader reader( entries[i].path );
+                                            
+                                            if( reader.GetNumChannels() != numChannels || reader.GetSamplingRate() != samplingRate )
+                                            {
+                                                SOFA_THROW( "not the same number of channels or sampling rate as " + entries[0].path );
+                                            }
+                                            
+                                            entries[i].numFrames = reader.GetNumFrames();
+                                        }
+                                        catch( std::exception &e )
+                                        {
+                                            errors[i] = e.what();
+                                        }
+                                    },
+                                    numThreads );
+        
+        /// all the measurements in one file (the 'whole' mode of sofa2wav), one after the other
+        bool singleFile = ( entries.size() > 1 );
+        
+        std::size_t N = 0;
+        for( std::size_t i = 0; i < entries.size(); i++ )
+        {
+            if( errors[i].empty() == false )
+            {
+                SOFA_THROW( entries[i].path + " : " + errors[i] );
+            }
+            
+            if( entries[i].delays.empty() == false && entries[i].delays.size() != numChannels )
+            {
+                SOFA_THROW( entries[i].path + " : the number of delays does not match the number of channels" );
+            }
+            
+            N = sofa::smax( N, entries[i].numFrames );
+            
+            singleFile = ( singleFile == true && entries[i].path == entries[0].path );
+        }
+        
+        if( singleFile == true )
+        {
+            if( N % entries.size() != 0 )
+            {
+                SOFA_THROW( entries[0].path + " : the length is not a multiple of the number of measurements" );
+            }
+            
+            N /= entries.size();
+        }
+        
+        std::shared_ptr< sofa::WaveReader > singleReader;
+        if( singleFile == true )
+        {
+            singleReader = std::make_shared< sofa::WaveReader >( entries[0].path );
+        }
+        
+        const std::vector< double > zeroDelays( numChannels, 0.0 );
+        
+        //==============================================================================
+        const sofa::MeasurementWriter::Convention convention_ = ( convention == "hrir" ) ? sofa::MeasurementWriter::kSimpleFreeFieldHRIR : sofa::MeasurementWriter::kSingleRoomDRIR;
+        
+        sofa::MeasurementWriter writer( outputPath, convention_, numChannels, N, samplingRate, kBatchSize );
+        
+        /// [R N] responses of each measurement of a batch
+        const std::size_t measurementSize = numChannels * N;
+        std::vector< double > values( kBatchSize * measurementSize );
+        
+        for( std::size_t first = 0; first < entries.size(); first += kBatchSize )
+        {
+            const std::size_t count = sofa::smin( kBatchSize, entries.size() - first );
+            
+            /// the files of a batch are read in parallel (a single file sequentially),
+            /// then appended in order
+            sofa::Threads::ParallelFor( count,
+                                        [&]( const std::size_t i, const unsigned int )
+                                        {
+                                            double *measurement = &values[ i * measurementSize ];
+                                            std::fill( measurement, measurement + measurementSize, 0.0 );
+                                            
+                                            std::vector< double * > channels( numChannels );
+                                            for( unsigned int r = 0; r < numChannels; r++ )
+                                            {
+                                                channels[r] = measurement + r * N;
+                                            }
+                                            
+                                            if( singleReader != nullptr )
+                                            {
+                                                singleReader->Read( &channels[0], N );
+                                            }
+                                            else
+                                            {
+                                                sofa::WaveReader reader( entries[ first + i ].path );
+                                                reader.Read( &channels[0], entries[ first + i ].numFrames );
+                                            }
+                                        },
+                                        ( singleReader != nullptr ) ? 1 : numThreads );
+            
+            for( std::size_t i = 0; i < count; i++ )
+            {
+                const Entry &entry = entries[ first + i ];
+                
+                /// Data.Delay is written for every measurement, the files without delays having 0
+                const double *delays = ( entry.delays.empty() == true ) ? &zeroDelays[0] : &entry.delays[0];
+                
+                writer.AppendMeasurement( &values[ i * measurementSize ], delays, entry.position );
+            }
+        }
+        
+        writer.Flush();
+        
+        output << manifestPath << " -> " << outputPath << " (M = " << entries.size() << ", R = " << numChannels;
+        output << ", N = " << N << ", " << samplingRate << " Hz)" << std::endl;
+    }
+    catch( std::exception &e )
+    {
+        std::cerr << "exception occured : " << e.what() << std::endl;
+        exit(1);
+    }
+    catch( ... )
+    {
+        std::cerr << "unknown exception occured" << std::endl;
+        exit(1);
+    }
+    
+    return 0;
+}